@@ -35,6 +35,11 @@ struct RS_API CollisionMeshFile {
 	void ReadFromStream(DataStreamIn& in, bool silent = false, std::string filePath = "<NO FILE PATH>");
 	btTriangleMesh* MakeBulletMesh();
 	void UpdateHash();
+
+	// Reorders triangles along a Morton curve through their centers, and vertices by first use
+	// Triangles (and their vertices) that are close in space then end up close in memory
+	// NOTE: Does not update the hash, so that it still matches the original file data
+	void SortForLocality();
 };
 
 RS_NS_END
\ No newline at end of file
@@ -2,65 +2,87 @@
 
 #include <RocketSim/BaseInc.h>
 #include <RocketSim/DataStream/SerializeObject.h>
+#include <RocketSim/DataStream/MappedFile.h>
 
 RS_NS_START
 
 // Basic struct for reading raw data from a file
+// Data is either owned (data), or read directly from a read-only memory mapping of the file (mappedFile)
 struct RS_API DataStreamIn {
 	std::vector<byte> data;
 	size_t pos = 0;
 
+	// If set, data is read from this mapping instead of the data vector
+	// Shared so that copies of the stream don't copy or remap the file
+	std::shared_ptr<MappedFile> mappedFile = NULL;
+
 	DataStreamIn() = default;
 
-	DataStreamIn(std::filesystem::path filePath, bool versionCheck) {
-		std::ifstream fileStream = std::ifstream(filePath, std::ios::binary);
-		if (!fileStream.good())
-			RS_ERR_CLOSE("Failed to read file " << filePath << ", cannot open file.");
-		
-		fileStream >> std::noskipws;
-		data = std::vector<byte>(std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>());
+	// If memoryMap is true, the file is mapped instead of copied into memory
+	// Off by default, as a mapping keeps the file open (and locked on Windows) for as long as the stream or a copy of it exists
+	DataStreamIn(std::filesystem::path filePath, bool versionCheck, bool memoryMap = false) {
+		if (memoryMap) {
+			mappedFile = std::make_shared<MappedFile>(filePath);
+		} else {
+			std::ifstream fileStream = std::ifstream(filePath, std::ios::binary | std::ios::ate);
+			if (!fileStream.good())
+				RS_ERR_CLOSE("Failed to read file " << filePath << ", cannot open file.");
+
+			data.resize((size_t)fileStream.tellg());
+			fileStream.seekg(0);
+			fileStream.read((char*)data.data(), data.size());
+		}
 
 		if (versionCheck && !DoVersionCheck()) {
 			RS_ERR_CLOSE("Failed to read file " << filePath << ", file is invalid or from a different version of RocketSim.");
 		}
 	}
 
+	const byte* GetData() const {
+		return mappedFile ? mappedFile->GetData() : data.data();
+	}
+
+	size_t GetSize() const {
+		return mappedFile ? mappedFile->GetSize() : data.size();
+	}
+
 	bool DoVersionCheck() {
 		uint32_t versionID = Read<uint32_t>();
 		return versionID == RS_VERSION_ID;
 	}
 
 	bool IsDone() const {
-		return pos >= data.size();
+		return pos >= GetSize();
 	}
 
 	bool IsOverflown() const {
-		return pos > data.size();
+		return pos > GetSize();
 	}
 
 	size_t GetNumBytesLeft() const {
 		if (IsDone()) {
 			return 0;
 		} else {
-			return data.size() - pos;
+			return GetSize() - pos;
 		}
 	}
 
 	void ReadBytes(void* out, size_t amount) {
 		if (GetNumBytesLeft() >= amount) {
 			byte* asBytes = (byte*)out;
-			memcpy(asBytes, data.data() + pos, amount);
+			memcpy(asBytes, GetData() + pos, amount);
 
 			if (RS_IS_BIG_ENDIAN)
-				std::reverse(asBytes, asBytes + sizeof(amount));
+				std::reverse(asBytes, asBytes + amount);
 		}
 
 		pos += amount;
 	}
 
+	// Reading past the end gives zeroed bytes
 	template <typename T>
 	T Read() {
-		byte bytes[sizeof(T)];
+		byte bytes[sizeof(T)] = {};
 		ReadBytes(bytes, sizeof(T));
 		return *(T*)bytes;
 	}
@@ -79,10 +101,15 @@ struct RS_API DataStreamIn {
 			ReadBytes(obj.ptr, obj.size);
 	}
 
+	// Same as ReadMultipleFromList(), without building a list
 	template <typename... Args>
 	void ReadMultiple(Args&... args) {
-		ReadMultipleFromList({ args... });
+		uint32_t amount = Read<uint32_t>();
+		if (amount != sizeof...(args))
+			RS_ERR_CLOSE("DataStreamIn::ReadMultiple(): Prop count mismatch, expected " << sizeof...(args) << " but have " << amount << ".");
+
+		(ReadBytes(&args, sizeof(args)), ...);
 	}
 };
 
-RS_NS_END
\ No newline at end of file
+RS_NS_END
@@ -5,25 +5,128 @@
 
 RS_NS_START
 
+// Receives data flushed from a streaming DataStreamOut
+typedef std::function<void(const byte* data, size_t size)> DataStreamSinkFn;
+
 // Basic struct for writing raw data to a file
+// By default, all data is kept in memory
+// If made with a sink, data is instead buffered up to a fixed capacity and then flushed to the sink, so memory use stays flat
+// Sinks report write errors by throwing, which writes and Flush()/Close() pass on
+// NOTE: The destructor flushes too, but can't throw, so it only warns if that fails; call Close() when done to get write errors
 struct RS_API DataStreamOut {
 	std::vector<byte> data;
-	size_t pos = 0;
+	size_t pos = 0; // Total amount of bytes written, including flushed bytes
+
+	DataStreamSinkFn sink = NULL;
+	size_t bufferCapacity = 0;
+
+	constexpr static size_t DEFAULT_BUFFER_CAPACITY = 64 * 1024;
 
 	DataStreamOut() = default;
 
+	// Make a streaming DataStreamOut that flushes to a sink
+	// If writeVersionCheck is true, the version ID is written first (as in WriteToFile())
+	DataStreamOut(DataStreamSinkFn sink, bool writeVersionCheck, size_t bufferCapacity = DEFAULT_BUFFER_CAPACITY)
+		: sink(sink), bufferCapacity(RS_MAX(bufferCapacity, 1)) {
+		data.reserve(this->bufferCapacity);
+
+		if (writeVersionCheck)
+			Write<uint32_t>(RS_VERSION_ID);
+	}
+
+	// Make a streaming DataStreamOut that writes to a file
+	// Fails if the file can't be opened, its sink fails if a write to the file fails (e.g. the disk is full)
+	static DataStreamOut ToFile(std::filesystem::path filePath, bool writeVersionCheck, size_t bufferCapacity = DEFAULT_BUFFER_CAPACITY);
+
+	// Make a streaming DataStreamOut that writes to an open file descriptor (which is not closed by the stream)
+	static DataStreamOut ToFileDescriptor(int fileDescriptor, bool writeVersionCheck, size_t bufferCapacity = DEFAULT_BUFFER_CAPACITY);
+
+	// NOTE: Copies do not stream, they only get the currently buffered data
+	DataStreamOut(const DataStreamOut& other) : data(other.data), pos(other.pos) {}
+	DataStreamOut& operator =(const DataStreamOut& other) {
+		if (this != &other) {
+			Flush();
+			data = other.data;
+			pos = other.pos;
+			sink = NULL;
+			bufferCapacity = 0;
+		}
+		return *this;
+	}
+
+	DataStreamOut(DataStreamOut&& other) noexcept
+		: data(std::move(other.data)), pos(other.pos), sink(std::move(other.sink)), bufferCapacity(other.bufferCapacity) {
+		other.sink = NULL;
+	}
+	DataStreamOut& operator =(DataStreamOut&& other) noexcept {
+		if (this != &other) {
+			_FlushNoThrow();
+			data = std::move(other.data);
+			pos = other.pos;
+			sink = std::move(other.sink);
+			bufferCapacity = other.bufferCapacity;
+			other.sink = NULL;
+		}
+		return *this;
+	}
+
+	~DataStreamOut() {
+		_FlushNoThrow();
+	}
+
+	bool IsStreaming() const {
+		return sink != NULL;
+	}
+
+	// Send all buffered data to the sink (does nothing if not streaming)
+	// Fails if the sink fails, the buffered data is dropped either way so it is never sent twice
+	void Flush() {
+		if (sink && !data.empty()) {
+			try {
+				sink(data.data(), data.size());
+			} catch (...) {
+				data.clear();
+				throw;
+			}
+			data.clear();
+		}
+	}
+
+	// Flush, then release the sink (closing the file of ToFile()), so the stream keeps further data in memory
+	// Fails if the sink fails
+	void Close() {
+		Flush();
+		sink = NULL;
+		bufferCapacity = 0;
+	}
+
+	// For the destructor and move assignment, which can't throw
+	void _FlushNoThrow() noexcept {
+		size_t numBytes = data.size();
+		try {
+			Flush();
+		} catch (...) {
+			RS_WARN("DataStreamOut: Failed to flush " << numBytes << " bytes, they were lost (use Close() to handle write errors)");
+		}
+	}
+
 	void WriteBytes(const void* ptr, size_t amount) {
-		data.reserve(amount);
-		if (RS_IS_BIG_ENDIAN) {
-			byte* reversed = (byte*)malloc(amount);
-			memcpy(reversed, ptr, amount);
-			std::reverse(reversed, reversed + amount);
-			data.insert(data.end(), (byte*)reversed, (byte*)reversed + amount);
-			free(reversed);
-		} else {
-			data.insert(data.end(), (byte*)ptr, (byte*)ptr + amount);
+		if (sink && data.size() + amount > bufferCapacity) {
+			Flush();
+
+			if (amount >= bufferCapacity && !RS_IS_BIG_ENDIAN) {
+				// Too big to buffer, pass it straight through
+				sink((const byte*)ptr, amount);
+				pos += amount;
+				return;
+			}
 		}
 
+		size_t startSize = data.size();
+		data.insert(data.end(), (const byte*)ptr, (const byte*)ptr + amount);
+		if (RS_IS_BIG_ENDIAN)
+			std::reverse(data.begin() + startSize, data.end());
+
 		pos += amount;
 	}
 
@@ -38,20 +141,25 @@ struct RS_API DataStreamOut {
 			WriteBytes(obj.ptr, obj.size);
 	}
 
+	// Same output as WriteMultipleFromList(), without building a list
 	template<typename... Args>
-	void WriteMultiple(Args... args) {
-		WriteMultipleFromList({ args... });
+	void WriteMultiple(const Args&... args) {
+		Write<uint32_t>(sizeof...(args));
+		(WriteBytes(&args, sizeof(args)), ...);
 	}
 
+	// NOTE: Cannot be used when streaming
 	void WriteToFile(std::filesystem::path filePath, bool writeVersionCheck) {
+		if (sink)
+			RS_ERR_CLOSE("DataStreamOut::WriteToFile(): Cannot write a streaming DataStreamOut to a file, it is already being written to its sink.");
+
 		std::ofstream fileStream = std::ofstream(filePath, std::ios::binary);
 		if (!fileStream.good())
 			RS_ERR_CLOSE("Failed to write to file " << filePath << ", cannot open file.");
 
 		if (writeVersionCheck) {
 			uint32_t version = RS_VERSION_ID;
-			byte* versionBytes = (byte*)&version;
-			data.insert(data.begin(), versionBytes, versionBytes + sizeof(version));
+			fileStream.write((char*)&version, sizeof(version));
 		}
 
 		if (!data.empty())
@@ -69,4 +177,4 @@ inline void DataStreamOut::Write(const RotMat& val) {
 	WriteMultiple(val.forward, val.right, val.up);
 }
 
-RS_NS_END
\ No newline at end of file
+RS_NS_END
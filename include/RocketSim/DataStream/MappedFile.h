@@ -0,0 +1,42 @@
+#pragma once
+
+#include <RocketSim/Framework.h>
+
+RS_NS_START
+
+// Read-only memory mapping of an entire file
+class RS_API MappedFile {
+public:
+	MappedFile() = default;
+
+	// Fails if the file cannot be opened or mapped
+	MappedFile(std::filesystem::path filePath);
+	~MappedFile();
+
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator =(const MappedFile& other) = delete;
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator =(MappedFile&& other) noexcept;
+
+	bool IsOpen() const { return _isOpen; }
+
+	// NOTE: Data is NULL for empty files
+	const byte* GetData() const { return _data; }
+	size_t GetSize() const { return _size; }
+
+	void Close();
+
+	bool _isOpen = false;
+	const byte* _data = NULL;
+	size_t _size = 0;
+
+#ifdef _WIN32
+	void* _fileHandle = NULL;
+	void* _mappingHandle = NULL;
+#else
+	int _fileDescriptor = -1;
+#endif
+};
+
+RS_NS_END
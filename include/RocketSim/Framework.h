@@ -27,6 +27,7 @@
 #include <thread>
 #include <cstring>
 #include <array>
+#include <atomic>
 
 #define _USE_MATH_DEFINES // for M_PI and similar
 #include <cmath>
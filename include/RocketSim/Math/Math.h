@@ -2,14 +2,73 @@
 
 #include <RocketSim/BaseInc.h>
 
+#include <stdexcept>
+
 RS_NS_START
 
-struct LinearPieceCurve {
+// Piecewise-linear curve for user-defined curves, see FixedLinearPieceCurve for the built-in ones
+struct RS_API LinearPieceCurve {
 	std::map<float, float> valueMappings;
 
 	float GetOutput(float input, float defaultOutput = 1) const;
 };
 
+// Piecewise-linear curve with a fixed amount of points, used for the RLConst curves
+// Points are stored in flat arrays with the slope of each segment precomputed, so evaluating is a short branchless scan
+// Outputs are clamped to the first/last point's output outside of the curve's range, like LinearPieceCurve
+template <size_t N>
+struct FixedLinearPieceCurve {
+	static_assert(N > 0, "FixedLinearPieceCurve needs at least one point");
+
+	float inputs[N];
+	float outputs[N];
+	float slopes[N]; // Slope from point i to point i+1, 0 for the last point
+
+	// Points are {input, output}, and must be sorted by input
+	constexpr FixedLinearPieceCurve(const float (&points)[N][2]) : inputs(), outputs(), slopes() {
+		for (size_t i = 0; i < N; i++) {
+			inputs[i] = points[i][0];
+			outputs[i] = points[i][1];
+		}
+
+		for (size_t i = 0; i < N; i++) {
+			if (i + 1 < N) {
+				if (!(inputs[i + 1] > inputs[i]))
+					throw std::invalid_argument("FixedLinearPieceCurve: Points must be sorted by input, with no duplicates");
+				slopes[i] = (outputs[i + 1] - outputs[i]) / (inputs[i + 1] - inputs[i]);
+			} else {
+				slopes[i] = 0;
+			}
+		}
+	}
+
+	constexpr float GetOutput(float input) const {
+		input = RS_MAX(input, inputs[0]);
+
+		// Index of the last point at or before the input
+		size_t index = 0;
+		for (size_t i = 1; i < N; i++)
+			index += (input >= inputs[i]);
+
+		return outputs[index] + slopes[index] * (input - inputs[index]);
+	}
+
+	// Evaluates 4 inputs at once (e.g. one per wheel)
+	constexpr void GetOutput4(const float input[4], float outputOut[4]) const {
+		float clampedInputs[4];
+		size_t indices[4] = {};
+		for (int j = 0; j < 4; j++)
+			clampedInputs[j] = RS_MAX(input[j], inputs[0]);
+
+		for (size_t i = 1; i < N; i++)
+			for (int j = 0; j < 4; j++)
+				indices[j] += (clampedInputs[j] >= inputs[i]);
+
+		for (int j = 0; j < 4; j++)
+			outputOut[j] = outputs[indices[j]] + slopes[indices[j]] * (clampedInputs[j] - inputs[indices[j]]);
+	}
+};
+
 namespace Math {
 	btVector3 RoundVec(btVector3 vec, float precision);
 
@@ -416,7 +416,7 @@ namespace RLConst {
 
 	// Input: Forward car speed
 	// Output: Max steering angle (radians)
-	const static LinearPieceCurve STEER_ANGLE_FROM_SPEED_CURVE = {
+	constexpr static FixedLinearPieceCurve<6> STEER_ANGLE_FROM_SPEED_CURVE = {
 		{
 			{0,		0.53356f},
 			{500,	0.31930f},
@@ -427,7 +427,7 @@ namespace RLConst {
 		}
 	};
 
-	const static LinearPieceCurve STEER_ANGLE_FROM_SPEED_CURVE_THREEWHEEL = {
+	constexpr static FixedLinearPieceCurve<2> STEER_ANGLE_FROM_SPEED_CURVE_THREEWHEEL = {
 		{
 			{0,		0.342473f},
 			{2300,	0.034837f}
@@ -436,7 +436,7 @@ namespace RLConst {
 
 	// Input: Forward car speed 
 	// Output: Extended steering angle (radians)
-	const static LinearPieceCurve POWERSLIDE_STEER_ANGLE_FROM_SPEED_CURVE = {
+	constexpr static FixedLinearPieceCurve<2> POWERSLIDE_STEER_ANGLE_FROM_SPEED_CURVE = {
 		{
 			{0,		0.39235f},
 			{2500,	0.12610f},
@@ -445,7 +445,7 @@ namespace RLConst {
 
 	// Input: Forward car speed 
 	// Output: Torque factor
-	const static LinearPieceCurve DRIVE_SPEED_TORQUE_FACTOR_CURVE = {
+	constexpr static FixedLinearPieceCurve<3> DRIVE_SPEED_TORQUE_FACTOR_CURVE = {
 		{
 			{0,		1.0f},
 			{1400,	0.1f},
@@ -453,7 +453,7 @@ namespace RLConst {
 		}
 	};
 
-	const static LinearPieceCurve NON_STICKY_FRICTION_FACTOR_CURVE = {
+	constexpr static FixedLinearPieceCurve<3> NON_STICKY_FRICTION_FACTOR_CURVE = {
 		{
 			{0,			0.1f},
 			{0.7075f,	0.5f},
@@ -461,40 +461,41 @@ namespace RLConst {
 		}
 	};
 
-	const static LinearPieceCurve LAT_FRICTION_CURVE = {
+	constexpr static FixedLinearPieceCurve<2> LAT_FRICTION_CURVE = {
 		{
 			{0,	1.0f},
 			{1,	0.2f},
 		}
 	};
 
-	const static LinearPieceCurve LAT_FRICTION_CURVE_THREEWHEEL = {
+	constexpr static FixedLinearPieceCurve<2> LAT_FRICTION_CURVE_THREEWHEEL = {
 		{
 			{0,	0.30f},
 			{1,	0.25f},
 		}
 	};
 
-	const static LinearPieceCurve LONG_FRICTION_CURVE = {
+	// Empty in the game, so always 1
+	constexpr static FixedLinearPieceCurve<1> LONG_FRICTION_CURVE = {
 		{
-			// Empty curve
+			{0,	1.0f},
 		}
 	};
 
-	const static LinearPieceCurve HANDBRAKE_LAT_FRICTION_FACTOR_CURVE = {
+	constexpr static FixedLinearPieceCurve<1> HANDBRAKE_LAT_FRICTION_FACTOR_CURVE = {
 		{
 			{0,	0.1f},
 		}
 	};
 
-	const static LinearPieceCurve HANDBRAKE_LONG_FRICTION_FACTOR_CURVE = {
+	constexpr static FixedLinearPieceCurve<2> HANDBRAKE_LONG_FRICTION_FACTOR_CURVE = {
 		{
 			{0,	0.5f},
 			{1,	0.9f}
 		}
 	};
 
-	const static LinearPieceCurve BALL_CAR_EXTRA_IMPULSE_FACTOR_CURVE = {
+	constexpr static FixedLinearPieceCurve<4> BALL_CAR_EXTRA_IMPULSE_FACTOR_CURVE = {
 		{
 			{     0, 0.65f},
 			{ 500.f, 0.65f},
@@ -503,7 +504,7 @@ namespace RLConst {
 		}
 	};
 
-	const static LinearPieceCurve BUMP_VEL_AMOUNT_GROUND_CURVE = {
+	constexpr static FixedLinearPieceCurve<3> BUMP_VEL_AMOUNT_GROUND_CURVE = {
 		{
 			{0.f, (5.f / 6.f)},
 			{1400.f, 1100.f},
@@ -511,7 +512,7 @@ namespace RLConst {
 		}
 	};
 
-	const static LinearPieceCurve BUMP_VEL_AMOUNT_AIR_CURVE = {
+	constexpr static FixedLinearPieceCurve<3> BUMP_VEL_AMOUNT_AIR_CURVE = {
 		{
 			{0.f, (5.f / 6.f)},
 			{1400.f, 1390.f},
@@ -519,7 +520,7 @@ namespace RLConst {
 		}
 	};
 
-	const static LinearPieceCurve BUMP_UPWARD_VEL_AMOUNT_CURVE = {
+	constexpr static FixedLinearPieceCurve<3> BUMP_UPWARD_VEL_AMOUNT_CURVE = {
 		{
 			{0.f, (2.f / 6.f)},
 			{1400.f, 278.f},
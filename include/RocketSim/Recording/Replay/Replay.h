@@ -0,0 +1,170 @@
+#pragma once
+
+#include <RocketSim/Sim/Arena/Arena.h>
+#include <RocketSim/DataStream/MappedFile.h>
+
+RS_NS_START
+
+// Seekable replay of an arena, made of the car controls of every tick and periodic arena snapshots (keyframes)
+// A table with the position of each keyframe is written at the end of the file, so any tick can be reached by
+//	restoring the nearest keyframe and re-simulating at most one keyframe interval worth of ticks
+// File layout: [FileHeader] [chunks...] [index: KeyframeIndexEntry...] [Footer]
+// NOTE: Like snapshots, replays should only be read by the same build of RocketSim
+// NOTE: Applying a snapshot clears Bullet's contact caches, so the writer applies each keyframe to the recorded arena and the player
+//	applies each keyframe it reaches, which makes re-simulated ticks match the recording exactly
+//	Each tick stores a hash of its recorded state, which the player checks every tick it reaches against (see ReplayPlayer::verifyStates)
+namespace Replay {
+	constexpr uint32_t MAGIC = 0x594C5052; // "RPLY"
+	constexpr uint32_t FORMAT_VERSION = 3;
+
+	constexpr uint64_t NO_TICK = UINT64_MAX;
+
+	// Chunks start at a multiple of this, so keyframes can be viewed in place
+	constexpr size_t CHUNK_ALIGNMENT = ArenaSnapshotHeader::SECTION_ALIGNMENT;
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t formatVersion;
+		uint32_t rocketSimVersion;
+		uint32_t keyframeInterval;
+	};
+
+	enum class ChunkType : uint32_t {
+		CONTROLS, // Payload: ControlsHeader, CarControlsEntry[numCars]
+		KEYFRAME  // Payload: arena snapshot
+	};
+
+	struct ChunkHeader {
+		ChunkType type;
+		uint32_t payloadSize;
+		uint64_t tickCount;
+	};
+	static_assert(sizeof(ChunkHeader) % CHUNK_ALIGNMENT == 0);
+
+	struct ControlsHeader {
+		uint64_t stateHash; // Hash of the arena state at the start of the tick, from HashArenaState()
+	};
+
+	struct CarControlsEntry {
+		uint32_t carID;
+		CarControls controls;
+	};
+
+	struct KeyframeIndexEntry {
+		uint64_t tickCount;
+		uint64_t chunkOffset;
+	};
+
+	struct Footer {
+		uint64_t indexOffset;
+		uint64_t numKeyframes;
+		uint64_t firstTick, endTick; // Ticks [firstTick, endTick) have recorded controls
+		uint32_t magic;
+		uint32_t _padding;
+	};
+
+	// Hashes the car states, ball state and boost pad states of the arena
+	// Only depends on the values of the states, not on their padding bytes
+	RS_API uint64_t HashArenaState(const Arena* arena);
+}
+
+// Writes a replay file while a match is being simulated
+class RS_API ReplayWriter {
+public:
+	ReplayWriter(std::filesystem::path filePath, int keyframeInterval = 120);
+
+	// Calls Finish() if not already finished
+	~ReplayWriter();
+
+	ReplayWriter(const ReplayWriter& other) = delete;
+	ReplayWriter& operator =(const ReplayWriter& other) = delete;
+
+	// Record the current tick, call this right before Arena::Step(1), after the controls of all cars are set
+	// Writes a keyframe every keyframeInterval ticks, and applies it to the arena (see Arena::ApplySnapshot())
+	// Fails if the file can't be written to (e.g. the disk is full), as data is buffered this can happen a while after the failed write
+	// Fails if the cars in the arena changed since the first recorded tick, as keyframes can't add or remove cars
+	// NOTE: Ticks must be recorded consecutively
+	void RecordTick(Arena* arena);
+
+	// Writes the keyframe index and closes the file
+	// Fails if the file can't be written to
+	void Finish();
+
+	std::filesystem::path _filePath;
+	std::ofstream _fileStream;
+	std::vector<char> _fileStreamBuffer;
+	uint64_t _filePos = 0;
+	bool _finished = false;
+
+	int _keyframeInterval;
+	std::vector<Replay::KeyframeIndexEntry> _keyframes;
+	uint64_t _firstTick = 0, _endTick = 0;
+
+	std::vector<byte> _snapshotBuffer;
+	std::vector<Replay::CarControlsEntry> _controlsBuffer;
+	std::vector<uint32_t> _carIDs;
+
+	// Fails if a write to the file failed
+	void _CheckStream();
+
+	// The chunk's payload is payloadHeader followed by payload
+	void _WriteChunk(Replay::ChunkType type, uint64_t tickCount, const void* payloadHeader, size_t payloadHeaderSize, const void* payload, size_t payloadSize);
+};
+
+// Plays back a replay file by memory-mapping it
+class RS_API ReplayPlayer {
+public:
+	ReplayPlayer(std::filesystem::path filePath);
+
+	// Ticks [GetFirstTick(), GetEndTick()] can be seeked to
+	uint64_t GetFirstTick() const { return _footer.firstTick; }
+	uint64_t GetEndTick() const { return _footer.endTick; }
+
+	// Put the arena at the given tick by restoring the nearest keyframe at or before it, and simulating forward with the recorded controls
+	// The arena must have the same game mode, boost pads and car IDs as the recorded arena
+	void Seek(Arena* arena, uint64_t tickCount);
+
+	// Simulate one tick forward with the recorded controls, then apply the keyframe of the new tick if it has one
+	// Returns false if the end of the replay was reached
+	bool StepForward(Arena* arena);
+
+	// If true, every tick reached by Seek() and StepForward() is compared against the recorded state hash
+	// The first mismatch is reported with a warning
+	bool verifyStates = true;
+
+	// Amount of verified ticks whose state did not match the recording
+	uint64_t GetNumMismatchedTicks() const { return _numMismatchedTicks; }
+
+	// Tick of the first mismatch that was found, or Replay::NO_TICK if there were none
+	uint64_t GetFirstMismatchedTick() const { return _firstMismatchedTick; }
+
+	MappedFile _file;
+	Replay::Footer _footer;
+	const Replay::KeyframeIndexEntry* _keyframes = NULL;
+
+	// Finds the keyframe index of the last keyframe at or before the tick
+	size_t _FindKeyframe(uint64_t tickCount) const;
+
+	// Finds the chunk with the controls of a tick, by walking forward from the last found chunk or the nearest keyframe
+	const Replay::ChunkHeader* _FindControlsChunk(uint64_t tickCount);
+	const Replay::ChunkHeader* _lastControlsChunk = NULL;
+
+	// Returns the chunk after the given chunk, or NULL if at the index
+	// Fails if the chunk doesn't fit before the index
+	const Replay::ChunkHeader* _GetNextChunk(const Replay::ChunkHeader* chunk) const;
+
+	// Fails if the chunk's payload doesn't fit before the index, or is too small for its type
+	void _CheckChunk(const Replay::ChunkHeader* chunk) const;
+
+	const Replay::ChunkHeader* _GetKeyframeChunk(size_t keyframeIndex) const;
+
+	void _ApplyControls(Arena* arena, const Replay::ChunkHeader* controlsChunk);
+	void _ApplyKeyframe(Arena* arena, const Replay::ChunkHeader* keyframeChunk);
+
+	// Compares the arena against the recorded state hash of its current tick, if the tick has one
+	void _VerifyState(const Arena* arena);
+	uint64_t _numMismatchedTicks = 0;
+	uint64_t _firstMismatchedTick = Replay::NO_TICK;
+};
+
+RS_NS_END
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <RocketSim/Sim/Arena/Arena.h>
+
+RS_NS_START
+
+// Compact per-tick state log of an arena
+// Every tick is stored as an arena snapshot (see ArenaSnapshot.h), either in full (keyframes), or as the XOR against the previous tick's snapshot
+// XOR deltas are stored as runs of unchanged/changed 4-byte words, so unchanged fields cost (almost) nothing
+// NOTE: Like snapshots, recordings should only be read by the same build of RocketSim
+namespace StateRecording {
+	constexpr uint32_t MAGIC = 0x43455253; // "SREC"
+	constexpr uint32_t FORMAT_VERSION = 2;
+
+	enum class RecordType : uint8_t {
+		KEYFRAME,
+		DELTA
+	};
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t formatVersion;
+		uint32_t rocketSimVersion;
+		uint32_t keyframeInterval;
+	};
+
+	// Precedes the payload of each record, written as-is
+	struct RecordHeader {
+		RecordType type;
+		uint8_t _pad[3]; // Explicit, so that the file has no uninitialized bytes
+		uint32_t payloadSize;
+		uint64_t tickCount;
+	};
+	static_assert(sizeof(RecordHeader) == 16);
+
+	// Appends the XOR delta between two snapshots of equal size to out
+	RS_API void EncodeDelta(const byte* prevSnapshot, const byte* curSnapshot, size_t snapshotSize, std::vector<byte>& out);
+
+	// Applies a delta from EncodeDelta() to a snapshot, turning the previous snapshot into the current one
+	// Returns false if the delta is malformed
+	RS_API bool ApplyDelta(byte* snapshot, size_t snapshotSize, const byte* delta, size_t deltaSize);
+}
+
+// Writes the state of an arena every tick to a file
+class RS_API StateRecorder {
+public:
+	// A full snapshot is written every keyframeInterval ticks, or when the cars in the arena change
+	StateRecorder(std::filesystem::path filePath, int keyframeInterval = 120);
+	~StateRecorder();
+
+	StateRecorder(const StateRecorder& other) = delete;
+	StateRecorder& operator =(const StateRecorder& other) = delete;
+
+	// Record the current state of the arena, call this after every Arena::Step()
+	// Fails if the file can't be written to (e.g. the disk is full), as data is buffered this can happen a while after the failed write
+	void Record(const Arena* arena);
+
+	// Fails if the file can't be written to
+	void Flush();
+
+	uint64_t GetNumRecords() const { return _numRecords; }
+	uint64_t GetNumBytesWritten() const { return _numBytesWritten; }
+
+	std::filesystem::path _filePath;
+	std::ofstream _fileStream;
+	std::vector<char> _fileStreamBuffer;
+
+	int _keyframeInterval;
+	uint64_t _numRecords = 0;
+	uint64_t _numBytesWritten = 0;
+	int _ticksSinceKeyframe = 0;
+
+	std::vector<byte> _prevSnapshot, _curSnapshot;
+	std::vector<byte> _deltaBuffer;
+
+	void _WriteRecord(StateRecording::RecordType type, uint64_t tickCount, const byte* payload, size_t payloadSize);
+
+	// Fails if a write to the file failed
+	void _CheckStream();
+};
+
+// Reads a file written by StateRecorder, and reconstructs the arena snapshot of any recorded tick
+class RS_API StateRecordingReader {
+public:
+	StateRecordingReader(std::filesystem::path filePath);
+
+	size_t GetNumRecords() const { return _records.size(); }
+
+	// Arena tick count when a record was written
+	uint64_t GetTickCount(size_t recordIndex) const { return _records[recordIndex].tickCount; }
+
+	// Returns the index of the last record with a tick count <= tickCount, or -1 if there is none
+	int64_t FindRecord(uint64_t tickCount) const;
+
+	// Reconstructs the snapshot of a record, starting from the nearest keyframe (or the last read record, if that is closer)
+	// NOTE: The returned view is only valid until the next call
+	ArenaSnapshotView Read(size_t recordIndex);
+
+	struct RecordInfo {
+		StateRecording::RecordType type;
+		uint64_t tickCount;
+		size_t payloadPos;
+		uint32_t payloadSize;
+		size_t keyframeIndex; // Index of the keyframe this record is based on
+	};
+
+	DataStreamIn _dataStream;
+	std::vector<RecordInfo> _records;
+
+	std::vector<byte> _snapshot;
+	int64_t _snapshotRecordIndex = -1; // Which record _snapshot currently holds
+};
+
+RS_NS_END
@@ -25,16 +25,24 @@ namespace RocketSim {
 	extern std::filesystem::path _collisionMeshesFolder;
 	extern std::mutex _beginInitMutex;
 
-	RS_API void Init(std::filesystem::path collisionMeshesFolder, bool silent = false);
+	// If lazy is true, the mesh sources are only registered,
+	//	and each game mode's collision meshes are built on the first Arena::Create() for that game mode
+	// If sortMeshesForLocality is true, each mesh's triangles are reordered with CollisionMeshFile::SortForLocality() before it is built
+	//	NOTE: Faster mesh queries, but contacts and ray hits that tie between triangles can resolve differently, so results differ from unsorted meshes
+	RS_API void Init(std::filesystem::path collisionMeshesFolder, bool silent = false, bool lazy = false, bool sortMeshesForLocality = false);
 
 	// Instead of loading a collision meshes folder, you can pass in the meshes in this memory-only format
 	// The map sorts mesh files to their respective game modes, where each game mode has a list of mesh files
 	// The mesh files themselves are just byte arrays
-	RS_API void InitFromMem(const std::map<GameMode, std::vector<FileData>>& meshFilesMap, bool silent = false);
+	RS_API void InitFromMem(const std::map<GameMode, std::vector<FileData>>& meshFilesMap, bool silent = false, bool lazy = false, bool sortMeshesForLocality = false);
 
 	void AssertInitialized(const char* errorMsgPrefix);
 
 	RS_API RocketSimStage GetStage();
 
+	// Returns the game mode whose collision meshes are used by the given game mode (e.g. HEATSEEKER -> SOCCAR)
+	RS_API GameMode GetMeshGameMode(GameMode gameMode);
+
+	// NOTE: If RocketSim was initialized lazily, this builds the game mode's meshes on first call
 	RS_API std::vector<btBvhTriangleMeshShape*>& GetArenaCollisionShapes(GameMode gameMode);
 }
\ No newline at end of file
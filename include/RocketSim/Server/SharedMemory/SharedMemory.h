@@ -0,0 +1,52 @@
+#pragma once
+
+#include <RocketSim/Framework.h>
+
+RS_NS_START
+
+// Named, read-write shared memory region that other processes can map by name
+// NOTE: Only supported on POSIX systems (shm_open), fails on Windows
+class RS_API SharedMemory {
+public:
+	SharedMemory() = default;
+
+	// Creates a new zeroed region, fails if a region with this name already exists
+	// The name is unlinked again once the creating object is closed, processes that already mapped it keep their mapping
+	static SharedMemory Create(std::string name, size_t size);
+
+	// Maps an existing region, fails if there is none with this name
+	static SharedMemory Open(std::string name);
+
+	// Returns true if a region with this name exists
+	static bool Exists(std::string name);
+
+	// Unlinks the name of a region (e.g. left over from a crashed process), so that it can be created again
+	// Processes that mapped the region keep their mapping
+	// Returns false if there was no region with this name
+	static bool Remove(std::string name);
+
+	~SharedMemory();
+
+	SharedMemory(const SharedMemory& other) = delete;
+	SharedMemory& operator =(const SharedMemory& other) = delete;
+
+	SharedMemory(SharedMemory&& other) noexcept;
+	SharedMemory& operator =(SharedMemory&& other) noexcept;
+
+	bool IsOpen() const { return _data != NULL; }
+
+	// Page-aligned
+	byte* GetData() const { return _data; }
+	size_t GetSize() const { return _size; }
+
+	const std::string& GetName() const { return _name; }
+
+	void Close();
+
+	std::string _name; // Always starts with '/'
+	byte* _data = NULL;
+	size_t _size = 0;
+	bool _isOwner = false; // If true, unlinks the name on close
+};
+
+RS_NS_END
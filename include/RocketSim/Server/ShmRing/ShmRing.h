@@ -0,0 +1,94 @@
+#pragma once
+
+#include <RocketSim/Framework.h>
+
+RS_NS_START
+
+// Header of a ring, placed at the start of the ring's memory
+// The indices only ever grow, each on its own cache line so the producer and consumer don't invalidate each other's line
+struct ShmRingHeader {
+	constexpr static size_t CACHE_LINE_SIZE = 64;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> writeIndex; // Only written by the producer
+	alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> readIndex; // Only written by the consumer
+	alignas(CACHE_LINE_SIZE) uint32_t numSlots; // Power of two
+	uint32_t slotStride; // Slot size rounded up to the cache line size
+};
+
+// Rings are shared between processes, so their atomics must not rely on a process-local lock
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+// Lock-free single-producer, single-consumer ring of fixed-size slots, in memory that can be shared between processes
+// Slots are written and read in place (BeginWrite()/EndWrite(), BeginRead()/EndRead()), so messages are never copied through the ring
+// Each side keeps a local copy of the other side's index, and only reloads it when the ring looks full/empty
+// NOTE: ShmRing objects are process-local handles, each process attaches its own handle to the shared memory
+class RS_API ShmRing {
+public:
+	ShmRing() = default;
+
+	// Amount of memory needed for a ring (must be aligned to ShmRingHeader::CACHE_LINE_SIZE)
+	static size_t GetRequiredSize(uint32_t numSlots, uint32_t slotSize);
+
+	// Initializes a new, empty ring in memory
+	// numSlots must be a power of two
+	static ShmRing Init(void* memory, uint32_t numSlots, uint32_t slotSize);
+
+	// Attaches to a ring that was initialized by Init() (possibly by another process)
+	static ShmRing Attach(void* memory);
+
+	bool IsValid() const { return _header != NULL; }
+	uint32_t GetNumSlots() const { return _header->numSlots; }
+	uint32_t GetSlotStride() const { return _header->slotStride; }
+
+	// Producer side:
+	// Returns the next free slot to write into, or NULL if the ring is full
+	void* BeginWrite() {
+		if (_writeIndex - _cachedReadIndex >= _header->numSlots) {
+			_cachedReadIndex = _header->readIndex.load(std::memory_order_acquire);
+			if (_writeIndex - _cachedReadIndex >= _header->numSlots)
+				return NULL;
+		}
+		return _GetSlot(_writeIndex);
+	}
+
+	// Publishes the slot from BeginWrite() to the consumer
+	void EndWrite() {
+		_writeIndex++;
+		_header->writeIndex.store(_writeIndex, std::memory_order_release);
+	}
+
+	// Consumer side:
+	// Returns the oldest published slot, or NULL if the ring is empty
+	const void* BeginRead() {
+		if (_readIndex == _cachedWriteIndex) {
+			_cachedWriteIndex = _header->writeIndex.load(std::memory_order_acquire);
+			if (_readIndex == _cachedWriteIndex)
+				return NULL;
+		}
+		return _GetSlot(_readIndex);
+	}
+
+	// Releases the slot from BeginRead() back to the producer
+	void EndRead() {
+		_readIndex++;
+		_header->readIndex.store(_readIndex, std::memory_order_release);
+	}
+
+	// Amount of published slots that have not been read yet (only exact when called by the consumer)
+	uint32_t GetNumPending() const {
+		return (uint32_t)(_header->writeIndex.load(std::memory_order_acquire) - _header->readIndex.load(std::memory_order_acquire));
+	}
+
+	ShmRingHeader* _header = NULL;
+	byte* _slots = NULL;
+
+	// Local copies, so each side only touches the other side's cache line when it has to
+	uint64_t _writeIndex = 0, _cachedReadIndex = 0;
+	uint64_t _readIndex = 0, _cachedWriteIndex = 0;
+
+	byte* _GetSlot(uint64_t index) const {
+		return _slots + (index & (_header->numSlots - 1)) * _header->slotStride;
+	}
+};
+
+RS_NS_END
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <RocketSim/Server/SimServer/SimServer.h>
+
+RS_NS_START
+
+// Client side of a SimServer, drives some or all of its arenas from another process
+// Each arena can only be used by one client at a time, as its rings have a single producer and consumer
+// Per step of an arena:
+//	SimStatesView states = client.WaitStates(i);
+//	CarControls* controls = client.BeginControls(i); // One per car, in the order of states.carIDs
+//	(fill controls from the states)
+//	client.PopStates(i); // The view is invalid after this
+//	client.SendControls(i, states.header->numCars, ticks);
+// Multiple controls messages can be sent before waiting for their states, up to the server's ring slot count
+// A claimed arena is only ready once the server has reset its rings for this client, until then BeginControls() returns NULL and there are no states or events
+// Every call on an arena also sends a heartbeat, if the server revokes the arena for lack of them (see SimServerConfig::clientTimeout), the next call releases it and fails
+class RS_API SimClient {
+public:
+	// Attaches to a running server and claims the given arenas (all of them if empty)
+	// Fails if there is no such server, it was built with a different version of RocketSim, or an arena is claimed by another client
+	SimClient(std::string serverName, const std::vector<uint32_t>& arenaIndices = {});
+	~SimClient(); // Releases the claimed arenas
+
+	SimClient(const SimClient& other) = delete;
+	SimClient& operator=(const SimClient& other) = delete;
+
+	uint32_t GetNumArenas() const { return _header->numArenas; }
+	uint32_t GetMaxCars() const { return _header->maxCars; }
+
+	bool IsServerRunning() const {
+		return _header->isRunning.load(std::memory_order_acquire);
+	}
+
+	uint64_t GetNumDroppedEvents() const {
+		return _header->numDroppedEvents.load(std::memory_order_relaxed);
+	}
+
+	// Returns the controls to fill for the next controls message of an arena, or NULL if its controls ring is full or it isn't ready yet
+	CarControls* BeginControls(uint32_t arenaIndex);
+
+	// Sends the controls from BeginControls(), the server applies them to the first numCars cars and steps ticks ticks
+	// Returns the message's sequence number, which is returned in the states that answer it
+	uint64_t SendControls(uint32_t arenaIndex, uint32_t numCars, uint32_t ticks);
+
+	// Returns the oldest unread states of an arena, or an invalid view if there are none
+	SimStatesView PeekStates(uint32_t arenaIndex);
+
+	// Spins until states arrive (including while the arena isn't ready yet), fails if the server stops
+	SimStatesView WaitStates(uint32_t arenaIndex);
+
+	// Releases the states returned by PeekStates()/WaitStates() to the server
+	void PopStates(uint32_t arenaIndex);
+
+	// Returns the oldest unread event of an arena, or NULL if there are none
+	// Call PopEvent() once done with it
+	const SimEvent* PeekEvent(uint32_t arenaIndex);
+	void PopEvent(uint32_t arenaIndex);
+
+private:
+	struct ArenaChannel {
+		SimArenaBlockHeader* blockHeader = NULL;
+		ShmRing controlsRing, statesRing, eventsRing; // Only attached once ready
+		bool isReady = false;
+		uint64_t nextSeq = 1;
+		uint32_t generation = 0; // Of our claim
+	};
+
+	void _ReleaseClaim(ArenaChannel& channel);
+	void _ReleaseClaims();
+
+	// Fails if the arena isn't claimed by this client, or the server revoked the claim (which is then released)
+	// Sends a heartbeat, and attaches the rings once the server has reset them
+	ArenaChannel& _GetClaimedChannel(uint32_t arenaIndex);
+
+	SharedMemory _memory;
+	uint32_t _processID = 0;
+	const SimServerHeader* _header = NULL;
+	std::vector<ArenaChannel> _channels; // Indexed by arena, unclaimed arenas have no block header
+};
+
+RS_NS_END
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <RocketSim/Sim/Arena/Arena.h>
+#include <RocketSim/Server/SharedMemory/SharedMemory.h>
+#include <RocketSim/Server/ShmRing/ShmRing.h>
+
+RS_NS_START
+
+// Local simulation server: hosts arenas in one process and exposes them to client processes (see SimClient) through shared memory
+// Each arena has three lock-free SPSC rings:
+//	- Controls (client -> server): the controls of every car, and how many ticks to step after applying them
+//	- States (server -> client): the arena's state after each step, in SoA layout, read by the client in place
+//	- Events (server -> client): goals, bumps, demos, and ball touches that happened during the steps
+// Messages are plain structs written straight into the rings, so nothing is serialized
+// The server answers every controls message with exactly one states message
+// Whenever a client claims an arena, the server resets its rings and sends one initial states message, so clients never see the messages of a previous client
+// NOTE: Requires POSIX shared memory, so this is not supported on Windows
+
+enum class SimEventType : uint8_t {
+	GOAL,		// team is the scoring team
+	BUMP,		// carID bumped otherCarID
+	DEMO,		// carID demoed otherCarID
+	BALL_TOUCH	// carID touched the ball (at most one per car per step)
+};
+
+struct SimEvent {
+	uint64_t tickCount; // Arena tick count when the event was recorded
+	uint32_t carID, otherCarID; // 0 if not used by the event type
+	SimEventType type;
+	Team team;
+};
+
+struct SimControlsMsgHeader {
+	uint64_t seq; // Set by the client, returned in the states that answer this message
+	uint32_t ticks; // Amount of ticks to step after applying the controls
+	uint32_t numCars;
+	// Followed by numCars CarControls, in the car order of the states
+
+	CarControls* GetControls() { return (CarControls*)(this + 1); }
+	const CarControls* GetControls() const { return (const CarControls*)(this + 1); }
+};
+
+struct SimStatesMsgHeader {
+	uint64_t seq; // Of the controls message these states answer, 0 for the initial states
+	uint64_t tickCount;
+	uint32_t numCars, numBoostPads;
+	PhysState ball;
+	// Followed by the sections in SimServerHeader::statesOffsets
+};
+
+// Header at the start of a server's shared memory
+// NOTE: Like arena snapshots, the layout depends on the platform's struct layout, so clients must use the same build of RocketSim
+struct RS_API SimServerHeader {
+	constexpr static uint32_t MAGIC = 0x534D4953; // "SIMS"
+	constexpr static uint32_t FORMAT_VERSION = 3;
+
+	constexpr static size_t SECTION_ALIGNMENT = 16;
+	constexpr static size_t BLOCK_ALIGNMENT = ShmRingHeader::CACHE_LINE_SIZE;
+
+	std::atomic<uint32_t> magic; // Set last by the server, once everything else is initialized
+	uint32_t formatVersion;
+	uint32_t rocketSimVersion;
+
+	// Process ID of the server, so that a region left over from a crashed server can be told apart from a running server
+	uint32_t serverPID;
+
+	// Sizes of the message structs when written, must match the client's
+	uint32_t carControlsSize, vecSize, rotMatSize, physStateSize, eventSize;
+
+	uint32_t numArenas, maxCars, maxBoostPads;
+	uint32_t numRingSlots, numEventSlots;
+
+	std::atomic<uint32_t> isRunning; // Cleared when the server shuts down
+	std::atomic<uint64_t> numDroppedEvents; // Events that didn't fit in a full events ring
+
+	// Byte offsets of the SoA sections of a states message, each array has maxCars (or maxBoostPads) entries
+	struct {
+		uint32_t
+			carIDs, carTeams, carPos, carRotMat, carVel, carAngVel, carBoost, carFlags, boostPadIsActive;
+	} statesOffsets;
+
+	uint32_t controlsMsgSize, statesMsgSize;
+
+	// Each arena has a block of arenaBlockSize bytes, starting at arenasOffset
+	// A block is a SimArenaBlockHeader, followed by the controls, states, and events rings at the given offsets
+	uint64_t arenasOffset, arenaBlockSize;
+	uint64_t controlsRingOffset, statesRingOffset, eventsRingOffset;
+	uint64_t totalSize;
+
+	// Makes a header with all sizes and offsets set (magic is left at 0)
+	static void MakeLayout(SimServerHeader& header, uint32_t numArenas, uint32_t maxCars, uint32_t maxBoostPads, uint32_t numRingSlots, uint32_t numEventSlots);
+};
+
+struct SimArenaBlockHeader {
+	// Process ID of the client using this arena (0 if unclaimed) in the low 32 bits, and the claim's generation in the high 32 bits
+	// Every claim increments the generation, and keeps it when released
+	// The server releases the arena if the client's process is gone
+	alignas(SimServerHeader::BLOCK_ALIGNMENT) std::atomic<uint64_t> claim;
+
+	// Generation of the last claim the server reset the rings for, clients only use the rings once this matches their claim
+	std::atomic<uint32_t> readyGeneration;
+
+	// Generation of a claim whose heartbeat stopped for longer than SimServerConfig::clientTimeout
+	// The server stops handling its messages, but the arena stays claimed until the client notices (and releases it) or its process is gone,
+	//	so that a stalled client can never write into the rings of the next client
+	std::atomic<uint32_t> revokedGeneration;
+
+	// Set by the client whenever it uses the arena, from GetHeartbeatTime()
+	std::atomic<uint64_t> heartbeatTime;
+
+	static uint64_t MakeClaim(uint32_t generation, uint32_t clientPID) {
+		return ((uint64_t)generation << 32) | clientPID;
+	}
+	static uint32_t GetClaimGeneration(uint64_t claim) { return (uint32_t)(claim >> 32); }
+	static uint32_t GetClaimPID(uint64_t claim) { return (uint32_t)claim; }
+
+	// Monotonic time in nanoseconds, comparable between processes on the same machine
+	static uint64_t GetHeartbeatTime() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+};
+
+// Read-only view of a states message, pointing directly into the states ring
+struct RS_API SimStatesView {
+	const SimStatesMsgHeader* header = NULL;
+
+	// All of length header->numCars
+	const uint32_t* carIDs = NULL;
+	const Team* carTeams = NULL;
+	const Vec* carPos = NULL;
+	const RotMat* carRotMat = NULL;
+	const Vec* carVel = NULL;
+	const Vec* carAngVel = NULL;
+	const float* carBoost = NULL;
+	const uint16_t* carFlags = NULL; // See CompactState::CarFlags
+
+	// Of length header->numBoostPads
+	const uint8_t* boostPadIsActive = NULL;
+
+	bool IsValid() const { return header != NULL; }
+
+	static SimStatesView FromMessage(const void* message, const SimServerHeader& serverHeader);
+};
+
+struct RS_API SimServerConfig {
+	// Most cars an arena can have, 0 to use the most cars any arena has when the server is created
+	uint32_t maxCars = 0;
+
+	// Controls/states messages that can be queued per arena, must be a power of two
+	uint32_t numRingSlots = 4;
+
+	// Events that can be queued per arena before new ones are dropped, must be a power of two
+	uint32_t numEventSlots = 256;
+
+	// Seconds without a heartbeat after which a client's arenas are revoked (see SimArenaBlockHeader::revokedGeneration)
+	// 0 to only release the arenas of clients whose process is gone
+	// Clients send heartbeats whenever they use an arena, including while waiting for states
+	float clientTimeout = 10;
+};
+
+class RS_API SimServer {
+public:
+	// Creates the shared memory region for the arenas
+	// Fails if the name is used by a running server, or by a region that isn't a left-over server of this version (which is replaced)
+	// NOTE: The server replaces the arenas' goal score and car bump callbacks
+	// NOTE: The arenas must not be used or deleted by anything else while the server exists
+	SimServer(std::string name, const std::vector<Arena*>& arenas, const SimServerConfig& config = {});
+	~SimServer(); // Marks the server as stopped for clients and unlinks the shared memory
+
+	SimServer(const SimServer& other) = delete;
+	SimServer& operator=(const SimServer& other) = delete;
+
+	const std::string& GetName() const { return _memory.GetName(); }
+	size_t GetNumArenas() const { return _channels.size(); }
+
+	// Handles at most one pending controls message per arena, returns the amount handled
+	// Arenas that were claimed since the last poll get their rings reset and their initial states first
+	// A message is only taken once there is room for its states, so slow clients stall their own arenas only
+	// Messages with a car count that doesn't match the arena are answered without stepping
+	// Also releases the arenas of clients that crashed, and revokes those of clients that stopped sending heartbeats (see SimArenaBlockHeader)
+	size_t Poll();
+
+	// Polls until Stop() is called, yielding and then sleeping while there is nothing to do
+	void Run();
+
+	// Can be called from any thread
+	void Stop();
+
+	uint64_t GetNumDroppedEvents() const {
+		return _header->numDroppedEvents.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct ArenaChannel {
+		SimServer* server;
+		Arena* arena;
+		SimArenaBlockHeader* blockHeader;
+		ShmRing controlsRing, statesRing, eventsRing;
+		uint32_t readyGeneration; // See SimArenaBlockHeader::readyGeneration
+	};
+
+	void _ReleaseLostClients();
+
+	// Empties the rings for a new claim, and sends the arena's initial states
+	void _ResetChannel(ArenaChannel& channel, uint32_t generation);
+
+	void _WriteStates(ArenaChannel& channel, uint64_t seq, void* message);
+	void _PushEvent(ArenaChannel& channel, const SimEvent& event);
+
+	SharedMemory _memory;
+	SimServerHeader* _header = NULL;
+	std::vector<ArenaChannel> _channels;
+	uint64_t _clientTimeoutNs = 0;
+	uint64_t _nextClientCheckTime = 0;
+	std::atomic<bool> _shouldStop = false;
+};
+
+RS_NS_END
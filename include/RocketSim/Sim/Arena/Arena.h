@@ -11,6 +11,8 @@
 #include <RocketSim/Sim/MutatorConfig/MutatorConfig.h>
 #include <RocketSim/Sim/Arena/ArenaConfig/ArenaConfig.h>
 #include <RocketSim/Sim/Arena/DropshotTiles/DropshotTiles.h>
+#include <RocketSim/Sim/Arena/ArenaSnapshot/ArenaSnapshot.h>
+#include <RocketSim/Sim/Arena/ThreadTeam/ThreadTeam.h>
 
 #include <bullet3-3.24/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <bullet3-3.24/BulletCollision/CollisionShapes/btStaticPlaneShape.h>
@@ -49,6 +51,7 @@ public:
 	MutatorConfig _mutatorConfig;
 
 	DropshotTilesState _dropshotTilesState;
+	DropshotTileMask _dropshotTilesChanged; // Tiles whose rigidbodies haven't been updated to their state yet
 
 	const MutatorConfig& GetMutatorConfig() { return _mutatorConfig; }
 	void SetMutatorConfig(const MutatorConfig& mutatorConfig);
@@ -96,6 +99,17 @@ public:
 	std::vector<btStaticPlaneShape*> _worldCollisionPlaneShapes = {};
 	std::vector<btRigidBody*> _worldDropshotTileRBs = {};
 
+	// State for multithreaded car updates (see ArenaConfig::carUpdateThreads)
+	struct {
+		ThreadTeam* team = NULL;
+		std::vector<Car*> cars; // In update order
+		std::vector<btVector3> reachMins, reachMaxs; // Bounds of each car's hitbox and wheel rays
+		std::vector<Car*> independentCars, linkedCars;
+	} _carThreading;
+
+	void _PreTickUpdateCarsThreaded();
+	void _PostTickUpdateCarsThreaded();
+
 	struct {
 		GoalScoreEventFn func = NULL;
 		void* userInfo = NULL;
@@ -117,6 +131,21 @@ public:
 	// Load new arena from serialized data
 	static Arena* DeserializeNew(DataStreamIn& in);
 
+	// Size in bytes of a snapshot of this arena (see ArenaSnapshot.h)
+	// Only changes when cars are added or removed
+	size_t GetSnapshotSize() const;
+
+	// Write a fixed-layout snapshot of the arena state into a preallocated buffer, returns the amount of bytes written
+	// NOTE: The buffer must be at least GetSnapshotSize() bytes, and aligned to ArenaSnapshotHeader::SECTION_ALIGNMENT
+	size_t WriteSnapshot(void* buffer, size_t bufferSize) const;
+
+	// Restore the state from a snapshot
+	// Arenas that apply the same snapshot simulate exactly the same afterwards, whatever they simulated before
+	// NOTE: This clears Bullet's contact caches, so applying a snapshot of an arena to itself can still change how it continues
+	// The snapshot must be from an arena with the same game mode, tick rate, boost pads, and car IDs
+	// NOTE: Car configs and teams are not restored
+	void ApplySnapshot(const ArenaSnapshotView& snapshot);
+
 	Arena(const Arena& other) = delete; // No copy constructor, use Arena::Clone() instead
 	Arena& operator =(const Arena& other) = delete; // No copy operator, use Arena::Clone() instead
 
@@ -124,8 +153,15 @@ public:
 	Arena& operator =(Arena&& other) = delete; // No move operator
 
 	// Get a deep copy of the arena
+	// All dynamic state is copied, including the mutator config, dropshot tiles, and car IDs
 	Arena* Clone(bool copyCallbacks);
 
+	// Get a copy of the arena that shares static collision data (the broadphase's static grid) with this arena, instead of rebuilding it
+	// Shared data is copy-on-write, so forks are fully independent of this arena, and either can be deleted first
+	// Copies the same state as Clone(), but is much cheaper than Clone() and Create(), intended for creating many short-lived branches (e.g. tree search)
+	// NOTE: Like Clone(), contact caches are not copied, so a fork can slowly diverge from this arena even with identical controls
+	Arena* Fork(bool copyCallbacks = false);
+
 	// NOTE: Car ID will not be restored
 	Car* DeserializeNewCar(DataStreamIn& in, Team team);
 
@@ -179,10 +215,21 @@ public:
 	DropshotTilesState GetDropshotTilesState() const { return _dropshotTilesState; };
 	void SetDropshotTilesState(const DropshotTilesState& tilesState);
 
+	// Updates the collision flags of the tiles in _dropshotTilesChanged
+	void _UpdateDropshotTileRBs();
+
 private:
 	
 	// Constructor for use by Arena::Create()
-	Arena(GameMode gameMode, const ArenaConfig& config, float tickRate = 120);
+	// If staticSource is set, static collision data is shared with it (see Fork())
+	Arena(GameMode gameMode, const ArenaConfig& config, float tickRate = 120, const Arena* staticSource = NULL);
+
+	// Copies everything but static data to a new arena with the same game mode and config, for Clone() and Fork()
+	void _CopyDynamicState(Arena* newArena, bool copyCallbacks);
+
+	// Rigid body state of a car or ball for snapshots, so that ApplySnapshot() restores it exactly
+	static ArenaSnapshotBodyState _GetSnapshotBodyState(const btRigidBody& rigidBody, const Vec& velocityImpulseCache);
+	static void _SetSnapshotBodyState(btRigidBody& rigidBody, Vec& velocityImpulseCache, const ArenaSnapshotBodyState& bodyState);
 
 	// Making this private because horrible memory overflows can happen if you changed it
 	ArenaConfig _config;
@@ -34,15 +34,23 @@ struct RS_API ArenaConfig {
 	bool noBallRot = true;
 
 	// Use a custom broadphase designed for RocketSim
-	// Improves performance, but becomes inefficient on giant maps
-	// Turn this off if you want to use a giant map
+	// Improves performance, but becomes inefficient on giant maps (unless useSparseBroadphaseGrid is on)
 	bool useCustomBroadphase = true;
 
+	// Only store the cells of the custom broadphase that have objects near them, instead of every cell between minPos and maxPos
+	// Memory then scales with the occupied space instead of the size of the map, at a small cost in speed
+	// Turn this on if you want to use a giant map, requires useCustomBroadphase
+	bool useSparseBroadphaseGrid = false;
+
 	// Maximum number of objects
 	int maxObjects = 512;
 
+	// Number of threads (including the thread calling Step()) that car updates within each tick are split across
+	// Results are identical to the single-threaded update, cars that could affect each other are updated in order on one thread
+	// Only worth it with many cars (16+) per arena, requires useCustomBroadphase
+	int carUpdateThreads = 1;
+
 	// Use a custom list of boost pads (customBoostPads) instead of the normal one
-	// NOTE: This will disable the boost pad grid and will thus worsen performance
 	bool useCustomBoostPads = false;
 	std::vector<BoostPadConfig> customBoostPads = {}; // Custom boost pads to use, if useCustomBoostPads
 
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <RocketSim/Sim/Car/Car.h>
+#include <RocketSim/Sim/Ball/Ball.h>
+#include <RocketSim/Sim/BoostPad/BoostPad.h>
+#include <RocketSim/Sim/MutatorConfig/MutatorConfig.h>
+#include <RocketSim/Sim/Arena/DropshotTiles/DropshotTiles.h>
+
+RS_NS_START
+
+// Physics state of a car or ball's rigid body, in Bullet units
+// Snapshots store this next to the state structs, as converting their UU values back to Bullet units loses the last bits of precision
+struct RS_API ArenaSnapshotBodyState {
+	Vec pos;
+	RotMat rotMat;
+	Vec vel, angVel;
+	Vec velocityImpulseCache;
+};
+
+// Wheel values that a car's next tick reads before updating them, which aren't part of CarState
+struct RS_API ArenaSnapshotWheelState {
+	float engineForce, brake, steerAngle;
+	float latFriction, longFriction;
+	float extraPushback;
+};
+
+// Fixed-layout binary snapshot of an arena's state
+// The snapshot is a header followed by one section per type of object (cars are further split into one array per field)
+// Sections are plain arrays of the in-memory state structs, so a snapshot can be written in one pass and read in place
+// NOTE: The layout depends on the platform's struct layout, so snapshots should only be read by the same build of RocketSim
+//	(the header stores the struct sizes and version to detect mismatches)
+struct RS_API ArenaSnapshotHeader {
+	constexpr static uint32_t MAGIC = 0x53414E53; // "SNAS"
+	constexpr static uint32_t FORMAT_VERSION = 2;
+
+	// All sections start at a multiple of this, and the snapshot buffer must be aligned to it as well
+	constexpr static size_t SECTION_ALIGNMENT = 16;
+
+	// Wheel states stored per car (cars with fewer wheels leave the rest zeroed)
+	constexpr static uint32_t WHEELS_PER_CAR = 4;
+
+	uint32_t magic;
+	uint32_t formatVersion;
+	uint32_t rocketSimVersion;
+	uint32_t totalSize;
+
+	// Sizes of the state structs when written, must match the reader's
+	uint32_t carStateSize, carConfigSize, carControlsSize, ballStateSize, boostPadStateSize, mutatorConfigSize, bodyStateSize, wheelStateSize;
+
+	GameMode gameMode;
+	bool hasDropshotTiles;
+	float tickTime;
+	uint64_t tickCount;
+	uint32_t lastCarID;
+
+	uint32_t numCars, numBoostPads;
+
+	// Byte offsets of each section from the start of the snapshot
+	struct {
+		uint32_t
+			carStates, carBodyStates, carWheelStates, carConfigs, carControls, carIDs, carTeams,
+			ballState, ballBodyState, boostPadStates, dropshotTilesState, mutatorConfig;
+	} offsets;
+
+	// Makes a header with all sizes and offsets set for the given amount of objects
+	static ArenaSnapshotHeader MakeLayout(uint32_t numCars, uint32_t numBoostPads, bool hasDropshotTiles);
+};
+
+// Read-only view of a snapshot, pointing directly into its buffer
+struct RS_API ArenaSnapshotView {
+	const ArenaSnapshotHeader* header = NULL;
+
+	// Car sections, all of length header->numCars
+	const CarState* carStates = NULL;
+	const ArenaSnapshotBodyState* carBodyStates = NULL;
+	const ArenaSnapshotWheelState* carWheelStates = NULL; // Of length header->numCars * WHEELS_PER_CAR
+	const CarConfig* carConfigs = NULL;
+	const CarControls* carControls = NULL;
+	const uint32_t* carIDs = NULL;
+	const Team* carTeams = NULL;
+
+	const BallState* ballState = NULL;
+	const ArenaSnapshotBodyState* ballBodyState = NULL;
+
+	// Of length header->numBoostPads
+	// NOTE: curLockedCar is always NULL, as it is a pointer
+	const BoostPadState* boostPadStates = NULL;
+
+	// NULL if the arena has no dropshot tiles
+	const DropshotTilesState* dropshotTilesState = NULL;
+
+	const MutatorConfig* mutatorConfig = NULL;
+
+	// Views a snapshot in place, without copying
+	// Fails if the header is invalid, was written by a different build, or doesn't fit in size
+	// NOTE: The data must stay alive for as long as the view is used
+	static ArenaSnapshotView FromBuffer(const void* data, size_t size);
+
+	// Returns the index of the car with this ID in the car sections, or -1 if not found
+	int FindCarIndex(uint32_t carID) const;
+};
+
+RS_NS_END
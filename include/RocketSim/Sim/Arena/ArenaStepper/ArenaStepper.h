@@ -0,0 +1,92 @@
+#pragma once
+
+#include <RocketSim/Sim/Arena/Arena.h>
+
+#include <future>
+#include <condition_variable>
+
+RS_NS_START
+
+// Steps a batch of arenas on its own executor thread, so the caller can work (e.g. run inference) while the arenas simulate
+// Controls and states are double-buffered, so the caller and the executor never touch the same slot:
+//	- The caller writes the controls of the next step into GetNextControls(), while the executor reads the controls of the step in flight
+//	- The executor writes the states of the step in flight, while the caller reads the states of the last finished step from GetStates()
+// To keep both the simulation and the caller busy, split arenas into two steppers and alternate between them:
+//	stepperA.StepAsync(ticks);
+//	while (...) {
+//		(compute controls for B from stepperB.GetStates())
+//		stepperB.StepAsync(ticks);
+//		stepperA.Wait();
+//		(compute controls for A from stepperA.GetStates())
+//		stepperA.StepAsync(ticks);
+//		stepperB.Wait();
+//	}
+// NOTE: The arenas must not be used or deleted by anything else while a step is in flight, and their cars should not be added or removed
+class RS_API ArenaStepper {
+public:
+	// numThreads is the amount of threads the executor splits the arenas across
+	ArenaStepper(const std::vector<Arena*>& arenas, int numThreads = 1);
+	~ArenaStepper(); // Waits for the step in flight to finish
+
+	ArenaStepper(const ArenaStepper& other) = delete;
+	ArenaStepper& operator=(const ArenaStepper& other) = delete;
+
+	size_t GetNumArenas() const {
+		return _arenas.size();
+	}
+
+	Arena* GetArena(size_t arenaIndex) const {
+		return _arenas[arenaIndex];
+	}
+
+	// Controls to apply in the next StepAsync(), in the same order as the cars in GetStates()
+	// Starts as a copy of the controls submitted in the previous StepAsync(), so only changes need to be written
+	std::vector<CarControls>& GetNextControls(size_t arenaIndex) {
+		return _arenaSlots[arenaIndex].controls[_nextControlsSlot];
+	}
+
+	// Snapshot of an arena after the last finished step (or from construction, if no step has finished yet)
+	// NOTE: The view is only safe to use from one thread, and stays valid until:
+	//	- The second StepAsync() after it was retrieved starts, if no step was in flight when it was retrieved
+	//	- The next StepAsync() starts, if a step was in flight when it was retrieved (as the step after it overwrites the view)
+	ArenaSnapshotView GetStates(size_t arenaIndex) const;
+
+	// Starts stepping every arena by the given amount of ticks, using the controls from GetNextControls()
+	// If a step is already in flight, waits for it first
+	// Errors during the step are rethrown by the returned future, and once by the next Wait() or StepAsync()
+	std::shared_future<void> StepAsync(int ticks);
+
+	// Waits for the step in flight to finish, does nothing if no step is in flight
+	void Wait();
+
+	bool IsStepping() const;
+
+private:
+	void _ExecutorLoop();
+	void _RunStep(int ticks);
+
+	std::vector<Arena*> _arenas;
+
+	struct ArenaSlots {
+		std::vector<CarControls> controls[2];
+		std::vector<byte> states[2];
+	};
+	std::vector<ArenaSlots> _arenaSlots;
+
+	int _nextControlsSlot = 0; // Written by the caller
+	int _stepControlsSlot = 1; // Read by the executor
+	std::atomic<int> _finishedStatesSlot = 0; // Read by the caller, the executor writes to the other one
+
+	ThreadTeam* _threadTeam = NULL;
+	std::thread _executor;
+
+	std::mutex _mutex;
+	std::condition_variable _jobCV;
+	bool _shouldStop = false;
+	int _pendingTicks = 0; // 0 if no step is pending
+	std::promise<void> _pendingPromise;
+
+	std::shared_future<void> _inFlight;
+};
+
+RS_NS_END
@@ -32,12 +32,51 @@ struct RS_API DropshotTilesState {
 	// TODO: Add serialization
 };
 
+// One bit per tile, indexed by (team * NUM_TILES_PER_TEAM + index)
+struct RS_API DropshotTileMask {
+	constexpr static int NUM_TILES = RLConst::Dropshot::TEAM_AMOUNT * RLConst::Dropshot::NUM_TILES_PER_TEAM;
+	constexpr static int NUM_WORDS = (NUM_TILES + 63) / 64;
+
+	uint64_t words[NUM_WORDS] = {};
+
+	void Set(int tileIdx) {
+		words[tileIdx / 64] |= 1ull << (tileIdx % 64);
+	}
+
+	bool Any() const {
+		uint64_t combined = 0;
+		for (uint64_t word : words)
+			combined |= word;
+		return combined != 0;
+	}
+
+	void Clear() {
+		for (uint64_t& word : words)
+			word = 0;
+	}
+
+	// Calls fn(tileIdx) for each set tile, in order
+	template <typename T>
+	void ForEach(T fn) const {
+		for (int i = 0; i < NUM_WORDS; i++)
+			for (uint64_t bits = words[i]; bits; bits &= bits - 1)
+				fn(i * 64 + std::countr_zero(bits));
+	}
+};
+
 namespace DropshotTiles {
 	RS_API void Init();
 
 	RS_API Vec GetTilePos(int team, int index);
+
+	// Makes new collision shapes for all tiles, owned by the caller
 	RS_API std::vector<btCollisionShape*> MakeTileShapes();
-	RS_API std::vector<int> GetNeighborIndices(int startIdx, int radius);
+
+	// Collision shapes for all tiles, made once by Init() and shared by all arenas (must not be modified)
+	RS_API const std::vector<btCollisionShape*>& GetTileShapes();
+
+	// NOTE: Neighbors include the starting tile
+	RS_API const std::vector<int>& GetNeighborIndices(int startIdx, int radius);
 };
 
 RS_NS_END
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <RocketSim/BaseInc.h>
+
+#include <condition_variable>
+
+RS_NS_START
+
+// Small persistent team of worker threads for splitting short, frequent jobs (such as per-car updates within a tick)
+// The calling thread takes part in each job, so a team of N threads owns N-1 workers
+// Workers spin briefly between jobs before sleeping, so back-to-back jobs don't pay for a wakeup
+class RS_API ThreadTeam {
+public:
+	typedef std::function<void(size_t index)> JobFn;
+
+	explicit ThreadTeam(int numThreads);
+	~ThreadTeam();
+
+	ThreadTeam(const ThreadTeam& other) = delete;
+	ThreadTeam& operator=(const ThreadTeam& other) = delete;
+
+	int GetNumThreads() const {
+		return (int)_workers.size() + 1;
+	}
+
+	// Calls fn(i) for every i in [0, count) across the team, returns once all calls have finished
+	// NOTE: Not reentrant, only one thread may run jobs on a team at a time
+	void Run(size_t count, const JobFn& fn);
+
+private:
+	void _WorkerLoop();
+	void _DoWork();
+
+	std::vector<std::thread> _workers;
+
+	std::mutex _mutex;
+	std::condition_variable _startCV, _doneCV;
+	std::atomic<uint64_t> _generation = 0;
+	std::atomic<int> _numBusyWorkers = 0;
+	std::atomic<bool> _shouldStop = false;
+
+	const JobFn* _job = NULL;
+	size_t _jobCount = 0;
+	std::atomic<size_t> _nextIndex = 0;
+};
+
+RS_NS_END
@@ -104,9 +104,9 @@ public:
 		GameMode gameMode, const MutatorConfig& mutatorConfig, uint64_t tickCount
 	);
 	void _OnWorldCollision(GameMode gameMode, Vec normal, float tickTime);
-	// Returns true if the tiles state was modified
+	// Returns true if the tiles state was modified, the modified tiles are added to changedTiles
 	bool _OnDropshotTileCollision(
-		DropshotTilesState& tilesState, int tileTotalIndex, const btCollisionObject* tileObj, 
+		DropshotTilesState& tilesState, DropshotTileMask& changedTiles, int tileTotalIndex, const btCollisionObject* tileObj, 
 		uint64_t tickCount, float tickTime
 	);
 		
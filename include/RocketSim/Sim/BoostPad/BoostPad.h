@@ -10,6 +10,8 @@
 
 RS_NS_START
 
+struct BoostPadGrid;
+
 struct RS_API BoostPadConfig {
 	Vec pos;
 	bool isBig = false;
@@ -40,10 +42,22 @@ public:
 	Vec _posBT;
 	Vec _boxMinBT, _boxMaxBT;
 
+	// NOTE: While cooling down, the cooldown is only counted down every few ticks by the grid (see BoostPadGrid::COOLDOWN_SYNC_INTERVAL)
 	BoostPadState _internalState;
 
-	BoostPadState GetState() const { return _internalState; }
-	void SetState(const BoostPadState& state) { _internalState = state; }
+	// Grid of the arena this pad is in, which schedules its cooldown and tracks its locked cars
+	BoostPadGrid* _grid = NULL;
+	uint32_t _gridIdx = 0; // Index in the grid's timer wheel and pad order
+	uint64_t _cooldownTick = 0; // Tick of the grid's timer wheel that _internalState.cooldown was counted down to
+
+	BoostPadState GetState() const {
+		BoostPadState state = _internalState;
+		state.cooldown = _GetCooldown();
+		return state;
+	}
+
+	// NOTE: Sets isActive from the cooldown (active only if the cooldown is 0)
+	void SetState(const BoostPadState& state);
 
 	// For construction by Arena
 	static BoostPad* _AllocBoostPad();
@@ -51,8 +65,15 @@ public:
 
 	void _CheckCollide(Car* car);
 
-	void _PreTickUpdate(float tickTime);
-	void _PostTickUpdate(float tickTime, const MutatorConfig& mutatorConfig);
+	// Cooldown counted down to the current tick of the grid's timer wheel, without writing it
+	float _GetCooldown() const;
+
+	// Writes the cooldown counted down to the current tick of the grid's timer wheel
+	void _SyncCooldown();
+
+	// Gives boost to the locked car and starts the cooldown, then moves the locked car to prevLockedCarID
+	// Only needed for pads that have a locked car this tick or had one last tick (see BoostPadGrid)
+	void _PostTickUpdate(const MutatorConfig& mutatorConfig);
 private:
 	BoostPad() {}
 };
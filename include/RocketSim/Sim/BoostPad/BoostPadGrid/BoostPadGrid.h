@@ -4,28 +4,67 @@
 #include <RocketSim/RLConst.h>
 
 #include <RocketSim/Sim/BoostPad/BoostPad.h>
+#include <RocketSim/Sim/TimerWheel/TimerWheel.h>
 
 RS_NS_START
 
+// Uniform 2D grid of boost pads, sized from the pads it is built with
+// Works for any amount and layout of pads (the standard layouts and custom ones)
+// Each pad is stored in the cell of its position, cars check the pads of every cell they can reach
+// Pad geometry is also kept in SoA arrays (in the same order as pads), so each car is tested against a whole range of pads in one branchless loop
+// Also runs the pads' tick updates: cooldowns are timers in a timer wheel, and only pads with a locked car (this tick or last tick) are updated
+// Cooling pads are counted down when their timer expires, which is at most every COOLDOWN_SYNC_INTERVAL ticks
 struct BoostPadGrid {
-	constexpr static float
-		EXTENT_X = 4096.f,
-		EXTENT_Y = 5120.f,
-		EXTENT_Z = RLConst::BoostPads::CYL_HEIGHT + 250.f;
+	// Extra distance for the difference between a car's hitbox and its AABB (collision margins)
+	constexpr static float CAR_AABB_MARGIN = 20.f;
 
-	constexpr static int
-		CELLS_X = 8,
-		CELLS_Y = 10,
-		CELL_SIZE_X = (int)(EXTENT_X / (CELLS_X / 2)),
-		CELL_SIZE_Y = (int)(EXTENT_Y / (CELLS_Y / 2)),
-		CELL_AMOUNT = CELLS_X * CELLS_Y;
+	// Most ticks between counting down the cooldown of a cooling pad, so BoostPad::GetState() only needs to count down a few ticks
+	constexpr static uint64_t COOLDOWN_SYNC_INTERVAL = 16;
 
-	BoostPad* pads[CELLS_X][CELLS_Y] = {};
+	std::vector<BoostPad*> pads; // Sorted by cell
+	std::vector<int> cellStarts; // Index of each cell's first pad in pads, with an extra entry at the end
+
+	Vec minPos;
+	float cellSize = 0, invCellSize = 0;
+	int cellsX = 0, cellsY = 0;
+	float minPadZ = 0, maxPadZ = 0;
+
+	// Indexed like pads
+	std::vector<float> padPosX, padPosY, padPosZ, padCylRadSq;
+	std::vector<float> padBoxMin[3], padBoxMax[3];
+	std::vector<uint32_t> padPrevLockedCarIDs; // Scratch for _CheckPadRange(), gathered from the pads
+	std::vector<int32_t> padColliding; // Scratch for _CheckPadRange()
+
+	float tickTime = 0;
+	TimerWheel cooldownTimers; // IDs are the pads' _gridIdx
+	std::vector<BoostPad*> padsByIdx; // In the order given to Build(), indexed by _gridIdx
+
+	std::vector<uint32_t> lockedPads; // Pads with a curLockedCar
+	std::vector<uint32_t> prevLockedPads; // Pads with a prevLockedCarID
+	std::vector<uint32_t> expiredPads, updatePads; // Scratch
 
 	RS_API BoostPadGrid() = default;
+	BoostPadGrid(const BoostPadGrid&) = delete; // Pads point to their grid
+
+	// Builds the grid from all pads that should be checked
+	RS_API void Build(const std::vector<BoostPad*>& pads, float tickTime);
+
+	// Counts down the cooldowns of pads whose timer expired, activates pads whose cooldown ended, and clears the locked cars of last tick
+	RS_API void PreTickUpdate();
+
+	// Updates pads with a locked car this tick or last tick (see BoostPad::_PostTickUpdate()), in pad order
+	RS_API void PostTickUpdate(const MutatorConfig& mutatorConfig);
 
 	RS_API void CheckCollision(Car* car);
-	RS_API void Add(BoostPad* pad);
+
+	RS_API void _CheckPadRange(Car* car, int start, int end);
+
+	// Schedules the pad's next cooldown count down (see COOLDOWN_SYNC_INTERVAL), or cancels it if the pad isn't cooling down
+	// Only counts the exact ticks left once the cooldown is within COOLDOWN_SYNC_INTERVAL + 1 ticks of ending
+	RS_API void _ScheduleCooldown(BoostPad* pad);
+
+	// Called by BoostPad::SetState()
+	RS_API void _OnPadStateSet(BoostPad* pad);
 };
 
-RS_NS_END
\ No newline at end of file
+RS_NS_END
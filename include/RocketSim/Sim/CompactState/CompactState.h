@@ -0,0 +1,79 @@
+#pragma once
+
+#include <RocketSim/Sim/Car/Car.h>
+#include <RocketSim/Sim/Ball/Ball.h>
+
+RS_NS_START
+
+// Lossy, fixed-size encoding of car and ball states for storage and transfer (observations, replay buffers, IPC)
+// Vectors are quantized to 16-bit integers with a configurable step size, rotations are stored as a 32-bit "smallest three" quaternion
+//
+// Maximum error (with an in-range value):
+//	pos/vel/angVel:	step/2 per component (values beyond +/-(step * 32767) are clamped)
+//	rotMat:			~0.003 per matrix element (under 0.2 degrees of rotation)
+//	boost:			100/255/2 (~0.2)
+//	timers:			timeStep/2 (values beyond timeStep * 65535 are clamped)
+//	flipRelTorque:	1/127/2 per component
+//
+// NOTE: Only the fields listed in CompactCarState/CompactBallState are encoded, decoding leaves all other fields of the output state untouched
+namespace CompactState {
+
+	struct RS_API Config {
+		// Step sizes of quantized values, smaller is more precise but has a smaller range
+		// The defaults cover the whole field and all reachable speeds
+		float posStep = 0.25f;		// UU, +/-8191 range
+		float velStep = 0.2f;		// UU/s, +/-6553 range
+		float angVelStep = 0.001f;	// rad/s, +/-32.7 range
+		float timeStep = 0.001f;	// s, 0-65.5 range
+	};
+
+	// Quantized pos, vel, angVel, and rotMat
+	struct CompactPhysState {
+		int16_t pos[3];
+		int16_t vel[3];
+		int16_t angVel[3];
+		int16_t _padding;
+		uint32_t rot; // 2-bit index of the largest quaternion component, then 3 10-bit components
+	};
+
+	enum CarFlags : uint16_t {
+		CAR_FLAG_ON_GROUND = 1 << 0,
+		CAR_FLAG_HAS_JUMPED = 1 << 1,
+		CAR_FLAG_HAS_DOUBLE_JUMPED = 1 << 2,
+		CAR_FLAG_HAS_FLIPPED = 1 << 3,
+		CAR_FLAG_IS_FLIPPING = 1 << 4,
+		CAR_FLAG_IS_JUMPING = 1 << 5,
+		CAR_FLAG_IS_BOOSTING = 1 << 6,
+		CAR_FLAG_IS_SUPERSONIC = 1 << 7,
+		CAR_FLAG_IS_AUTO_FLIPPING = 1 << 8,
+		CAR_FLAG_IS_DEMOED = 1 << 9,
+		CAR_FLAG_WORLD_CONTACT = 1 << 10,
+		CAR_FLAG_WHEEL_CONTACT_FIRST = 1 << 11, // 4 bits, one per wheel
+	};
+
+	// Packs a car state's booleans into CarFlags
+	RS_API uint16_t GetCarFlags(const CarState& state);
+
+	struct CompactCarState {
+		CompactPhysState phys;
+		uint16_t flags; // See CarFlags
+		uint8_t boost;
+		int8_t flipRelTorque[2]; // X and Y, Z is always 0
+		uint8_t _padding;
+		uint16_t jumpTime, flipTime, airTimeSinceJump, demoRespawnTimer;
+	};
+
+	struct CompactBallState {
+		CompactPhysState phys;
+	};
+
+	// Encode/decode arrays of states
+	// Vectors are quantized with SIMD where available, each state is encoded on its own
+	RS_API void EncodeCars(const CarState* states, size_t count, CompactCarState* out, const Config& config = {});
+	RS_API void DecodeCars(const CompactCarState* compactStates, size_t count, CarState* out, const Config& config = {});
+
+	RS_API void EncodeBalls(const BallState* states, size_t count, CompactBallState* out, const Config& config = {});
+	RS_API void DecodeBalls(const CompactBallState* compactStates, size_t count, BallState* out, const Config& config = {});
+}
+
+RS_NS_END
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <RocketSim/BaseInc.h>
+
+RS_NS_START
+
+// Schedules timers that expire after a whole amount of ticks, so that per-tick work only depends on the timers that expire
+// Timers are identified by an ID from 0 to the amount of IDs, each ID can have one timer at a time
+// Timers are stored in the slot of their expiry tick, timers further away than NUM_SLOTS ticks stay in their slot for multiple rotations
+// Deterministic: timers expiring on the same tick are returned in the order they were scheduled
+class RS_API TimerWheel {
+public:
+	constexpr static int NUM_SLOTS = 256;
+	constexpr static uint64_t NO_TIMER = UINT64_MAX;
+
+	// Amount of times Advance() was called
+	uint64_t tick = 0;
+
+	// Cancels all timers
+	void Reset(size_t numIDs);
+
+	size_t GetNumIDs() const {
+		return _expiryTicks.size();
+	}
+
+	// Replaces the ID's current timer, if it has one
+	// Expires on the Advance() call that reaches (tick + delayTicks), delayTicks must be at least 1
+	void Schedule(uint32_t id, uint64_t delayTicks);
+
+	// Does nothing if the ID has no timer
+	void Cancel(uint32_t id);
+
+	// Tick that the ID's timer expires on, or NO_TIMER
+	uint64_t GetExpiryTick(uint32_t id) const {
+		return _expiryTicks[id];
+	}
+
+	// Moves to the next tick, writing the IDs of the timers that expire on it to expiredIDs
+	void Advance(std::vector<uint32_t>& expiredIDs);
+
+private:
+	struct Entry {
+		uint64_t expiryTick;
+		uint32_t id;
+	};
+
+	std::vector<Entry> _slots[NUM_SLOTS];
+	std::vector<uint64_t> _expiryTicks; // Indexed by ID
+
+	static int GetSlot(uint64_t tick) {
+		return (int)(tick % NUM_SLOTS);
+	}
+};
+
+RS_NS_END
@@ -35,6 +35,10 @@ struct btBroadphaseRayCallback : public btBroadphaseAabbCallback
 	unsigned int m_signs[3];
 	btScalar m_lambda_max;
 
+	// ROCKETSIM CHANGE: Lets broadphases that visit proxies roughly in ray order stop once nothing closer can be hit
+	// Fraction of the ray (0 to 1) beyond which hits are no longer needed
+	virtual btScalar getMaxHitFraction() const { return 1; }
+
 	virtual ~btBroadphaseRayCallback() {}
 
 protected:
@@ -25,10 +25,12 @@ subject to the following restrictions:
 #include "../CollisionShapes/btBvhTriangleMeshShape.h"
 
 #include <new>
+#include <algorithm>
 #include <string>
 #include <stdexcept>
 #include <iostream>
 #include <mutex>
+#include <climits>
 
 #define THROW_ERR(msg) { std::string fullMsg = std::string() + "btRSBroadphase fatal error: " msg; std::cout << msg << std::endl; throw std::runtime_error(fullMsg); }
 
@@ -40,7 +42,7 @@ void btRSBroadphase::validate() {
 	}
 }
 
-btRSBroadphase::btRSBroadphase(btVector3 min, btVector3 max, float cellSize, btOverlappingPairCache* overlappingPairCache, int maxProxies)
+btRSBroadphase::btRSBroadphase(btVector3 min, btVector3 max, float cellSize, btOverlappingPairCache* overlappingPairCache, int maxProxies, bool sparseGrid)
 	: m_pairCache(overlappingPairCache),
 	m_ownsPairCache(false),
 	m_invalidPair(0) {
@@ -75,12 +77,29 @@ btRSBroadphase::btRSBroadphase(btVector3 min, btVector3 max, float cellSize, btO
 	this->cellSize = cellSize;
 	this->cellSizeSq = cellSize * cellSize;
 
-	cellsX = btMax(1, (int)ceil(range.x() / cellSize));
-	cellsY = btMax(1, (int)ceil(range.y() / cellSize));
-	cellsZ = btMax(1, (int)ceil(range.z() / cellSize));
+	double cellsXF = ceil(range.x() / cellSize), cellsYF = ceil(range.y() / cellSize), cellsZF = ceil(range.z() / cellSize);
+	if (cellsXF * cellsYF * cellsZF > INT_MAX)
+		THROW_ERR("Too many cells, increase the cell size or shrink the bounds");
+
+	cellsX = btMax(1, (int)cellsXF);
+	cellsY = btMax(1, (int)cellsYF);
+	cellsZ = btMax(1, (int)cellsZF);
 	totalCells = cellsX * cellsY * cellsZ;
 
-	cells = std::vector<Cell>(totalCells);
+	dynCells = btRSBroadphaseCellLists(totalCells, sparseGrid);
+	staticGrid = std::make_shared<btRSBroadphaseStaticGrid>(totalCells, sparseGrid);
+}
+
+bool btRSBroadphase::shareStaticGrid(const btRSBroadphase& other) {
+	bool compatible =
+		other.staticGrid && m_numHandles == 0 && m_maxHandles == other.m_maxHandles &&
+		minPos == other.minPos && cellSize == other.cellSize && dynCells.sparse == other.dynCells.sparse &&
+		cellsX == other.cellsX && cellsY == other.cellsY && cellsZ == other.cellsZ;
+
+	if (compatible)
+		staticGrid = other.staticGrid;
+
+	return compatible;
 }
 
 btRSBroadphase::~btRSBroadphase() {
@@ -92,23 +111,156 @@ btRSBroadphase::~btRSBroadphase() {
 	}
 }
 
-template <bool ADD>
-void _UpdateCellsStatic(btRSBroadphase* _this, btRSBroadphaseProxy* proxy) {
+bool btRSBroadphaseCellLists::contains(int cellIdx, int value) const {
+	for (int entry : (*this)[cellIdx])
+		if (entry == value)
+			return true;
+	return false;
+}
+
+void btRSBroadphaseCellLists::resizeSlots(int numSlots) {
+	counts.resize(numSlots);
+	inlineEntries.resize(numSlots * INLINE_CAPACITY);
+	overflowOffsets.resize(numSlots, -1);
+	overflowClasses.resize(numSlots);
+}
+
+int btRSBroadphaseCellLists::allocBlock(int capacityClass) {
+	if (capacityClass >= (int)freeBlocks.size())
+		freeBlocks.resize(capacityClass + 1);
+
+	auto& classFreeBlocks = freeBlocks[capacityClass];
+	if (!classFreeBlocks.empty()) {
+		int offset = classFreeBlocks.back();
+		classFreeBlocks.pop_back();
+		return offset;
+	}
+
+	int offset = (int)overflowPool.size();
+	overflowPool.resize(overflowPool.size() + getBlockCapacity(capacityClass));
+	return offset;
+}
+
+void btRSBroadphaseCellLists::add(int cellIdx, int value) {
+	int slot = getSlot(cellIdx);
+	if (slot < 0) {
+		// Give the cell a slot
+		if (!freeSlots.empty()) {
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		} else {
+			slot = (int)counts.size();
+			resizeSlots(slot + 1);
+		}
+		slotOfCell.insert(cellIdx, slot);
+	}
+
+	int count = counts[slot];
+	int offset = overflowOffsets[slot];
+	int capacity = (offset < 0) ? INLINE_CAPACITY : getBlockCapacity(overflowClasses[slot]);
+
+	if (count == capacity) {
+		// Move to a bigger block
+		int newClass = (offset < 0) ? 0 : (overflowClasses[slot] + 1);
+		int newOffset = allocBlock(newClass);
+		const int* oldEntries = (offset < 0) ? &inlineEntries[slot * INLINE_CAPACITY] : &overflowPool[offset];
+		std::copy(oldEntries, oldEntries + count, &overflowPool[newOffset]);
+
+		if (offset >= 0)
+			freeBlocks[overflowClasses[slot]].push_back(offset);
+
+		overflowOffsets[slot] = offset = newOffset;
+		overflowClasses[slot] = newClass;
+	}
+
+	int* entries = (offset < 0) ? &inlineEntries[slot * INLINE_CAPACITY] : &overflowPool[offset];
+	entries[count] = value;
+	counts[slot] = count + 1;
+}
+
+void btRSBroadphaseCellLists::remove(int cellIdx, int value) {
+	int slot = getSlot(cellIdx);
+	if (slot < 0)
+		return;
+
+	int count = counts[slot];
+	int offset = overflowOffsets[slot];
+	int* entries = (offset < 0) ? &inlineEntries[slot * INLINE_CAPACITY] : &overflowPool[offset];
+
+	for (int i = 0; i < count; i++) {
+		if (entries[i] == value) {
+			entries[i] = entries[count - 1];
+			count--;
+			counts[slot] = count;
+
+			if (offset >= 0 && count <= INLINE_CAPACITY) {
+				// Fits inline again, give the block back
+				std::copy(entries, entries + count, &inlineEntries[slot * INLINE_CAPACITY]);
+				freeBlocks[overflowClasses[slot]].push_back(offset);
+				overflowOffsets[slot] = -1;
+			}
+
+			if (sparse && count == 0) {
+				// Give the slot back
+				slotOfCell.remove(cellIdx);
+				freeSlots.push_back(slot);
+			}
+			return;
+		}
+	}
+}
+
+btRSBroadphaseStaticGrid::Entry _MakeStaticGridEntry(const btRSBroadphase* _this, const btRSBroadphaseProxy* proxy) {
 
 	// Fix dumb massive value aabb bug
 	btVector3 aabbMax = proxy->m_aabbMax;
 	for (int i = 0; i < 3; i++)
 		aabbMax[i] = btMin(aabbMax[i], _this->maxPos[i]);
 
-	int iMin, jMin, kMin;
-	int iMax, jMax, kMax;
-	_this->GetCellIndices(proxy->m_aabbMin, iMin, jMin, kMin);
-	_this->GetCellIndices(aabbMax, iMax, jMax, kMax);
-
-	btCollisionObject* colObj = (btCollisionObject*)proxy->m_clientObject;
+	btRSBroadphaseStaticGrid::Entry entry = {};
+	entry.valid = true;
+	_this->GetCellIndices(proxy->m_aabbMin, entry.iMin, entry.jMin, entry.kMin);
+	_this->GetCellIndices(aabbMax, entry.iMax, entry.jMax, entry.kMax);
 
 	// We should check if each cell actually collides with the object
+	btCollisionObject* colObj = (btCollisionObject*)proxy->m_clientObject;
 	bool isTriMesh = colObj && colObj->m_collisionShape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE;
+	entry.triMeshShape = isTriMesh ? colObj->m_collisionShape : NULL;
+
+	return entry;
+}
+
+// Entries that match will have been added to exactly the same cells
+bool _StaticGridEntriesMatch(const btRSBroadphaseStaticGrid::Entry& a, const btRSBroadphaseStaticGrid::Entry& b) {
+	return
+		a.valid && b.valid &&
+		a.iMin == b.iMin && a.jMin == b.jMin && a.kMin == b.kMin &&
+		a.iMax == b.iMax && a.jMax == b.jMax && a.kMax == b.kMax &&
+		a.triMeshShape == b.triMeshShape;
+}
+
+// Calls fn(cellIdx) on every cell within 1 cell of (i, j, k)
+template <typename T>
+void _ForEachNeighborCell(btRSBroadphase* _this, int i, int j, int k, T fn) {
+	for (int i1 = -1; i1 <= 1; i1++) {
+		for (int j1 = -1; j1 <= 1; j1++) {
+			for (int k1 = -1; k1 <= 1; k1++) {
+				int ci = i + i1;
+				int cj = j + j1;
+				int ck = k + k1;
+				if (ci < 0 || cj < 0 || ck < 0)
+					continue;
+				if (ci >= _this->cellsX || cj >= _this->cellsY || ck >= _this->cellsZ)
+					continue;
+				fn(ci * _this->cellsY * _this->cellsZ + cj * _this->cellsZ + ck);
+			}
+		}
+	}
+}
+
+// NOTE: Static grid must be unique
+void _AddToStaticGrid(btRSBroadphase* _this, int handleIdx, const btRSBroadphaseStaticGrid::Entry& entry) {
+	auto& grid = *_this->staticGrid;
 
 	// For checking if an AABB has any containing triangles
 	struct BoolHitTriangleCallback : public btTriangleCallback {
@@ -122,67 +274,87 @@ void _UpdateCellsStatic(btRSBroadphase* _this, btRSBroadphaseProxy* proxy) {
 	};
 	BoolHitTriangleCallback callbackInst = {};
 
-	int numSkipped = 0;
-	for (int i = iMin; i <= iMax; i++) {
-		for (int j = jMin; j <= jMax; j++) {
-			for (int k = kMin; k <= kMax; k++) {
-				std::vector<btRSBroadphase::Cell*> cells = {};
-				for (int i1 = -1; i1 <= 1; i1++) {
-					for (int j1 = -1; j1 <= 1; j1++) {
-						for (int k1 = -1; k1 <= 1; k1++) {
-							int ci = i + i1;
-							int cj = j + j1;
-							int ck = k + k1;
-							if (ci < 0 || cj < 0 || ck < 0)
-								continue;
-							if (ci >= _this->cellsX || cj >= _this->cellsY || ck >= _this->cellsZ)
-								continue;
-							cells.push_back(&_this->GetCell(ci, cj, ck));
-						}
-					}
-				}
-				
-				if (isTriMesh) {
-					auto triMeshShape = (btTriangleMeshShape*)colObj->m_collisionShape;
+	for (int i = entry.iMin; i <= entry.iMax; i++) {
+		for (int j = entry.jMin; j <= entry.jMax; j++) {
+			for (int k = entry.kMin; k <= entry.kMax; k++) {
+				if (entry.triMeshShape) {
+					auto triMeshShape = (btTriangleMeshShape*)entry.triMeshShape;
 					btVector3 cellMin = _this->GetCellMinPos(i, j, k);
 					btVector3 cellMax = cellMin + btVector3(_this->cellSize, _this->cellSize, _this->cellSize);
 
 					callbackInst.hit = false;
 					triMeshShape->processAllTriangles(&callbackInst, cellMin, cellMax);
 
-					if (!callbackInst.hit) {
-						numSkipped++;
+					if (!callbackInst.hit)
+						continue; // No tris in this AABB, ignore
+				}
 
-						if (ADD) {
-							continue; // No tris in this AABB, ignore
-						} else {
-							// Remove it anyway
-						}
+				_ForEachNeighborCell(_this, i, j, k,
+					[&](int cellIdx) {
+						if (!grid.cellHandles.contains(cellIdx, handleIdx))
+							grid.cellHandles.add(cellIdx, handleIdx);
 					}
-				}
+				);
+			}
+		}
+	}
 
-				for (auto cell : cells) {
-					if (ADD) {
-						bool alreadyExists = false;
-						for (auto staticHandle : cell->staticHandles) {
-							if (staticHandle == proxy) {
-								alreadyExists = true;
-								break;
-							}
-						}
-						if (!alreadyExists)
-							cell->staticHandles.push_back(proxy);
-					} else {
-						cell->RemoveStatic(proxy);
+	if (handleIdx >= (int)grid.entries.size())
+		grid.entries.resize(handleIdx + 1);
+	grid.entries[handleIdx] = entry;
+}
+
+// NOTE: Static grid must be unique
+void _RemoveFromStaticGrid(btRSBroadphase* _this, int handleIdx) {
+	auto& grid = *_this->staticGrid;
+	auto& entry = grid.entries[handleIdx];
+
+	for (int i = entry.iMin; i <= entry.iMax; i++) {
+		for (int j = entry.jMin; j <= entry.jMax; j++) {
+			for (int k = entry.kMin; k <= entry.kMax; k++) {
+				_ForEachNeighborCell(_this, i, j, k,
+					[&](int cellIdx) {
+						grid.cellHandles.remove(cellIdx, handleIdx);
 					}
-				}
+				);
 			}
 		}
 	}
+
+	entry.valid = false;
+}
+
+// Makes the static grid contain the static proxy with its current AABB
+void _UpdateStaticGrid(btRSBroadphase* _this, btRSBroadphaseProxy* proxy) {
+	if (!_this->staticGrid)
+		return;
+
+	int handleIdx = int(proxy - _this->m_pHandles);
+	btRSBroadphaseStaticGrid::Entry newEntry = _MakeStaticGridEntry(_this, proxy);
+	if (_StaticGridEntriesMatch(_this->staticGrid->getEntry(handleIdx), newEntry))
+		return; // Already in the same cells (either unmoved, or from a shared grid)
+
+	_this->makeStaticGridUnique();
+	if (_this->staticGrid->getEntry(handleIdx).valid)
+		_RemoveFromStaticGrid(_this, handleIdx);
+	_AddToStaticGrid(_this, handleIdx, newEntry);
+}
+
+// Makes sure the static grid does not contain this handle
+void _ClearStaticGrid(btRSBroadphase* _this, btRSBroadphaseProxy* proxy) {
+	if (!_this->staticGrid)
+		return;
+
+	int handleIdx = int(proxy - _this->m_pHandles);
+	if (_this->staticGrid->getEntry(handleIdx).valid) {
+		_this->makeStaticGridUnique();
+		_RemoveFromStaticGrid(_this, handleIdx);
+	}
 }
 
 template <bool ADD>
 void _UpdateCellsDynamic(btRSBroadphase* _this, btRSBroadphaseProxy* proxy, int ci, int cj, int ck) {
+	int handleIdx = int(proxy - _this->m_pHandles);
 
 	int mni = btMax(0, ci - 1), mnj = btMax(0, cj - 1), mnk = btMax(0, ck - 1);
 	int mxi = btMin(_this->cellsX - 1, ci + 1), mxj = btMin(_this->cellsY - 1, cj + 1), mxk = btMin(_this->cellsZ - 1, ck + 1);
@@ -190,11 +362,11 @@ void _UpdateCellsDynamic(btRSBroadphase* _this, btRSBroadphaseProxy* proxy, int
 	for (int ci = mni; ci <= mxi; ci++) {
 		for (int cj = mnj; cj <= mxj; cj++) {
 			for (int ck = mnk; ck <= mxk; ck++) {
-				auto& cell = _this->GetCell(ci, cj, ck);
+				int cellIdx = _this->GetCellIdx(ci, cj, ck);
 				if (ADD) {
-					cell.dynHandles.push_back(proxy);
+					_this->dynCells.add(cellIdx, handleIdx);
 				} else {
-					cell.RemoveDyn(proxy);
+					_this->dynCells.remove(cellIdx, handleIdx);
 				}
 			}
 		}
@@ -222,12 +394,15 @@ btBroadphaseProxy* btRSBroadphase::createProxy(const btVector3& aabbMin, const b
 	);
 
 	if (isStatic) {
-		_UpdateCellsStatic<true>(this, proxy);
+		_UpdateStaticGrid(this, proxy);
 
 	} else {
 		if (aabbMin.distance2(aabbMax) > cellSizeSq)
 			THROW_ERR("Dynamic object's AABB size exceeds maximum cell size (" + std::to_string(aabbMin.distance(aabbMax)) + " > " + std::to_string(cellSize) + ")");
 
+		// A shared static grid can have a static proxy at this handle index
+		_ClearStaticGrid(this, proxy);
+
 		_UpdateCellsDynamic<true>(this, proxy, iIdx, jIdx, kIdx);
 		numDynProxies++;
 	}
@@ -265,9 +440,17 @@ protected:
 void btRSBroadphase::destroyProxy(btBroadphaseProxy* proxyOrg, btCollisionDispatcher* dispatcher) {
 	btRSBroadphaseProxy* sbp = getRSProxyFromProxy(proxyOrg);
 	m_pairCache->removeOverlappingPairsContainingProxy(proxyOrg, dispatcher);
+
+	// Forget the removed pairs, the handle can be reused before the next calculateOverlappingPairs()
+	activePairs.erase(
+		std::remove_if(activePairs.begin(), activePairs.end(),
+			[sbp](const ProxyPair& pair) { return pair.first == sbp || pair.second == sbp; }
+		),
+		activePairs.end()
+	);
 	
 	if (sbp->isStatic) {
-		_UpdateCellsStatic<false>(this, sbp);
+		_ClearStaticGrid(this, sbp);
 	} else {
 		_UpdateCellsDynamic<false>(this, sbp, sbp->iIdx, sbp->jIdx, sbp->kIdx);
 		numDynProxies--;
@@ -288,12 +471,10 @@ void btRSBroadphase::setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin,
 	
 	if (sbp->m_aabbMin != aabbMin || sbp->m_aabbMax != aabbMax) {
 		if (sbp->isStatic) {
-			_UpdateCellsStatic<false>(this, sbp);
-
 			sbp->m_aabbMin = aabbMin;
 			sbp->m_aabbMax = aabbMax;
 
-			_UpdateCellsStatic<true>(this, sbp);
+			_UpdateStaticGrid(this, sbp);
 		} else {
 
 			int oldIndex = sbp->cellIdx;
@@ -322,26 +503,148 @@ void btRSBroadphase::setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin,
 	}
 }
 
+// Proxies are in many cells, so queries use these to only process each proxy once
+// Per-thread, as queries can be made from multiple threads at once
+// NOTE: Queries can't be nested on one thread (e.g. querying again from within a query's callback)
+struct _ProxyVisitStamps {
+	std::vector<uint32_t> stamps;
+	uint32_t curStamp = 0;
+
+	// Starts a new query
+	void begin(size_t maxHandles) {
+		if (stamps.size() < maxHandles)
+			stamps.resize(maxHandles, 0);
+
+		if (++curStamp == 0) { // Wrapped around
+			std::fill(stamps.begin(), stamps.end(), 0);
+			curStamp = 1;
+		}
+	}
+
+	// Returns true the first time a handle is visited in the current query
+	bool visit(int handleIdx) {
+		if (stamps[handleIdx] == curStamp)
+			return false;
+		stamps[handleIdx] = curStamp;
+		return true;
+	}
+};
+thread_local _ProxyVisitStamps _visitStamps;
+
+// Visits the cells that a ray crosses in order (3D-DDA), calling fn(cellIdx) on each
+// Stops once fn returns false, or the ray ends
+// NOTE: The ray must be within the grid bounds
+template <typename T>
+void _ForEachRayCell(const btRSBroadphase* _this, const btVector3& rayFrom, const btVector3& rayTo, T fn) {
+	btVector3 rayDir = rayTo - rayFrom;
+
+	int cell[3];
+	_this->GetCellIndices(rayFrom, cell[0], cell[1], cell[2]);
+	int cellCounts[3] = { _this->cellsX, _this->cellsY, _this->cellsZ };
+
+	// Ray fraction at which the next cell boundary on each axis is reached, and between boundaries
+	int step[3];
+	float nextFrac[3], deltaFrac[3];
+	for (int i = 0; i < 3; i++) {
+		if (rayDir[i] > 0) {
+			step[i] = 1;
+		} else if (rayDir[i] < 0) {
+			step[i] = -1;
+		} else {
+			step[i] = 0;
+			nextFrac[i] = deltaFrac[i] = BT_LARGE_FLOAT;
+			continue;
+		}
+
+		float boundary = _this->minPos[i] + (cell[i] + (step[i] > 0)) * _this->cellSize;
+		nextFrac[i] = (boundary - rayFrom[i]) / rayDir[i];
+		deltaFrac[i] = _this->cellSize / btFabs(rayDir[i]);
+	}
+
+	float entryFrac = 0;
+	while (true) {
+		int cellIdx = cell[0] * _this->cellsY * _this->cellsZ + cell[1] * _this->cellsZ + cell[2];
+		if (!fn(cellIdx, entryFrac))
+			return;
+
+		int axis = (nextFrac[0] < nextFrac[1]) ? ((nextFrac[0] < nextFrac[2]) ? 0 : 2) : ((nextFrac[1] < nextFrac[2]) ? 1 : 2);
+		if (nextFrac[axis] > 1)
+			return; // Ray ends in this cell
+
+		entryFrac = nextFrac[axis];
+		cell[axis] += step[axis];
+		if (cell[axis] < 0 || cell[axis] >= cellCounts[axis])
+			return;
+		nextFrac[axis] += deltaFrac[axis];
+	}
+}
+
 void btRSBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback, const btVector3& aabbMin, const btVector3& aabbMax) {
-	float rayLenSq = rayFrom.distance2(rayTo);
+	// Rays walk the cells they cross
+	// An object hit at some point of the ray overlaps that point's cell, so it is in that cell's handles
+	// This doesn't hold for swept shapes (which have an AABB), or points outside of the grid (which are clamped to its edge cells)
+	// Short rays too, as a dynamic proxy is only in the cells next to its AABB's min corner, which can be 2 cells from where a ray that hits it starts
+	bool isSweep = !aabbMin.isZero() || !aabbMax.isZero();
+	bool withinGrid = true;
+	for (int i = 0; i < 3; i++) {
+		withinGrid &=
+			rayFrom[i] >= minPos[i] && rayFrom[i] < maxPos[i] &&
+			rayTo[i] >= minPos[i] && rayTo[i] < maxPos[i];
+	}
 
-	if (rayLenSq < cellSizeSq) {
+	if (!isSweep && withinGrid) {
+		_visitStamps.begin(m_maxHandles);
 
-		Cell& cell = cells[GetCellIdx(rayFrom)];
-		for (auto& otherProxy : cell.staticHandles)
-			if (otherProxy->m_clientObject)
-				rayCallback.process(otherProxy);
-		for (auto& otherProxy : cell.dynHandles)
+		auto fnProcess = [&](btRSBroadphaseProxy* proxy) {
+			if (!proxy->m_clientObject || !_visitStamps.visit(int(proxy - m_pHandles)))
+				return;
+
+			// Cells hold everything near them, so skip proxies that the ray misses (like btDbvtBroadphase does)
+			btVector3 bounds[2] = { proxy->m_aabbMin, proxy->m_aabbMax };
+			btScalar hitLambda;
+			if (btRayAabb2(rayFrom, rayCallback.m_rayDirectionInverse, rayCallback.m_signs, bounds, hitLambda, 0, rayCallback.m_lambda_max))
+				rayCallback.process(proxy);
+		};
+
+		_ForEachRayCell(this, rayFrom, rayTo,
+			[&](int cellIdx, float entryFrac) {
+				// Everything in this cell and beyond is further than the closest hit
+				if (entryFrac > rayCallback.getMaxHitFraction())
+					return false;
+
+				if (staticGrid)
+					for (int handleIdx : staticGrid->cellHandles[cellIdx])
+						fnProcess(&m_pHandles[handleIdx]);
+
+				for (int handleIdx : dynCells[cellIdx])
+					fnProcess(&m_pHandles[handleIdx]);
+
+				return true;
+			}
+		);
+	} else if (rayFrom.distance2(rayTo) < cellSizeSq) {
+		int cellIdx = GetCellIdx(rayFrom);
+		if (staticGrid) {
+			for (int handleIdx : staticGrid->cellHandles[cellIdx]) {
+				btRSBroadphaseProxy* otherProxy = &m_pHandles[handleIdx];
+				if (otherProxy->m_clientObject)
+					rayCallback.process(otherProxy);
+			}
+		}
+
+		for (int handleIdx : dynCells[cellIdx]) {
+			btRSBroadphaseProxy* otherProxy = &m_pHandles[handleIdx];
 			if (otherProxy->m_clientObject)
 				rayCallback.process(otherProxy);
+		}
 	} else {
 		static std::once_flag onceFlag;
 		std::call_once(onceFlag, 
 			[this]() {
 				std::cout <<
 					"[!] btRSBroadphase WARNING:" <<
-					"\nRay casts in RocketSim that are longer than " << this->cellSize << "uu are very expensive and not properly optimized." <<
-					"\nIf you have a project that requires these long rays, tell ZealanL to implement proper DDA for the custom voxel broadphase." <<
+					"\nRay casts in RocketSim that are longer than " << this->cellSize << "uu and leave the arena bounds (or sweep a shape) are very expensive." <<
+					"\nThey have to test every object in the arena." <<
 					std::endl;
 			}
 		);
@@ -356,18 +659,89 @@ void btRSBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo, b
 	}
 }
 
-void btRSBroadphase::aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback) {
-	// TODO: Optimize
+// Calls fn(proxy) once on every proxy whose AABB overlaps the given AABB
+// Candidates come from the cells that the AABB overlaps, so triangle meshes are only found if they have triangles near it
+template <typename T>
+void _ForEachAabbOverlap(btRSBroadphase* _this, const btVector3& aabbMin, const btVector3& aabbMax, T fn) {
+	auto fnTest = [&](btRSBroadphaseProxy* proxy) {
+		if (proxy->m_clientObject && TestAabbAgainstAabb2(aabbMin, aabbMax, proxy->m_aabbMin, proxy->m_aabbMax))
+			fn(proxy);
+	};
 
-	for (int i = 0; i <= m_LastHandleIndex; i++) {
-		btRSBroadphaseProxy* proxy = &m_pHandles[i];
-		if (!proxy->m_clientObject)
-			continue;
-		
-		if (TestAabbAgainstAabb2(aabbMin, aabbMax, proxy->m_aabbMin, proxy->m_aabbMax)) {
-			callback.process(proxy);
+	auto fnScanHandles = [&]() {
+		for (int i = 0; i <= _this->m_LastHandleIndex; i++)
+			fnTest(&_this->m_pHandles[i]);
+	};
+
+	// Scanning every handle is cheaper in small worlds
+	constexpr int MIN_HANDLES_FOR_GRID = 32;
+	int numHandlesToScan = _this->m_LastHandleIndex + 1;
+	if (!_this->staticGrid || numHandlesToScan < MIN_HANDLES_FOR_GRID) {
+		fnScanHandles();
+		return;
+	}
+
+	int iMin, jMin, kMin, iMax, jMax, kMax;
+	_this->GetCellIndices(aabbMin, iMin, jMin, kMin);
+	_this->GetCellIndices(aabbMax, iMax, jMax, kMax);
+
+	auto fnForEachCell = [&](auto fnCell) {
+		for (int i = iMin; i <= iMax; i++)
+			for (int j = jMin; j <= jMax; j++)
+				for (int k = kMin; k <= kMax; k++)
+					fnCell(i * _this->cellsY * _this->cellsZ + j * _this->cellsZ + k);
+	};
+
+	// ...and if the cells have more entries than there are handles
+	int numCells = (iMax - iMin + 1) * (jMax - jMin + 1) * (kMax - kMin + 1);
+	if (numCells >= numHandlesToScan) {
+		fnScanHandles();
+		return;
+	}
+
+	size_t numEntries = 0;
+	fnForEachCell(
+		[&](int cellIdx) {
+			numEntries += _this->staticGrid->cellHandles[cellIdx].size() + _this->dynCells[cellIdx].size();
 		}
+	);
+	if (numEntries > (size_t)numHandlesToScan) {
+		fnScanHandles();
+		return;
 	}
+
+	_visitStamps.begin(_this->m_maxHandles);
+	fnForEachCell(
+		[&](int cellIdx) {
+			for (int handleIdx : _this->staticGrid->cellHandles[cellIdx])
+				if (_visitStamps.visit(handleIdx))
+					fnTest(&_this->m_pHandles[handleIdx]);
+
+			for (int handleIdx : _this->dynCells[cellIdx])
+				if (_visitStamps.visit(handleIdx))
+					fnTest(&_this->m_pHandles[handleIdx]);
+		}
+	);
+}
+
+void btRSBroadphase::aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback) {
+	_ForEachAabbOverlap(this, aabbMin, aabbMax,
+		[&](btRSBroadphaseProxy* proxy) {
+			callback.process(proxy);
+		}
+	);
+}
+
+int btRSBroadphase::aabbQuery(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseProxy** results, int maxResults) {
+	int numResults = 0;
+	_ForEachAabbOverlap(this, aabbMin, aabbMax,
+		[&](btRSBroadphaseProxy* proxy) {
+			if (numResults < maxResults)
+				results[numResults] = proxy;
+			numResults++;
+		}
+	);
+	return numResults;
 }
 
 bool btRSBroadphase::aabbOverlap(btRSBroadphaseProxy* proxy0, btRSBroadphaseProxy* proxy1) {
@@ -391,18 +765,12 @@ std::string ToStr(const btVector3& vec) {
 
 void btRSBroadphase::calculateOverlappingPairs(btCollisionDispatcher* dispatcher) {
 
-	int lastRealPairs = totalRealPairs;
-
-	bool shouldRemove = !m_pairCache->hasDeferredRemoval();
-
-	if (shouldRemove) {
-		for (auto pair : activePairs) {
-			m_pairCache->removeOverlappingPair(pair.first, pair.second, dispatcher);
-		}
-		activePairs.clear();
-	} else {
+	if (m_pairCache->hasDeferredRemoval())
 		THROW_ERR("Pair cache cannot have deferred removal");
-	}
+
+	// Gather all overlapping pairs of this tick into newActivePairs
+	// Pairs that were already overlapping are left alone in the pair cache, so their collision algorithms and manifolds persist
+	newActivePairs.clear();
 
 	if (m_numHandles >= 0) {
 
@@ -419,41 +787,39 @@ void btRSBroadphase::calculateOverlappingPairs(btCollisionDispatcher* dispatcher
 
 			new_largest_index = i;
 
-			Cell& cell = cells[proxy->cellIdx];
-			
-			for (auto& otherProxy : cell.staticHandles) {
-				if (!otherProxy->m_clientObject)
-					continue;
+			if (staticGrid) {
+				for (int staticHandleIdx : staticGrid->cellHandles[proxy->cellIdx]) {
+					btRSBroadphaseProxy* otherProxy = &m_pHandles[staticHandleIdx];
+					if (!otherProxy->m_clientObject)
+						continue;
 
-				totalStaticPairs++;
+					totalStaticPairs++;
 
-				
-				if (aabbOverlap(proxy, otherProxy)) {
-					if (!m_pairCache->findPair(proxy, otherProxy)) {
-						m_pairCache->addOverlappingPair(proxy, otherProxy);
-						activePairs.push_back({ proxy, otherProxy });
+					if (aabbOverlap(proxy, otherProxy)) {
+						newActivePairs.push_back(proxy < otherProxy ? ProxyPair(proxy, otherProxy) : ProxyPair(otherProxy, proxy));
 						totalRealPairs++;
 					}
 				}
 			}
 
 			if (numDynProxies > 1) {
-				if (cell.dynHandles.size() > 1) { // We are dynamic, so there will always be 1
-					for (auto& otherProxy : cell.dynHandles) {
-						if (otherProxy == proxy)
+				auto cellDynHandles = dynCells[proxy->cellIdx];
+				if (cellDynHandles.size() > 1) { // We are dynamic, so there will always be 1
+					for (int otherHandleIdx : cellDynHandles) {
+						// Dynamic proxies see each other, so only take each pair from its first proxy
+						if (otherHandleIdx <= i)
 							continue;
 
+						btRSBroadphaseProxy* otherProxy = &m_pHandles[otherHandleIdx];
+
 						if (!otherProxy->m_clientObject)
 							continue;
 
 						totalDynPairs++;
 
 						if (aabbOverlap(proxy, otherProxy)) {
-							if (!m_pairCache->findPair(proxy, otherProxy)) {
-								m_pairCache->addOverlappingPair(proxy, otherProxy);
-								activePairs.push_back({ proxy, otherProxy });
-								totalRealPairs++;
-							}
+							newActivePairs.push_back({ proxy, otherProxy });
+							totalRealPairs++;
 						}
 					}
 				}
@@ -465,6 +831,30 @@ void btRSBroadphase::calculateOverlappingPairs(btCollisionDispatcher* dispatcher
 		if (m_ownsPairCache)
 			THROW_ERR("Cannot own pair cache!");
 	}
+
+	std::sort(newActivePairs.begin(), newActivePairs.end());
+	newActivePairs.erase(std::unique(newActivePairs.begin(), newActivePairs.end()), newActivePairs.end());
+
+	// Only add/remove the pairs that changed since last tick (both lists are sorted)
+	numPairsAdded = numPairsRemoved = numPairsPersisted = 0;
+	size_t oldIdx = 0, newIdx = 0;
+	while (oldIdx < activePairs.size() || newIdx < newActivePairs.size()) {
+		if (newIdx == newActivePairs.size() || (oldIdx < activePairs.size() && activePairs[oldIdx] < newActivePairs[newIdx])) {
+			auto& pair = activePairs[oldIdx++];
+			m_pairCache->removeOverlappingPair(pair.first, pair.second, dispatcher);
+			numPairsRemoved++;
+		} else if (oldIdx == activePairs.size() || newActivePairs[newIdx] < activePairs[oldIdx]) {
+			auto& pair = newActivePairs[newIdx++];
+			m_pairCache->addOverlappingPair(pair.first, pair.second);
+			numPairsAdded++;
+		} else {
+			oldIdx++;
+			newIdx++;
+			numPairsPersisted++;
+		}
+	}
+
+	activePairs.swap(newActivePairs);
 }
 
 bool btRSBroadphase::testAabbOverlap(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) {
@@ -474,5 +864,10 @@ bool btRSBroadphase::testAabbOverlap(btBroadphaseProxy* proxy0, btBroadphaseProx
 }
 
 void btRSBroadphase::resetPool(btCollisionDispatcher* dispatcher) {
-	// TODO: ?
+	// ROCKETSIM CHANGE: Remove every pair, along with its collision algorithm and contact manifold
+	// The next calculateOverlappingPairs() then adds all overlapping pairs again in sorted order,
+	//	so the pair cache and manifolds no longer depend on the broadphase's history
+	for (auto& pair : activePairs)
+		m_pairCache->removeOverlappingPair(pair.first, pair.second, dispatcher);
+	activePairs.clear();
 }
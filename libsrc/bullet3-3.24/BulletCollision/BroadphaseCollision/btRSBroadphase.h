@@ -1,7 +1,14 @@
 #pragma once
 
 #include "btOverlappingPairCache.h"
+#include "../../LinearMath/btHashMap.h"
 #include <vector>
+#include <memory>
+
+// ROCKETSIM CHANGE: Exported from the library (RS_API), so that the broadphase can be tested directly
+#include <RocketSim/Framework.h>
+
+class btCollisionShape;
 
 struct btRSBroadphaseProxy : public btBroadphaseProxy
 {
@@ -30,10 +37,108 @@ struct btRSBroadphaseProxy : public btBroadphaseProxy
 	SIMD_FORCE_INLINE int GetNextFree() const { return m_nextFree; }
 };
 
+// Lists of handle indices for each cell of a btRSBroadphase, stored flat
+// Every cell has a small inline capacity, longer lists are moved to a block in a shared overflow pool
+// Removing swaps the last entry in, so entries of a cell are unordered
+// In sparse mode, only non-empty cells get a slot (found through a hash map), so memory scales with the occupied cells instead of all cells
+struct RS_API btRSBroadphaseCellLists {
+	enum { INLINE_CAPACITY = 4 };
+
+	struct Span {
+		const int* first;
+		const int* last;
+
+		const int* begin() const { return first; }
+		const int* end() const { return last; }
+		int size() const { return int(last - first); }
+	};
+
+	bool sparse;
+
+	// Slots of non-empty cells, if sparse (otherwise the slot is the cell index)
+	btHashMap<btHashInt, int> slotOfCell;
+	std::vector<int> freeSlots;
+
+	// Per slot
+	std::vector<int> counts;
+	std::vector<int> inlineEntries; // INLINE_CAPACITY per slot
+
+	// Offset of each slot's block in overflowPool (-1 if the slot is stored inline), and the block's capacity class
+	std::vector<int> overflowOffsets;
+	std::vector<unsigned char> overflowClasses;
+
+	std::vector<int> overflowPool;
+	std::vector<std::vector<int>> freeBlocks; // Offsets of unused blocks in overflowPool, per capacity class
+
+	btRSBroadphaseCellLists(int numCells = 0, bool sparse = false) : sparse(sparse) {
+		if (!sparse)
+			resizeSlots(numCells);
+	}
+
+	int getSlot(int cellIdx) const {
+		if (!sparse)
+			return cellIdx;
+
+		const int* slot = slotOfCell.find(cellIdx);
+		return slot ? *slot : -1;
+	}
+
+	// Entries of a cell, invalidated by the next add() or remove()
+	Span operator[](int cellIdx) const {
+		int slot = getSlot(cellIdx);
+		if (slot < 0)
+			return { NULL, NULL };
+
+		int offset = overflowOffsets[slot];
+		const int* first = (offset < 0) ? &inlineEntries[slot * INLINE_CAPACITY] : &overflowPool[offset];
+		return { first, first + counts[slot] };
+	}
+
+	bool contains(int cellIdx, int value) const;
+	void add(int cellIdx, int value);
+	void remove(int cellIdx, int value); // Does nothing if the cell doesn't have the value
+
+	// Number of cells that have storage
+	int getNumSlots() const {
+		return (int)counts.size() - (int)freeSlots.size();
+	}
+
+	static int getBlockCapacity(int capacityClass) {
+		return INLINE_CAPACITY << (capacityClass + 1);
+	}
+
+private:
+	void resizeSlots(int numSlots);
+	int allocBlock(int capacityClass);
+};
+
+// Static proxies of each cell of a btRSBroadphase
+// Proxies are stored as handle indices, so that the grid can be shared (copy-on-write) between broadphases that create the same static objects in the same order
+// (Building the grid is expensive, as every cell has to be tested against every static triangle mesh)
+struct btRSBroadphaseStaticGrid {
+	// How a static proxy was added to the grid
+	struct Entry {
+		bool valid = false;
+		int iMin, jMin, kMin;
+		int iMax, jMax, kMax;
+		const btCollisionShape* triMeshShape; // Cells are filtered by triangles for triangle meshes, NULL otherwise
+	};
+
+	btRSBroadphaseCellLists cellHandles;
+	std::vector<Entry> entries; // Indexed by handle index, only grown up to the highest handle index that was added
+
+	btRSBroadphaseStaticGrid(int totalCells, bool sparse) : cellHandles(totalCells, sparse) {}
+
+	// Invalid if the handle isn't in the grid
+	Entry getEntry(int handleIdx) const {
+		return (handleIdx < (int)entries.size()) ? entries[handleIdx] : Entry();
+	}
+};
+
 // Custom broadphase implementation for RocketSim
 // Uses spacial division with a fixed voxel grid
 // Somewhat based off of btSimpleBroadphase
-class btRSBroadphase : public btBroadphaseInterface
+class RS_API btRSBroadphase : public btBroadphaseInterface
 {
 public:
 	int m_numHandles;  // number of active handles
@@ -51,40 +156,40 @@ public:
 	int totalRealPairs = 0;
 	int totalItrs = 0;
 
-	std::vector<std::pair<btRSBroadphaseProxy*, btRSBroadphaseProxy*>> activePairs;
+	typedef std::pair<btRSBroadphaseProxy*, btRSBroadphaseProxy*> ProxyPair;
 
-	struct Cell {
-		constexpr static int RESERVED_SIZE = 4;
-		std::vector<btRSBroadphaseProxy*> dynHandles;
-		std::vector<btRSBroadphaseProxy*> staticHandles;
-		Cell() {
-			dynHandles.reserve(RESERVED_SIZE);
-			staticHandles.reserve(RESERVED_SIZE);
-		}
+	// Pairs currently in the pair cache, sorted (first < second)
+	std::vector<ProxyPair> activePairs;
+	std::vector<ProxyPair> newActivePairs; // Scratch for calculateOverlappingPairs()
 
-		void RemoveDyn(btRSBroadphaseProxy* proxy) {
-			for (int i = 0; i < dynHandles.size(); i++) {
-				if (dynHandles[i] == proxy) {
-					dynHandles.erase(dynHandles.begin() + i);
-					return;
-				}
-			}
-		}
+	// Pair changes from the last calculateOverlappingPairs()
+	int numPairsAdded = 0, numPairsRemoved = 0, numPairsPersisted = 0;
 
-		void RemoveStatic(btRSBroadphaseProxy* proxy) {
-			for (int i = 0; i < staticHandles.size(); i++) {
-				if (staticHandles[i] == proxy) {
-					staticHandles.erase(staticHandles.begin() + i);
-					return;
-				}
-			}
-		}
-	};
-	std::vector<Cell> cells;
+	// Handle indices of the dynamic proxies of each cell
+	btRSBroadphaseCellLists dynCells;
 
-	Cell& GetCell(int i, int j, int k) {
-		int idx = i * cellsY * cellsZ + j * cellsZ + k;
-		return cells[idx];
+	// NULL after releaseStaticGrid()
+	std::shared_ptr<btRSBroadphaseStaticGrid> staticGrid;
+
+	// Copies the static grid if it is shared, so that it can be modified
+	void makeStaticGridUnique() {
+		if (staticGrid.use_count() > 1)
+			staticGrid = std::make_shared<btRSBroadphaseStaticGrid>(*staticGrid);
+	}
+
+	// Share the static grid of another broadphase with the same bounds and cell size
+	// Must be called before any static proxies are created
+	// Static proxies that are then created with the same handle index, cell range, and triangle mesh as in the other broadphase will not have to be added to the grid
+	// Returns false if the grids are incompatible
+	bool shareStaticGrid(const btRSBroadphase& other);
+
+	// Drop the static grid before destroying all proxies, so that static proxies don't have to be removed from each cell
+	void releaseStaticGrid() {
+		staticGrid = NULL;
+	}
+
+	int GetCellIdx(int i, int j, int k) const {
+		return i * cellsY * cellsZ + j * cellsZ + k;
 	}
 
 	void GetCellIndices(btVector3 pos, int& i, int& j, int& k) const {
@@ -159,7 +264,8 @@ public:
 
 protected:
 public:
-	btRSBroadphase(btVector3 min, btVector3 max, float cellSize, btOverlappingPairCache* overlappingPairCache, int maxProxies = 65536);
+	// If sparseGrid, only occupied cells are stored (see btRSBroadphaseCellLists), for giant worlds
+	btRSBroadphase(btVector3 min, btVector3 max, float cellSize, btOverlappingPairCache* overlappingPairCache, int maxProxies = 65536, bool sparseGrid = false);
 	virtual ~btRSBroadphase();
 
 	static bool aabbOverlap(btRSBroadphaseProxy* proxy0, btRSBroadphaseProxy* proxy1);
@@ -175,6 +281,10 @@ public:
 	virtual void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback, const btVector3& aabbMin = btVector3(0, 0, 0), const btVector3& aabbMax = btVector3(0, 0, 0));
 	virtual void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
 
+	// Writes the proxies whose AABB overlaps the given AABB into results (up to maxResults of them), without a callback object
+	// Returns the total amount of overlapping proxies, which can be more than maxResults
+	int aabbQuery(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseProxy** results, int maxResults);
+
 	btOverlappingPairCache* getOverlappingPairCache() {
 		return m_pairCache;
 	}
@@ -910,6 +910,12 @@ struct btSingleRayCallback : public btBroadphaseRayCallback
 		m_lambda_max = rayDir.dot(m_rayToWorld - m_rayFromWorld);
 	}
 
+	// ROCKETSIM CHANGE: Hits are only needed if they are closer than the closest one so far
+	virtual btScalar getMaxHitFraction() const
+	{
+		return m_resultCallback.m_closestHitFraction;
+	}
+
 	virtual bool process(const btBroadphaseProxy* proxy)
 	{
 		///terminate further ray tests, once the closestHitFraction reached zero
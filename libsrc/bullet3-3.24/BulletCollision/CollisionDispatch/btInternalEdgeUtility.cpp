@@ -349,6 +349,10 @@ void btGenerateInternalEdgeInfo(btBvhTriangleMeshShape* trimeshShape, btTriangle
 
 			trimeshShape->processAllTriangles(&connectivityProcessor, aabbMin, aabbMax);
 		}
+
+		// ROCKETSIM CHANGE: Store single-part meshes in a flat table as well, see btAdjustInternalEdgeContacts()
+		if (meshInterface->getNumSubParts() == 1)
+			triangleInfoMap->buildFlatTriangleInfos(numfaces);
 	}
 }
 
@@ -435,11 +439,22 @@ void btAdjustInternalEdgeContacts(btManifoldPoint& cp, const btCollisionObjectWr
 	if (!triangleInfoMapPtr)
 		return;
 
-	int hash = btGetHash(partId0, index0);
+	// ROCKETSIM CHANGE: Use the flat triangle info table when we can, so that this is a single indexed load
+	const btTriangleInfo* info;
+	if (partId0 == 0 && index0 < triangleInfoMapPtr->m_flatTriangleInfos.size())
+	{
+		info = &triangleInfoMapPtr->m_flatTriangleInfos[index0];
+		if (info->m_flags & TRI_INFO_NOT_PRESENT)
+			return;
+	}
+	else
+	{
+		int hash = btGetHash(partId0, index0);
 
-	btTriangleInfo* info = triangleInfoMapPtr->find(hash);
-	if (!info)
-		return;
+		info = triangleInfoMapPtr->find(hash);
+		if (!info)
+			return;
+	}
 
 	btScalar frontFacing = (normalAdjustFlags & BT_TRIANGLE_CONVEX_BACKFACE_MODE) == 0 ? 1.f : -1.f;
 
@@ -17,6 +17,7 @@ subject to the following restrictions:
 #define _BT_TRIANGLE_INFO_MAP_H
 
 #include "../../LinearMath/btHashMap.h"
+#include "../../LinearMath/btAlignedObjectArray.h"
 
 ///for btTriangleInfo m_flags
 #define TRI_INFO_V0V1_CONVEX 1
@@ -27,6 +28,9 @@ subject to the following restrictions:
 #define TRI_INFO_V1V2_SWAP_NORMALB 16
 #define TRI_INFO_V2V0_SWAP_NORMALB 32
 
+// ROCKETSIM CHANGE: Marks an entry of the flat triangle info table that has no info in the map
+#define TRI_INFO_NOT_PRESENT 64
+
 ///The btTriangleInfo structure stores information to adjust collision normals to avoid collisions against internal edges
 ///it can be generated using
 struct btTriangleInfo
@@ -58,6 +62,12 @@ struct btTriangleInfoMap : public btInternalTriangleInfoMap
 	btScalar m_maxEdgeAngleThreshold;  //ignore edges that connect triangles at an angle larger than this m_maxEdgeAngleThreshold
 	btScalar m_zeroAreaThreshold;      ///used to determine if a triangle is degenerate (length squared of cross product of 2 triangle edges < threshold)
 
+	// ROCKETSIM CHANGE: Flat copy of the map for single-part meshes, indexed by triangle index
+	// Built by btGenerateInternalEdgeInfo() so that contact lookups don't need to hash
+	// Entries without info in the map have the TRI_INFO_NOT_PRESENT flag
+	// NOTE: Changes made to the map afterwards are not reflected here, call buildFlatTriangleInfos() again
+	btAlignedObjectArray<btTriangleInfo> m_flatTriangleInfos;
+
 	btTriangleInfoMap()
 	{
 		m_convexEpsilon = 0.00f;
@@ -68,6 +78,21 @@ struct btTriangleInfoMap : public btInternalTriangleInfoMap
 		m_maxEdgeAngleThreshold = SIMD_2_PI;
 	}
 	virtual ~btTriangleInfoMap() {}
+
+	// ROCKETSIM CHANGE: (Re)builds m_flatTriangleInfos from the map, for part 0 only
+	void buildFlatTriangleInfos(int numTriangles)
+	{
+		btTriangleInfo notPresentInfo;
+		notPresentInfo.m_flags = TRI_INFO_NOT_PRESENT;
+
+		m_flatTriangleInfos.resize(numTriangles, notPresentInfo);
+		for (int i = 0; i < numTriangles; i++)
+		{
+			// Hash keys of part 0 are just the triangle index
+			const btTriangleInfo* info = find(i);
+			m_flatTriangleInfos[i] = info ? *info : notPresentInfo;
+		}
+	}
 };
 
 #endif
\ No newline at end of file
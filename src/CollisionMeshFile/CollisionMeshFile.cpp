@@ -37,7 +37,7 @@ void CollisionMeshFile::ReadFromStream(DataStreamIn& in, bool silent, std::strin
 	if (in.IsOverflown()) {
 		RS_ERR_CLOSE(
 			ERROR_PREFIX_STR << "Invalid collision mesh file at \"" << filePath <<
-			"\" (input data overflown by " << (in.pos - in.data.size()) << " bytes!)");
+			"\" (input data overflown by " << (in.pos - in.GetSize()) << " bytes!)");
 	}
 
 	// Verify that the triangle data is correct
@@ -97,4 +97,75 @@ void CollisionMeshFile::UpdateHash() {
 	this->hash = hash;
 }
 
+// Spreads the lower 10 bits of v so that there are 2 zero bits between each bit
+static uint32_t SpreadMortonBits(uint32_t v) {
+	v &= 0x3FF;
+	v = (v | (v << 16)) & 0x030000FF;
+	v = (v | (v << 8)) & 0x0300F00F;
+	v = (v | (v << 4)) & 0x030C30C3;
+	v = (v | (v << 2)) & 0x09249249;
+	return v;
+}
+
+void CollisionMeshFile::SortForLocality() {
+	if (tris.empty() || vertices.empty())
+		return;
+
+	Vertex boundsMin = vertices[0], boundsMax = vertices[0];
+	for (Vertex& vert : vertices) {
+		for (int i = 0; i < 3; i++) {
+			boundsMin[i] = RS_MIN(boundsMin[i], vert[i]);
+			boundsMax[i] = RS_MAX(boundsMax[i], vert[i]);
+		}
+	}
+
+	// Morton code of each triangle's center, paired with its original index so the sort is deterministic
+	constexpr float MORTON_CELLS_PER_AXIS = 1024;
+	std::vector<std::pair<uint32_t, int>> triOrder;
+	triOrder.reserve(tris.size());
+	for (int triIdx = 0; triIdx < (int)tris.size(); triIdx++) {
+		uint32_t code = 0;
+		for (int i = 0; i < 3; i++) {
+			float center = 0;
+			for (int j = 0; j < 3; j++)
+				center += vertices[tris[triIdx].vertexIndexes[j]][i];
+			center /= 3;
+
+			float range = boundsMax[i] - boundsMin[i];
+			float ratio = (range > 0) ? (center - boundsMin[i]) / range : 0;
+			uint32_t cell = (uint32_t)RS_CLAMP(ratio * MORTON_CELLS_PER_AXIS, 0, MORTON_CELLS_PER_AXIS - 1);
+			code |= SpreadMortonBits(cell) << i;
+		}
+		triOrder.push_back({ code, triIdx });
+	}
+	std::sort(triOrder.begin(), triOrder.end());
+
+	// Number vertices in the order they are first used by the sorted triangles
+	std::vector<int> vertRemap(vertices.size(), -1);
+	std::vector<Vertex> sortedVertices;
+	sortedVertices.reserve(vertices.size());
+	std::vector<Triangle> sortedTris;
+	sortedTris.reserve(tris.size());
+	for (auto& pair : triOrder) {
+		Triangle tri = tris[pair.second];
+		for (int& vertIndex : tri.vertexIndexes) {
+			int& newIndex = vertRemap[vertIndex];
+			if (newIndex == -1) {
+				newIndex = sortedVertices.size();
+				sortedVertices.push_back(vertices[vertIndex]);
+			}
+			vertIndex = newIndex;
+		}
+		sortedTris.push_back(tri);
+	}
+
+	// Keep unused vertices too, so the vertex count doesn't change
+	for (size_t i = 0; i < vertices.size(); i++)
+		if (vertRemap[i] == -1)
+			sortedVertices.push_back(vertices[i]);
+
+	tris = std::move(sortedTris);
+	vertices = std::move(sortedVertices);
+}
+
 RS_NS_END
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <RocketSim/DataStream/DataStreamOut.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+RS_NS_START
+
+DataStreamOut DataStreamOut::ToFile(std::filesystem::path filePath, bool writeVersionCheck, size_t bufferCapacity) {
+	auto fileStream = std::make_shared<std::ofstream>(filePath, std::ios::binary);
+	if (!fileStream->good())
+		RS_ERR_CLOSE("Failed to write to file " << filePath << ", cannot open file.");
+
+	DataStreamSinkFn sink = [fileStream, filePath](const byte* data, size_t size) {
+		fileStream->write((const char*)data, size);
+		fileStream->flush();
+		if (!fileStream->good())
+			RS_ERR_CLOSE("DataStreamOut: Failed to write to file " << filePath << " (is the disk full?)");
+	};
+	return DataStreamOut(sink, writeVersionCheck, bufferCapacity);
+}
+
+DataStreamOut DataStreamOut::ToFileDescriptor(int fileDescriptor, bool writeVersionCheck, size_t bufferCapacity) {
+	DataStreamSinkFn sink = [fileDescriptor](const byte* data, size_t size) {
+		while (size > 0) {
+#ifdef _WIN32
+			int written = _write(fileDescriptor, data, (unsigned int)RS_MIN(size, (size_t)INT_MAX));
+#else
+			ssize_t written = write(fileDescriptor, data, size);
+#endif
+			if (written <= 0)
+				RS_ERR_CLOSE("DataStreamOut: Failed to write to file descriptor " << fileDescriptor);
+
+			data += written;
+			size -= written;
+		}
+	};
+	return DataStreamOut(sink, writeVersionCheck, bufferCapacity);
+}
+
+RS_NS_END
@@ -0,0 +1,122 @@
+#include <RocketSim/DataStream/MappedFile.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+RS_NS_START
+
+MappedFile::MappedFile(std::filesystem::path filePath) {
+	constexpr char ERROR_PREFIX[] = "MappedFile: ";
+
+#ifdef _WIN32
+	_fileHandle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (_fileHandle == INVALID_HANDLE_VALUE) {
+		_fileHandle = NULL;
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to read file " << filePath << ", cannot open file.");
+	}
+
+	_isOpen = true;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(_fileHandle, &fileSize)) {
+		Close();
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to read file " << filePath << ", cannot get file size.");
+	}
+	_size = fileSize.QuadPart;
+
+	if (_size > 0) {
+		_mappingHandle = CreateFileMappingW(_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (_mappingHandle)
+			_data = (const byte*)MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+		if (!_data) {
+			Close();
+			RS_ERR_CLOSE(ERROR_PREFIX << "Failed to map file " << filePath << ".");
+		}
+	}
+#else
+	_fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if (_fileDescriptor == -1)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to read file " << filePath << ", cannot open file.");
+
+	_isOpen = true;
+
+	struct stat fileStat;
+	if (fstat(_fileDescriptor, &fileStat) != 0) {
+		Close();
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to read file " << filePath << ", cannot get file size.");
+	}
+	_size = fileStat.st_size;
+
+	if (_size > 0) {
+		void* mapping = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+		if (mapping == MAP_FAILED) {
+			Close();
+			RS_ERR_CLOSE(ERROR_PREFIX << "Failed to map file " << filePath << ".");
+		}
+		_data = (const byte*)mapping;
+	}
+#endif
+}
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		Close();
+
+		_isOpen = other._isOpen;
+		_data = other._data;
+		_size = other._size;
+#ifdef _WIN32
+		_fileHandle = other._fileHandle;
+		_mappingHandle = other._mappingHandle;
+		other._fileHandle = other._mappingHandle = NULL;
+#else
+		_fileDescriptor = other._fileDescriptor;
+		other._fileDescriptor = -1;
+#endif
+		other._isOpen = false;
+		other._data = NULL;
+		other._size = 0;
+	}
+	return *this;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (_data)
+		UnmapViewOfFile(_data);
+	if (_mappingHandle)
+		CloseHandle(_mappingHandle);
+	if (_fileHandle)
+		CloseHandle(_fileHandle);
+	_fileHandle = _mappingHandle = NULL;
+#else
+	if (_data)
+		munmap((void*)_data, _size);
+	if (_fileDescriptor != -1)
+		close(_fileDescriptor);
+	_fileDescriptor = -1;
+#endif
+
+	_isOpen = false;
+	_data = NULL;
+	_size = 0;
+}
+
+RS_NS_END
@@ -0,0 +1,384 @@
+#include <RocketSim/Recording/Replay/Replay.h>
+
+RS_NS_START
+
+using namespace Replay;
+
+// Snapshots are written from std::vector<byte> buffers
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= ArenaSnapshotHeader::SECTION_ALIGNMENT);
+
+static size_t AlignChunkSize(size_t size) {
+	return (size + CHUNK_ALIGNMENT - 1) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+}
+
+// FNV-1a
+struct StateHasher {
+	uint64_t hash = 0xCBF29CE484222325;
+
+	void AddBytes(const void* data, size_t size) {
+		for (size_t i = 0; i < size; i++) {
+			hash ^= ((const byte*)data)[i];
+			hash *= 0x100000001B3;
+		}
+	}
+
+	void Add(float val) { AddBytes(&val, sizeof(val)); }
+	void Add(bool val) { AddBytes(&val, sizeof(val)); }
+	void Add(Vec vec) { Add(vec.x); Add(vec.y); Add(vec.z); }
+	void Add(const RotMat& rotMat) { Add(rotMat.forward); Add(rotMat.right); Add(rotMat.up); }
+
+	void Add(const PhysState& physState) {
+		Add(physState.pos);
+		Add(physState.rotMat);
+		Add(physState.vel);
+		Add(physState.angVel);
+	}
+};
+
+uint64_t Replay::HashArenaState(const Arena* arena) {
+	// Car hashes are summed, so that the order of the cars doesn't matter
+	uint64_t carsHash = 0;
+	for (Car* car : arena->_cars) {
+		CarState carState = car->GetState();
+
+		StateHasher carHasher = {};
+		carHasher.AddBytes(&car->id, sizeof(car->id));
+		carHasher.Add(carState);
+		carHasher.Add(carState.boost);
+		carHasher.Add(carState.isOnGround);
+		carHasher.Add(carState.isDemoed);
+		carHasher.Add(carState.demoRespawnTimer);
+		carsHash += carHasher.hash;
+	}
+
+	StateHasher hasher = {};
+	hasher.AddBytes(&carsHash, sizeof(carsHash));
+	hasher.Add(arena->ball->GetState());
+
+	for (BoostPad* pad : arena->_boostPads) {
+		BoostPadState padState = pad->GetState();
+		hasher.Add(padState.isActive);
+		hasher.Add(padState.cooldown);
+	}
+
+	return hasher.hash;
+}
+
+ReplayWriter::ReplayWriter(std::filesystem::path filePath, int keyframeInterval) : _filePath(filePath), _keyframeInterval(RS_MAX(keyframeInterval, 1)) {
+	constexpr size_t FILE_BUFFER_SIZE = 1024 * 1024;
+	_fileStreamBuffer.resize(FILE_BUFFER_SIZE);
+	_fileStream.rdbuf()->pubsetbuf(_fileStreamBuffer.data(), _fileStreamBuffer.size());
+
+	_fileStream.open(filePath, std::ios::binary);
+	if (!_fileStream.good())
+		RS_ERR_CLOSE("ReplayWriter: Failed to write to file " << filePath << ", cannot open file.");
+
+	FileHeader header = {};
+	header.magic = MAGIC;
+	header.formatVersion = FORMAT_VERSION;
+	header.rocketSimVersion = RS_VERSION_ID;
+	header.keyframeInterval = _keyframeInterval;
+
+	static_assert(sizeof(FileHeader) % CHUNK_ALIGNMENT == 0);
+	_fileStream.write((const char*)&header, sizeof(header));
+	_filePos += sizeof(header);
+	_CheckStream();
+}
+
+ReplayWriter::~ReplayWriter() {
+	if (_finished)
+		return;
+
+	// Can't throw from here, so only warn
+	try {
+		Finish();
+	} catch (std::exception&) {
+		RS_WARN("ReplayWriter: Failed to finish file " << _filePath << ", the replay is incomplete.");
+	}
+}
+
+void ReplayWriter::_CheckStream() {
+	if (!_fileStream.good())
+		RS_ERR_CLOSE("ReplayWriter: Failed to write to file " << _filePath << " (is the disk full?), the replay is incomplete.");
+}
+
+void ReplayWriter::_WriteChunk(ChunkType type, uint64_t tickCount, const void* payloadHeader, size_t payloadHeaderSize, const void* payload, size_t payloadSize) {
+	ChunkHeader chunkHeader = {};
+	chunkHeader.type = type;
+	chunkHeader.payloadSize = payloadHeaderSize + payloadSize;
+	chunkHeader.tickCount = tickCount;
+
+	_fileStream.write((const char*)&chunkHeader, sizeof(chunkHeader));
+	_fileStream.write((const char*)payloadHeader, payloadHeaderSize);
+	_fileStream.write((const char*)payload, payloadSize);
+	payloadSize += payloadHeaderSize;
+
+	constexpr byte ZERO_PADDING[CHUNK_ALIGNMENT] = {};
+	size_t paddedSize = AlignChunkSize(payloadSize);
+	_fileStream.write((const char*)ZERO_PADDING, paddedSize - payloadSize);
+	_CheckStream();
+
+	_filePos += sizeof(chunkHeader) + paddedSize;
+}
+
+void ReplayWriter::RecordTick(Arena* arena) {
+	constexpr char ERROR_PREFIX[] = "ReplayWriter::RecordTick(): ";
+
+	if (_finished)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Cannot record after Finish() was called");
+
+	uint64_t tickCount = arena->tickCount;
+	if (!_keyframes.empty() && tickCount != _endTick)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Ticks must be recorded consecutively (expected tick " << _endTick << ", got " << tickCount << ")");
+
+	// Gather controls (in ID order, so that we can easily tell if the cars changed)
+	_controlsBuffer.clear();
+	for (Car* car : arena->_cars)
+		_controlsBuffer.push_back({ car->id, car->controls });
+	std::sort(_controlsBuffer.begin(), _controlsBuffer.end(),
+		[](const CarControlsEntry& a, const CarControlsEntry& b) { return a.carID < b.carID; }
+	);
+
+	if (_keyframes.empty()) {
+		for (auto& entry : _controlsBuffer)
+			_carIDs.push_back(entry.carID);
+	} else {
+		bool carsChanged = _controlsBuffer.size() != _carIDs.size();
+		for (size_t i = 0; i < _controlsBuffer.size() && !carsChanged; i++)
+			carsChanged = _controlsBuffer[i].carID != _carIDs[i];
+
+		if (carsChanged)
+			RS_ERR_CLOSE(ERROR_PREFIX << "Cars were added or removed since the first recorded tick, which replays can't play back");
+	}
+
+	if (_keyframes.empty() || tickCount - _keyframes.back().tickCount >= (uint64_t)_keyframeInterval) {
+		_snapshotBuffer.resize(arena->GetSnapshotSize());
+		arena->WriteSnapshot(_snapshotBuffer.data(), _snapshotBuffer.size());
+
+		_keyframes.push_back({ tickCount, _filePos });
+		_WriteChunk(ChunkType::KEYFRAME, tickCount, NULL, 0, _snapshotBuffer.data(), _snapshotBuffer.size());
+
+		// Continue from the keyframe exactly like the player does
+		arena->ApplySnapshot(ArenaSnapshotView::FromBuffer(_snapshotBuffer.data(), _snapshotBuffer.size()));
+	}
+
+	ControlsHeader controlsHeader = {};
+	controlsHeader.stateHash = HashArenaState(arena);
+	_WriteChunk(ChunkType::CONTROLS, tickCount, &controlsHeader, sizeof(controlsHeader), _controlsBuffer.data(), _controlsBuffer.size() * sizeof(CarControlsEntry));
+
+	if (_keyframes.size() == 1 && _keyframes[0].tickCount == tickCount)
+		_firstTick = tickCount;
+	_endTick = tickCount + 1;
+}
+
+void ReplayWriter::Finish() {
+	if (_finished)
+		return;
+
+	Footer footer = {};
+	footer.indexOffset = _filePos;
+	footer.numKeyframes = _keyframes.size();
+	footer.firstTick = _firstTick;
+	footer.endTick = _endTick;
+	footer.magic = MAGIC;
+
+	if (!_keyframes.empty())
+		_fileStream.write((const char*)_keyframes.data(), _keyframes.size() * sizeof(KeyframeIndexEntry));
+	_fileStream.write((const char*)&footer, sizeof(footer));
+	_fileStream.close();
+
+	_finished = true;
+	_CheckStream();
+}
+
+//////////////////////////////////////////////////
+
+ReplayPlayer::ReplayPlayer(std::filesystem::path filePath) : _file(filePath) {
+	constexpr char ERROR_PREFIX[] = "ReplayPlayer: ";
+
+	const byte* data = _file.GetData();
+	size_t size = _file.GetSize();
+
+	if (size < sizeof(FileHeader) + sizeof(Footer))
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " is too small to be a replay.");
+
+	const FileHeader* header = (const FileHeader*)data;
+	if (header->magic != MAGIC)
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " is not a replay.");
+
+	if (header->formatVersion != FORMAT_VERSION || header->rocketSimVersion != RS_VERSION_ID)
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " was written by a different version of RocketSim.");
+
+	memcpy(&_footer, data + size - sizeof(Footer), sizeof(Footer));
+	if (_footer.magic != MAGIC)
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " has no keyframe index, it was not finished.");
+
+	// The index must end at the footer (checked without overflowing for huge amounts of keyframes)
+	uint64_t indexEnd = size - sizeof(Footer);
+	uint64_t maxKeyframes = (indexEnd - sizeof(FileHeader)) / sizeof(KeyframeIndexEntry);
+	if (
+		_footer.numKeyframes == 0 || _footer.numKeyframes > maxKeyframes ||
+		_footer.indexOffset != indexEnd - _footer.numKeyframes * sizeof(KeyframeIndexEntry) ||
+		_footer.indexOffset % CHUNK_ALIGNMENT != 0 || _footer.firstTick > _footer.endTick
+		)
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " has an invalid keyframe index.");
+
+	_keyframes = (const KeyframeIndexEntry*)(data + _footer.indexOffset);
+
+	for (size_t i = 0; i < _footer.numKeyframes; i++) {
+		const KeyframeIndexEntry& entry = _keyframes[i];
+		bool valid =
+			entry.chunkOffset >= sizeof(FileHeader) && entry.chunkOffset % CHUNK_ALIGNMENT == 0 &&
+			entry.chunkOffset <= _footer.indexOffset - sizeof(ChunkHeader) &&
+			(i == 0 ? entry.tickCount == _footer.firstTick : entry.tickCount > _keyframes[i - 1].tickCount);
+
+		if (valid) {
+			const ChunkHeader* chunk = _GetKeyframeChunk(i);
+			valid = chunk->type == ChunkType::KEYFRAME && chunk->tickCount == entry.tickCount;
+			if (valid)
+				_CheckChunk(chunk);
+		}
+
+		if (!valid)
+			RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " has an invalid keyframe index entry (keyframe " << i << ").");
+	}
+}
+
+size_t ReplayPlayer::_FindKeyframe(uint64_t tickCount) const {
+	auto itr = std::upper_bound(_keyframes, _keyframes + _footer.numKeyframes, tickCount,
+		[](uint64_t tickCount, const KeyframeIndexEntry& entry) { return tickCount < entry.tickCount; }
+	);
+
+	// Seek() makes sure tickCount >= the first keyframe's tick
+	return RS_MAX(itr - _keyframes, 1) - 1;
+}
+
+const ChunkHeader* ReplayPlayer::_GetKeyframeChunk(size_t keyframeIndex) const {
+	return (const ChunkHeader*)(_file.GetData() + _keyframes[keyframeIndex].chunkOffset);
+}
+
+const ChunkHeader* ReplayPlayer::_GetNextChunk(const ChunkHeader* chunk) const {
+	size_t nextOffset = ((const byte*)chunk - _file.GetData()) + sizeof(ChunkHeader) + AlignChunkSize(chunk->payloadSize);
+	if (nextOffset + sizeof(ChunkHeader) > _footer.indexOffset)
+		return NULL;
+
+	const ChunkHeader* nextChunk = (const ChunkHeader*)(_file.GetData() + nextOffset);
+	_CheckChunk(nextChunk);
+	return nextChunk;
+}
+
+void ReplayPlayer::_CheckChunk(const ChunkHeader* chunk) const {
+	// Chunk offsets are aligned and before the index, which is aligned, so the padded payload also fits if the payload does
+	size_t maxPayloadSize = _footer.indexOffset - ((const byte*)chunk - _file.GetData()) - sizeof(ChunkHeader);
+
+	bool valid;
+	switch (chunk->type) {
+	case ChunkType::CONTROLS:
+		valid =
+			chunk->payloadSize >= sizeof(ControlsHeader) &&
+			(chunk->payloadSize - sizeof(ControlsHeader)) % sizeof(CarControlsEntry) == 0;
+		break;
+	case ChunkType::KEYFRAME:
+		valid = true; // Checked by ArenaSnapshotView::FromBuffer()
+		break;
+	default:
+		valid = false;
+	}
+
+	if (!valid || chunk->payloadSize > maxPayloadSize)
+		RS_ERR_CLOSE("ReplayPlayer: Replay has an invalid chunk for tick " << chunk->tickCount << ", the file is corrupted.");
+}
+
+const ChunkHeader* ReplayPlayer::_FindControlsChunk(uint64_t tickCount) {
+	const ChunkHeader* chunk;
+	if (_lastControlsChunk && _lastControlsChunk->tickCount <= tickCount) {
+		chunk = _lastControlsChunk;
+	} else {
+		chunk = _GetKeyframeChunk(_FindKeyframe(tickCount));
+	}
+
+	while (chunk && !(chunk->type == ChunkType::CONTROLS && chunk->tickCount == tickCount)) {
+		if (chunk->tickCount > tickCount)
+			return NULL;
+
+		chunk = _GetNextChunk(chunk);
+	}
+
+	_lastControlsChunk = chunk;
+	return chunk;
+}
+
+void ReplayPlayer::_ApplyControls(Arena* arena, const ChunkHeader* controlsChunk) {
+	const CarControlsEntry* entries = (const CarControlsEntry*)((const ControlsHeader*)(controlsChunk + 1) + 1);
+	size_t numEntries = (controlsChunk->payloadSize - sizeof(ControlsHeader)) / sizeof(CarControlsEntry);
+
+	for (size_t i = 0; i < numEntries; i++) {
+		auto itr = arena->_carIDMap.find(entries[i].carID);
+		if (itr != arena->_carIDMap.end())
+			itr->second->controls = entries[i].controls;
+	}
+}
+
+void ReplayPlayer::_ApplyKeyframe(Arena* arena, const ChunkHeader* keyframeChunk) {
+	arena->ApplySnapshot(ArenaSnapshotView::FromBuffer(keyframeChunk + 1, keyframeChunk->payloadSize));
+}
+
+void ReplayPlayer::Seek(Arena* arena, uint64_t tickCount) {
+	constexpr char ERROR_PREFIX[] = "ReplayPlayer::Seek(): ";
+
+	if (tickCount < GetFirstTick() || tickCount > GetEndTick())
+		RS_ERR_CLOSE(ERROR_PREFIX << "Tick " << tickCount << " is outside of the replay (" << GetFirstTick() << "-" << GetEndTick() << ")");
+
+	const ChunkHeader* keyframeChunk = _GetKeyframeChunk(_FindKeyframe(tickCount));
+	_ApplyKeyframe(arena, keyframeChunk);
+	_lastControlsChunk = keyframeChunk;
+	_VerifyState(arena);
+
+	while (arena->tickCount < tickCount)
+		StepForward(arena);
+}
+
+bool ReplayPlayer::StepForward(Arena* arena) {
+	if (arena->tickCount < GetFirstTick() || arena->tickCount >= GetEndTick())
+		return false;
+
+	const ChunkHeader* controlsChunk = _FindControlsChunk(arena->tickCount);
+	if (!controlsChunk)
+		RS_ERR_CLOSE("ReplayPlayer::StepForward(): Replay has no controls for tick " << arena->tickCount);
+
+	_ApplyControls(arena, controlsChunk);
+	arena->Step(1);
+	_VerifyState(arena);
+
+	// The writer applied this keyframe to the recorded arena, so we have to as well
+	// (after verifying, so that a mismatch isn't hidden by it)
+	const ChunkHeader* nextChunk = _GetNextChunk(controlsChunk);
+	if (nextChunk && nextChunk->type == ChunkType::KEYFRAME && nextChunk->tickCount == arena->tickCount)
+		_ApplyKeyframe(arena, nextChunk);
+
+	return true;
+}
+
+void ReplayPlayer::_VerifyState(const Arena* arena) {
+	if (!verifyStates || arena->tickCount >= GetEndTick())
+		return;
+
+	const ChunkHeader* controlsChunk = _FindControlsChunk(arena->tickCount);
+	if (!controlsChunk)
+		return;
+
+	const ControlsHeader* controlsHeader = (const ControlsHeader*)(controlsChunk + 1);
+	if (HashArenaState(arena) == controlsHeader->stateHash)
+		return;
+
+	if (_numMismatchedTicks == 0) {
+		_firstMismatchedTick = arena->tickCount;
+		RS_WARN(
+			"ReplayPlayer: Re-simulated tick " << arena->tickCount << " does not match the recording, " <<
+			"later mismatches are only counted (see GetNumMismatchedTicks())"
+		);
+	}
+	_numMismatchedTicks++;
+}
+
+RS_NS_END
@@ -0,0 +1,230 @@
+#include <RocketSim/Recording/StateRecorder/StateRecorder.h>
+
+RS_NS_START
+
+// Snapshots are read in place from std::vector<byte> buffers
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= ArenaSnapshotHeader::SECTION_ALIGNMENT);
+
+// Maximum length of one run in a delta
+constexpr uint32_t MAX_DELTA_RUN_LEN = UINT16_MAX;
+
+void StateRecording::EncodeDelta(const byte* prevSnapshot, const byte* curSnapshot, size_t snapshotSize, std::vector<byte>& out) {
+	// Delta format: repeated [uint16 unchanged word count][uint16 changed word count][changed words XOR previous words]
+	assert(snapshotSize % sizeof(uint32_t) == 0);
+	size_t numWords = snapshotSize / sizeof(uint32_t);
+	const uint32_t* prevWords = (const uint32_t*)prevSnapshot;
+	const uint32_t* curWords = (const uint32_t*)curSnapshot;
+
+	size_t i = 0;
+	while (i < numWords) {
+		uint16_t numUnchanged = 0;
+		while (i < numWords && curWords[i] == prevWords[i] && numUnchanged < MAX_DELTA_RUN_LEN) {
+			numUnchanged++;
+			i++;
+		}
+
+		size_t changedStart = i;
+		uint16_t numChanged = 0;
+		while (i < numWords && curWords[i] != prevWords[i] && numChanged < MAX_DELTA_RUN_LEN) {
+			numChanged++;
+			i++;
+		}
+
+		size_t outPos = out.size();
+		out.resize(outPos + sizeof(uint16_t) * 2 + numChanged * sizeof(uint32_t));
+		byte* outBytes = out.data() + outPos;
+		memcpy(outBytes, &numUnchanged, sizeof(uint16_t));
+		memcpy(outBytes + sizeof(uint16_t), &numChanged, sizeof(uint16_t));
+		outBytes += sizeof(uint16_t) * 2;
+
+		for (size_t j = 0; j < numChanged; j++) {
+			uint32_t xorWord = curWords[changedStart + j] ^ prevWords[changedStart + j];
+			memcpy(outBytes + j * sizeof(uint32_t), &xorWord, sizeof(uint32_t));
+		}
+	}
+}
+
+bool StateRecording::ApplyDelta(byte* snapshot, size_t snapshotSize, const byte* delta, size_t deltaSize) {
+	size_t numWords = snapshotSize / sizeof(uint32_t);
+	uint32_t* words = (uint32_t*)snapshot;
+
+	size_t wordIdx = 0, deltaPos = 0;
+	while (deltaPos < deltaSize) {
+		if (deltaSize - deltaPos < sizeof(uint16_t) * 2)
+			return false;
+
+		uint16_t numUnchanged, numChanged;
+		memcpy(&numUnchanged, delta + deltaPos, sizeof(uint16_t));
+		memcpy(&numChanged, delta + deltaPos + sizeof(uint16_t), sizeof(uint16_t));
+		deltaPos += sizeof(uint16_t) * 2;
+
+		wordIdx += numUnchanged;
+		if (wordIdx + numChanged > numWords || deltaSize - deltaPos < numChanged * sizeof(uint32_t))
+			return false;
+
+		for (size_t j = 0; j < numChanged; j++) {
+			uint32_t xorWord;
+			memcpy(&xorWord, delta + deltaPos + j * sizeof(uint32_t), sizeof(uint32_t));
+			words[wordIdx + j] ^= xorWord;
+		}
+
+		wordIdx += numChanged;
+		deltaPos += numChanged * sizeof(uint32_t);
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////
+
+StateRecorder::StateRecorder(std::filesystem::path filePath, int keyframeInterval) : _filePath(filePath), _keyframeInterval(RS_MAX(keyframeInterval, 1)) {
+	// Large write buffer so that recording doesn't hit the file system every tick
+	constexpr size_t FILE_BUFFER_SIZE = 1024 * 1024;
+	_fileStreamBuffer.resize(FILE_BUFFER_SIZE);
+	_fileStream.rdbuf()->pubsetbuf(_fileStreamBuffer.data(), _fileStreamBuffer.size());
+
+	_fileStream.open(filePath, std::ios::binary);
+	if (!_fileStream.good())
+		RS_ERR_CLOSE("StateRecorder: Failed to write to file " << filePath << ", cannot open file.");
+
+	StateRecording::FileHeader header = {};
+	header.magic = StateRecording::MAGIC;
+	header.formatVersion = StateRecording::FORMAT_VERSION;
+	header.rocketSimVersion = RS_VERSION_ID;
+	header.keyframeInterval = _keyframeInterval;
+	_fileStream.write((const char*)&header, sizeof(header));
+	_numBytesWritten += sizeof(header);
+	_CheckStream();
+}
+
+StateRecorder::~StateRecorder() {
+	// Can't throw from here, so only warn
+	_fileStream.flush();
+	if (!_fileStream.good())
+		RS_WARN("StateRecorder: Failed to write to file " << _filePath << ", the recording is incomplete.");
+}
+
+void StateRecorder::Flush() {
+	_fileStream.flush();
+	_CheckStream();
+}
+
+void StateRecorder::_CheckStream() {
+	if (!_fileStream.good())
+		RS_ERR_CLOSE("StateRecorder: Failed to write to file " << _filePath << " (is the disk full?), the recording is incomplete.");
+}
+
+void StateRecorder::_WriteRecord(StateRecording::RecordType type, uint64_t tickCount, const byte* payload, size_t payloadSize) {
+	StateRecording::RecordHeader header = {};
+	header.type = type;
+	header.payloadSize = payloadSize;
+	header.tickCount = tickCount;
+
+	_fileStream.write((const char*)&header, sizeof(header));
+	_fileStream.write((const char*)payload, payloadSize);
+	_CheckStream();
+
+	_numBytesWritten += sizeof(header) + payloadSize;
+	_numRecords++;
+}
+
+void StateRecorder::Record(const Arena* arena) {
+	size_t snapshotSize = arena->GetSnapshotSize();
+	_curSnapshot.resize(snapshotSize);
+	arena->WriteSnapshot(_curSnapshot.data(), snapshotSize);
+
+	// Cars were added/removed if the size changed, in which case the previous snapshot is useless
+	bool isKeyframe = (_numRecords == 0) || (_ticksSinceKeyframe >= _keyframeInterval) || (_prevSnapshot.size() != snapshotSize);
+
+	if (isKeyframe) {
+		_WriteRecord(StateRecording::RecordType::KEYFRAME, arena->tickCount, _curSnapshot.data(), snapshotSize);
+		_ticksSinceKeyframe = 0;
+	} else {
+		_deltaBuffer.clear();
+		StateRecording::EncodeDelta(_prevSnapshot.data(), _curSnapshot.data(), snapshotSize, _deltaBuffer);
+		_WriteRecord(StateRecording::RecordType::DELTA, arena->tickCount, _deltaBuffer.data(), _deltaBuffer.size());
+	}
+	_ticksSinceKeyframe++;
+
+	std::swap(_prevSnapshot, _curSnapshot);
+}
+
+//////////////////////////////////////////////////
+
+StateRecordingReader::StateRecordingReader(std::filesystem::path filePath) : _dataStream(filePath, false, true) {
+	constexpr char ERROR_PREFIX[] = "StateRecordingReader: ";
+
+	StateRecording::FileHeader header = _dataStream.Read<StateRecording::FileHeader>();
+	if (_dataStream.IsOverflown() || header.magic != StateRecording::MAGIC)
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " is not a state recording.");
+
+	if (header.formatVersion != StateRecording::FORMAT_VERSION || header.rocketSimVersion != RS_VERSION_ID)
+		RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " was recorded with a different version of RocketSim.");
+
+	// Index all records
+	size_t lastKeyframeIndex = 0;
+	while (_dataStream.GetNumBytesLeft() >= sizeof(StateRecording::RecordHeader)) {
+		StateRecording::RecordHeader header = _dataStream.Read<StateRecording::RecordHeader>();
+
+		RecordInfo record = {};
+		record.type = header.type;
+		record.payloadSize = header.payloadSize;
+		record.tickCount = header.tickCount;
+		record.payloadPos = _dataStream.pos;
+
+		if (_dataStream.GetNumBytesLeft() < record.payloadSize)
+			break; // Truncated, the recorder was probably not flushed
+
+		if (record.type != StateRecording::RecordType::KEYFRAME && record.type != StateRecording::RecordType::DELTA)
+			RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " has a record with an invalid type (" << (int)record.type << ") at byte " << (record.payloadPos - sizeof(header)) << ".");
+
+		if (record.type == StateRecording::RecordType::KEYFRAME) {
+			lastKeyframeIndex = _records.size();
+		} else if (_records.empty()) {
+			RS_ERR_CLOSE(ERROR_PREFIX << "File " << filePath << " does not start with a keyframe.");
+		}
+		record.keyframeIndex = lastKeyframeIndex;
+
+		_records.push_back(record);
+		_dataStream.pos += record.payloadSize;
+	}
+}
+
+int64_t StateRecordingReader::FindRecord(uint64_t tickCount) const {
+	auto itr = std::upper_bound(_records.begin(), _records.end(), tickCount,
+		[](uint64_t tickCount, const RecordInfo& record) { return tickCount < record.tickCount; }
+	);
+	return (int64_t)(itr - _records.begin()) - 1;
+}
+
+ArenaSnapshotView StateRecordingReader::Read(size_t recordIndex) {
+	constexpr char ERROR_PREFIX[] = "StateRecordingReader::Read(): ";
+
+	if (recordIndex >= _records.size())
+		RS_ERR_CLOSE(ERROR_PREFIX << "Record index " << recordIndex << " is out of range (" << _records.size() << " records)");
+
+	const RecordInfo& target = _records[recordIndex];
+
+	// Continue from the current snapshot if it's on the way, otherwise start over from the keyframe
+	size_t startIndex;
+	if (_snapshotRecordIndex >= (int64_t)target.keyframeIndex && _snapshotRecordIndex <= (int64_t)recordIndex) {
+		startIndex = _snapshotRecordIndex + 1;
+	} else {
+		const RecordInfo& keyframe = _records[target.keyframeIndex];
+		_snapshot.assign(_dataStream.GetData() + keyframe.payloadPos, _dataStream.GetData() + keyframe.payloadPos + keyframe.payloadSize);
+		startIndex = target.keyframeIndex + 1;
+	}
+
+	for (size_t i = startIndex; i <= recordIndex; i++) {
+		const RecordInfo& record = _records[i];
+		if (!StateRecording::ApplyDelta(_snapshot.data(), _snapshot.size(), _dataStream.GetData() + record.payloadPos, record.payloadSize)) {
+			_snapshotRecordIndex = -1;
+			RS_ERR_CLOSE(ERROR_PREFIX << "Delta of record " << i << " is invalid");
+		}
+	}
+	_snapshotRecordIndex = recordIndex;
+
+	return ArenaSnapshotView::FromBuffer(_snapshot.data(), _snapshot.size());
+}
+
+RS_NS_END
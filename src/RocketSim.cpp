@@ -47,145 +47,215 @@ RocketSimStage RocketSim::GetStage() {
 	return stage;
 }
 
-std::vector<btBvhTriangleMeshShape*>& RocketSim::GetArenaCollisionShapes(GameMode gameMode) {
-	static std::map<GameMode, std::vector<btBvhTriangleMeshShape*>> arenaCollisionMeshes;
-	return arenaCollisionMeshes[gameMode];
-}
-
-void RocketSim::Init(std::filesystem::path collisionMeshesFolder, bool silent) {
-
-	std::map<GameMode, std::vector<FileData>> meshFileMap = {};
+constexpr GameMode GAMEMODES_WITH_UNIQUE_MESHES[] = {
+	GameMode::SOCCAR,
+	GameMode::HOOPS,
+	GameMode::DROPSHOT,
+};
 
-	constexpr GameMode GAMEMODES_WITH_UNIQUE_MESHES[] = {
-		GameMode::SOCCAR,
-		GameMode::HOOPS,
-		GameMode::DROPSHOT,
-	};
+// Mesh sources and built collision shapes for a single game mode
+struct ArenaMeshSet {
+	std::vector<FileData> meshFiles;
+	std::filesystem::path meshesFolder; // If not empty, mesh files are read from this folder when built
 
-	for (GameMode gameMode : GAMEMODES_WITH_UNIQUE_MESHES) { // Load collision meshes for soccar and hoops
-		auto& meshes = GetArenaCollisionShapes(gameMode);
+	std::vector<btBvhTriangleMeshShape*> shapes;
 
-		std::filesystem::path basePath = collisionMeshesFolder;
-		std::filesystem::path soccarMeshesFolder = basePath / GAMEMODE_STRS[(int)gameMode];
+	std::mutex buildMutex;
+	std::atomic<bool> isBuilt = false;
+};
 
-		if (!std::filesystem::exists(soccarMeshesFolder))
-			continue;
+static ArenaMeshSet arenaMeshSets[std::size(GAMEMODE_STRS)];
+static bool initSilent = false;
+static bool initSortMeshes = false;
 
-		MeshHashSet targetHashes = MeshHashSet(gameMode);
+// Opens a stream for each registered mesh file of a mesh set
+// Files in a meshes folder are memory-mapped rather than copied into memory
+static std::vector<DataStreamIn> OpenMeshStreams(ArenaMeshSet& meshSet) {
+	std::vector<DataStreamIn> result = {};
 
-		// Load collision meshes
-		auto dirItr = std::filesystem::directory_iterator(soccarMeshesFolder);
+	if (!meshSet.meshesFolder.empty()) {
+		auto dirItr = std::filesystem::directory_iterator(meshSet.meshesFolder);
 		for (auto& entry : dirItr) {
 			auto entryPath = entry.path();
-			if (entryPath.has_extension() && entryPath.extension() == COLLISION_MESH_FILE_EXTENSION) {
-				DataStreamIn streamIn = DataStreamIn(entryPath, false);
-				meshFileMap[gameMode].push_back(streamIn.data);
-			}
+			if (entryPath.has_extension() && entryPath.extension() == COLLISION_MESH_FILE_EXTENSION)
+				result.push_back(DataStreamIn(entryPath, false, true));
 		}
 	}
 
-	RocketSim::InitFromMem(meshFileMap, silent);
+	for (auto& entry : meshSet.meshFiles) {
+		DataStreamIn dataStream = {};
+		dataStream.data = std::move(entry);
+		result.push_back(std::move(dataStream));
+	}
 
-	_collisionMeshesFolder = collisionMeshesFolder;
+	return result;
 }
 
-void RocketSim::InitFromMem(const std::map<GameMode, std::vector<FileData>>& meshFilesMap, bool silent) {
-
+// Builds the collision shapes of a game mode from its registered sources, does nothing if already built
+static void BuildArenaMeshSet(GameMode gameMode) {
 	constexpr char MSG_PREFIX[] = "RocketSim::Init(): ";
 
-	_collisionMeshesFolder = "<MESH FILES LOADED FROM MEMORY>";
+	ArenaMeshSet& meshSet = arenaMeshSets[(int)gameMode];
+	if (meshSet.isBuilt)
+		return;
+
+	std::lock_guard<std::mutex> buildLock(meshSet.buildMutex);
+	if (meshSet.isBuilt)
+		return; // Another thread built it while we were waiting
+
+	bool silent = initSilent;
+
+	std::vector<DataStreamIn> meshStreams = OpenMeshStreams(meshSet);
+
+	if (!silent)
+		RS_LOG("Loading arena meshes for " << GAMEMODE_STRS[(int)gameMode] << "...");
 
-	_beginInitMutex.lock();
-	{
-		if (stage != RocketSimStage::UNINITIALIZED) {
+	if (meshStreams.empty()) {
+		if (!silent)
+			RS_LOG(" > No meshes, skipping");
+	}
+
+	MeshHashSet targetHashes = MeshHashSet(gameMode);
+
+	// Load collision meshes
+	int idx = 0;
+	for (auto& dataStream : meshStreams) {
+		CollisionMeshFile meshFile = {};
+		meshFile.ReadFromStream(dataStream, silent);
+		int& hashCount = targetHashes[meshFile.hash];
+
+		if (hashCount > 0) {
+			if (!silent)
+				RS_WARN(MSG_PREFIX << "Collision mesh [" << idx << "] is a duplicate (0x" << std::hex << meshFile.hash << "), " <<
+					"already loaded a mesh with the same hash."
+				);
+		} else if (targetHashes.hashes.count(meshFile.hash) == 0) {
 			if (!silent)
-				RS_WARN("RocketSim::Init() called again after already initialized, ignoring...");
-			_beginInitMutex.unlock();
-			return;
+				RS_WARN(MSG_PREFIX <<
+					"Collision mesh [" << idx << "] does not match any known " << GAMEMODE_STRS[(int)gameMode] << " collision mesh (0x" << std::hex << meshFile.hash << "), " <<
+					"make sure they were dumped from a normal " << GAMEMODE_STRS[(int)gameMode] << " arena."
+				);
 		}
+		hashCount++;
 
-		if (!silent)
-			RS_LOG("Initializing RocketSim version " ROCKETSIM_VERSION ", created by ZealanL...");
+		// Improve memory locality of the BVH leaves (after the hash was checked against the original data)
+		if (initSortMeshes)
+			meshFile.SortForLocality();
 
-		stage = RocketSimStage::INITIALIZING;
+		btTriangleMesh* triMesh = meshFile.MakeBulletMesh();
 
-		uint64_t startMS = RS_CUR_MS();
+		auto bvtMesh = new btBvhTriangleMeshShape(triMesh, true);
+		btTriangleInfoMap* infoMap = new btTriangleInfoMap();
+		btGenerateInternalEdgeInfo(bvtMesh, infoMap);
+		bvtMesh->setTriangleInfoMap(infoMap);
+		meshSet.shapes.push_back(bvtMesh);
 
-		// Init dropshot stuff
-		DropshotTiles::Init();
+		idx++;
+	}
 
-		for (auto& mapPair : meshFilesMap) { // Load collision meshes for soccar and hoops
-			GameMode gameMode = mapPair.first;
-			auto& meshFiles = mapPair.second;
+	// Sources are no longer needed
+	meshSet.meshFiles = {};
+	meshSet.meshesFolder.clear();
 
-			if (!silent)
-				RS_LOG("Loading arena meshes for " << GAMEMODE_STRS[(int)gameMode] << "...");
-
-			if (meshFiles.empty()) {
-				if (!silent)
-					RS_LOG(" > No meshes, skipping");
-				continue;
-			}
-
-			auto& meshes = GetArenaCollisionShapes(gameMode);
-
-			MeshHashSet targetHashes = MeshHashSet(gameMode);
-
-			// Load collision meshes
-			int idx = 0;
-			for (auto& entry : meshFiles) {
-				DataStreamIn dataStream = {};
-				dataStream.data = entry;
-				CollisionMeshFile meshFile = {};
-				meshFile.ReadFromStream(dataStream, silent);
-				int& hashCount = targetHashes[meshFile.hash];
-
-				if (hashCount > 0) {
-					if (!silent)
-						RS_WARN(MSG_PREFIX << "Collision mesh [" << idx << "] is a duplicate (0x" << std::hex << meshFile.hash << "), " <<
-							"already loaded a mesh with the same hash."
-						);
-				} else if (targetHashes.hashes.count(meshFile.hash) == 0) {
-					if (!silent)
-						RS_WARN(MSG_PREFIX <<
-							"Collision mesh [" << idx << "] does not match any known " << GAMEMODE_STRS[(int)gameMode] << " collision mesh (0x" << std::hex << meshFile.hash << "), " <<
-							"make sure they were dumped from a normal " << GAMEMODE_STRS[(int)gameMode] << " arena."
-						);
-				}
-				hashCount++;
+	meshSet.isBuilt = true;
+}
+
+// Registers the mesh sources of each game mode, then builds them unless lazy
+// If meshesFolder is not empty, each game mode's meshes are read from its sub-folder instead of meshFilesMap
+static void InitMeshSets(const std::map<GameMode, std::vector<FileData>>& meshFilesMap, const std::filesystem::path& meshesFolder, bool silent, bool lazy, bool sortMeshesForLocality) {
 
-				btTriangleMesh* triMesh = meshFile.MakeBulletMesh();
+	constexpr char MSG_PREFIX[] = "RocketSim::Init(): ";
 
-				auto bvtMesh = new btBvhTriangleMeshShape(triMesh, true);
-				btTriangleInfoMap* infoMap = new btTriangleInfoMap();
-				btGenerateInternalEdgeInfo(bvtMesh, infoMap);
-				bvtMesh->setTriangleInfoMap(infoMap);
-				meshes.push_back(bvtMesh);
+	std::lock_guard<std::mutex> initLock(_beginInitMutex);
 
-				idx++;
-			}
+	if (stage != RocketSimStage::UNINITIALIZED) {
+		if (!silent)
+			RS_WARN("RocketSim::Init() called again after already initialized, ignoring...");
+		return;
+	}
+
+	if (!silent)
+		RS_LOG("Initializing RocketSim version " ROCKETSIM_VERSION ", created by ZealanL...");
+
+	stage = RocketSimStage::INITIALIZING;
+	initSilent = silent;
+	initSortMeshes = sortMeshesForLocality;
+
+	uint64_t startMS = RS_CUR_MS();
+
+	// Init dropshot stuff
+	DropshotTiles::Init();
+
+	if (!meshesFolder.empty()) {
+		for (GameMode gameMode : GAMEMODES_WITH_UNIQUE_MESHES) {
+			std::filesystem::path gameModeMeshesFolder = meshesFolder / GAMEMODE_STRS[(int)gameMode];
+			if (std::filesystem::exists(gameModeMeshesFolder))
+				arenaMeshSets[(int)gameMode].meshesFolder = gameModeMeshesFolder;
+		}
+	} else {
+		for (auto& mapPair : meshFilesMap)
+			arenaMeshSets[(int)mapPair.first].meshFiles = mapPair.second;
+	}
+
+	if (lazy) {
+		if (!silent)
+			RS_LOG(MSG_PREFIX << "Registered arena collision meshes, each game mode will be built on first use");
+	} else {
+		for (int i = 0; i < (int)std::size(arenaMeshSets); i++) {
+			ArenaMeshSet& meshSet = arenaMeshSets[i];
+			if (!meshSet.meshFiles.empty() || !meshSet.meshesFolder.empty())
+				BuildArenaMeshSet((GameMode)i);
 		}
 
 		if (!silent) {
 			RS_LOG(MSG_PREFIX << "Finished loading arena collision meshes:");
-			RS_LOG(" > Soccar: " << GetArenaCollisionShapes(GameMode::SOCCAR).size());
-			RS_LOG(" > Hoops: " << GetArenaCollisionShapes(GameMode::HOOPS).size());
-			RS_LOG(" > Dropshot: " << GetArenaCollisionShapes(GameMode::DROPSHOT).size());
+			RS_LOG(" > Soccar: " << arenaMeshSets[(int)GameMode::SOCCAR].shapes.size());
+			RS_LOG(" > Hoops: " << arenaMeshSets[(int)GameMode::HOOPS].shapes.size());
+			RS_LOG(" > Dropshot: " << arenaMeshSets[(int)GameMode::DROPSHOT].shapes.size());
 		}
+	}
 
+	uint64_t elapsedMS = RS_CUR_MS() - startMS;
 
-		uint64_t elapsedMS = RS_CUR_MS() - startMS;
+	if (!silent)
+		RS_LOG("Finished initializing RocketSim in " << (elapsedMS / 1000.f) << "s!");
 
-		if (!silent)
-			RS_LOG("Finished initializing RocketSim in " << (elapsedMS / 1000.f) << "s!");
+	stage = RocketSimStage::INITIALIZED;
+}
 
-		stage = RocketSimStage::INITIALIZED;
+GameMode RocketSim::GetMeshGameMode(GameMode gameMode) {
+	switch (gameMode) {
+	case GameMode::HEATSEEKER:
+	case GameMode::SNOWDAY:
+		return GameMode::SOCCAR;
+	default:
+		return gameMode;
 	}
-	_beginInitMutex.unlock();
+}
+
+std::vector<btBvhTriangleMeshShape*>& RocketSim::GetArenaCollisionShapes(GameMode gameMode) {
+	GameMode meshGameMode = GetMeshGameMode(gameMode);
+
+	// Build on first use if we were initialized lazily
+	// (Before initialization has finished, there is nothing to build yet)
+	if (stage == RocketSimStage::INITIALIZED)
+		BuildArenaMeshSet(meshGameMode);
+
+	return arenaMeshSets[(int)meshGameMode].shapes;
+}
+
+void RocketSim::Init(std::filesystem::path collisionMeshesFolder, bool silent, bool lazy, bool sortMeshesForLocality) {
+	InitMeshSets({}, collisionMeshesFolder, silent, lazy, sortMeshesForLocality);
+	_collisionMeshesFolder = collisionMeshesFolder;
+}
+
+void RocketSim::InitFromMem(const std::map<GameMode, std::vector<FileData>>& meshFilesMap, bool silent, bool lazy, bool sortMeshesForLocality) {
+	_collisionMeshesFolder = "<MESH FILES LOADED FROM MEMORY>";
+	InitMeshSets(meshFilesMap, {}, silent, lazy, sortMeshesForLocality);
 }
 
 void RocketSim::AssertInitialized(const char* errorMsgPrefix) {
 	if (stage != RocketSimStage::INITIALIZED) {
 		RS_ERR_CLOSE(errorMsgPrefix << "RocketSim has not been initialized, call RocketSim::Init() first")
 	}
-}
\ No newline at end of file
+}
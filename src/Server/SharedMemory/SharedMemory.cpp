@@ -0,0 +1,154 @@
+#include <RocketSim/Server/SharedMemory/SharedMemory.h>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+RS_NS_START
+
+// POSIX shared memory names are a single path component starting with '/'
+static std::string _MakeSharedMemoryName(std::string name) {
+	if (name.empty() || name[0] != '/')
+		name = '/' + name;
+
+	if (name.size() < 2 || name.find('/', 1) != std::string::npos)
+		RS_ERR_CLOSE("SharedMemory: Invalid name \"" << name << "\", must be non-empty and contain no '/' after the first character");
+
+	return name;
+}
+
+SharedMemory SharedMemory::Create(std::string name, size_t size) {
+	constexpr char ERROR_PREFIX[] = "SharedMemory::Create(): ";
+
+	SharedMemory result = {};
+	result._name = _MakeSharedMemoryName(name);
+
+#ifdef _WIN32
+	RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory is not supported on Windows");
+#else
+	if (size == 0)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Size must be greater than 0");
+
+	int fd = shm_open(result._name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd == -1) {
+		if (errno == EEXIST)
+			RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory \"" << result._name << "\" already exists");
+
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to create shared memory \"" << result._name << "\" (errno " << errno << ")");
+	}
+
+	if (ftruncate(fd, size) != 0) {
+		close(fd);
+		shm_unlink(result._name.c_str());
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to resize shared memory \"" << result._name << "\" to " << size << " bytes (errno " << errno << ")");
+	}
+
+	void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd); // The mapping keeps the region alive
+	if (mapping == MAP_FAILED) {
+		shm_unlink(result._name.c_str());
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to map shared memory \"" << result._name << "\" (errno " << errno << ")");
+	}
+
+	result._data = (byte*)mapping;
+	result._size = size;
+	result._isOwner = true;
+#endif
+
+	return result;
+}
+
+SharedMemory SharedMemory::Open(std::string name) {
+	constexpr char ERROR_PREFIX[] = "SharedMemory::Open(): ";
+
+	SharedMemory result = {};
+	result._name = _MakeSharedMemoryName(name);
+
+#ifdef _WIN32
+	RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory is not supported on Windows");
+#else
+	int fd = shm_open(result._name.c_str(), O_RDWR, 0);
+	if (fd == -1)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to open shared memory \"" << result._name << "\" (errno " << errno << ")");
+
+	struct stat fdStat;
+	if (fstat(fd, &fdStat) != 0 || fdStat.st_size == 0) {
+		close(fd);
+		RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory \"" << result._name << "\" is empty or cannot be read");
+	}
+
+	void* mapping = mmap(NULL, fdStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Failed to map shared memory \"" << result._name << "\" (errno " << errno << ")");
+
+	result._data = (byte*)mapping;
+	result._size = fdStat.st_size;
+#endif
+
+	return result;
+}
+
+bool SharedMemory::Exists(std::string name) {
+#ifdef _WIN32
+	return false;
+#else
+	int fd = shm_open(_MakeSharedMemoryName(name).c_str(), O_RDONLY, 0);
+	if (fd == -1)
+		return errno != ENOENT;
+
+	close(fd);
+	return true;
+#endif
+}
+
+bool SharedMemory::Remove(std::string name) {
+#ifdef _WIN32
+	return false;
+#else
+	return shm_unlink(_MakeSharedMemoryName(name).c_str()) == 0;
+#endif
+}
+
+SharedMemory::~SharedMemory() {
+	Close();
+}
+
+SharedMemory::SharedMemory(SharedMemory&& other) noexcept {
+	*this = std::move(other);
+}
+
+SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept {
+	if (this != &other) {
+		Close();
+
+		_name = std::move(other._name);
+		_data = other._data;
+		_size = other._size;
+		_isOwner = other._isOwner;
+
+		other._data = NULL;
+		other._size = 0;
+		other._isOwner = false;
+	}
+	return *this;
+}
+
+void SharedMemory::Close() {
+#ifndef _WIN32
+	if (_data)
+		munmap(_data, _size);
+	if (_isOwner)
+		shm_unlink(_name.c_str());
+#endif
+
+	_data = NULL;
+	_size = 0;
+	_isOwner = false;
+}
+
+RS_NS_END
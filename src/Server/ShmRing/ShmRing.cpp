@@ -0,0 +1,41 @@
+#include <RocketSim/Server/ShmRing/ShmRing.h>
+
+RS_NS_START
+
+static uint32_t _GetSlotStride(uint32_t slotSize) {
+	constexpr uint32_t LINE = ShmRingHeader::CACHE_LINE_SIZE;
+	return (RS_MAX(slotSize, 1u) + LINE - 1) / LINE * LINE;
+}
+
+size_t ShmRing::GetRequiredSize(uint32_t numSlots, uint32_t slotSize) {
+	return sizeof(ShmRingHeader) + (size_t)numSlots * _GetSlotStride(slotSize);
+}
+
+ShmRing ShmRing::Init(void* memory, uint32_t numSlots, uint32_t slotSize) {
+	if (numSlots == 0 || (numSlots & (numSlots - 1)) != 0)
+		RS_ERR_CLOSE("ShmRing::Init(): Slot count must be a power of two (got " << numSlots << ")");
+
+	if ((uintptr_t)memory % ShmRingHeader::CACHE_LINE_SIZE != 0)
+		RS_ERR_CLOSE("ShmRing::Init(): Memory is not aligned to " << ShmRingHeader::CACHE_LINE_SIZE << " bytes");
+
+	ShmRingHeader* header = new (memory) ShmRingHeader();
+	header->writeIndex.store(0, std::memory_order_relaxed);
+	header->readIndex.store(0, std::memory_order_relaxed);
+	header->numSlots = numSlots;
+	header->slotStride = _GetSlotStride(slotSize);
+
+	return Attach(memory);
+}
+
+ShmRing ShmRing::Attach(void* memory) {
+	ShmRing ring = {};
+	ring._header = (ShmRingHeader*)memory;
+	ring._slots = (byte*)memory + sizeof(ShmRingHeader);
+
+	// Resume from wherever the ring currently is
+	ring._writeIndex = ring._cachedWriteIndex = ring._header->writeIndex.load(std::memory_order_acquire);
+	ring._readIndex = ring._cachedReadIndex = ring._header->readIndex.load(std::memory_order_acquire);
+	return ring;
+}
+
+RS_NS_END
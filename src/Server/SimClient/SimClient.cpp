@@ -0,0 +1,216 @@
+#include <RocketSim/Server/SimClient/SimClient.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+RS_NS_START
+
+// How many times to poll (yielding in between) before checking if the server is still running
+constexpr int SIM_CLIENT_WAIT_CHECK_INTERVAL = 1024;
+
+static uint32_t _GetProcessID() {
+#ifdef _WIN32
+	return 1; // Unreachable, as opening shared memory fails on Windows
+#else
+	return (uint32_t)getpid();
+#endif
+}
+
+SimClient::SimClient(std::string serverName, const std::vector<uint32_t>& arenaIndices) {
+	constexpr char ERROR_PREFIX[] = "SimClient: ";
+
+	_memory = SharedMemory::Open(serverName);
+	if (_memory.GetSize() < sizeof(SimServerHeader))
+		RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory \"" << _memory.GetName() << "\" is too small to be a server");
+
+	_header = (const SimServerHeader*)_memory.GetData();
+
+	if (_header->magic.load(std::memory_order_acquire) != SimServerHeader::MAGIC)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory \"" << _memory.GetName() << "\" is not a ready server (bad magic number)");
+
+	if (_header->formatVersion != SimServerHeader::FORMAT_VERSION || _header->rocketSimVersion != RS_VERSION_ID)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Server is a different version " <<
+			"(format: " << _header->formatVersion << ", RocketSim: " << _header->rocketSimVersion << ")");
+
+	// The expected layout is fully determined by the counts, so compare against that
+	SimServerHeader expected = {};
+	SimServerHeader::MakeLayout(expected, _header->numArenas, _header->maxCars, _header->maxBoostPads, _header->numRingSlots, _header->numEventSlots);
+	if (
+		_header->carControlsSize != expected.carControlsSize || _header->vecSize != expected.vecSize ||
+		_header->rotMatSize != expected.rotMatSize || _header->physStateSize != expected.physStateSize ||
+		_header->eventSize != expected.eventSize ||
+		memcmp(&_header->statesOffsets, &expected.statesOffsets, sizeof(expected.statesOffsets)) != 0 ||
+		_header->controlsMsgSize != expected.controlsMsgSize || _header->statesMsgSize != expected.statesMsgSize ||
+		_header->arenasOffset != expected.arenasOffset || _header->arenaBlockSize != expected.arenaBlockSize ||
+		_header->controlsRingOffset != expected.controlsRingOffset || _header->statesRingOffset != expected.statesRingOffset ||
+		_header->eventsRingOffset != expected.eventsRingOffset || _header->totalSize != expected.totalSize
+		) {
+		RS_ERR_CLOSE(ERROR_PREFIX << "Server layout does not match this build of RocketSim");
+	}
+
+	if (_memory.GetSize() < _header->totalSize)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory is too small for the server (" << _memory.GetSize() << "/" << _header->totalSize << " bytes)");
+
+	std::vector<uint32_t> claimIndices = arenaIndices;
+	if (claimIndices.empty())
+		for (uint32_t i = 0; i < _header->numArenas; i++)
+			claimIndices.push_back(i);
+
+	_processID = _GetProcessID();
+
+	_channels.resize(_header->numArenas);
+	for (uint32_t arenaIndex : claimIndices) {
+		if (arenaIndex >= _header->numArenas)
+			RS_ERR_CLOSE(ERROR_PREFIX << "Invalid arena index " << arenaIndex << " (server has " << _header->numArenas << " arenas)");
+
+		byte* block = _memory.GetData() + _header->arenasOffset + _header->arenaBlockSize * arenaIndex;
+		SimArenaBlockHeader* blockHeader = (SimArenaBlockHeader*)block;
+
+		// Set before claiming, so the server never sees a claim with an older heartbeat
+		// If the claim fails, this only delays the server timing out the current client
+		blockHeader->heartbeatTime.store(SimArenaBlockHeader::GetHeartbeatTime(), std::memory_order_relaxed);
+
+		uint64_t prevClaim = blockHeader->claim.load(std::memory_order_acquire);
+		uint32_t generation = SimArenaBlockHeader::GetClaimGeneration(prevClaim) + 1;
+		if (generation == 0)
+			generation = 1; // The server starts out ready for generation 0
+		if (
+			SimArenaBlockHeader::GetClaimPID(prevClaim) != 0 ||
+			!blockHeader->claim.compare_exchange_strong(prevClaim, SimArenaBlockHeader::MakeClaim(generation, _processID), std::memory_order_acq_rel)
+			) {
+			// Release what was claimed so far, as the destructor won't run
+			_ReleaseClaims();
+			RS_ERR_CLOSE(
+				ERROR_PREFIX << "Arena " << arenaIndex << " is already used by another client " <<
+				"(process " << SimArenaBlockHeader::GetClaimPID(prevClaim) << ")"
+			);
+		}
+
+		ArenaChannel& channel = _channels[arenaIndex];
+		channel.blockHeader = blockHeader;
+		channel.generation = generation;
+	}
+}
+
+SimClient::~SimClient() {
+	_ReleaseClaims();
+}
+
+CarControls* SimClient::BeginControls(uint32_t arenaIndex) {
+	ArenaChannel& channel = _GetClaimedChannel(arenaIndex);
+	if (!channel.isReady)
+		return NULL;
+
+	void* message = channel.controlsRing.BeginWrite();
+	return message ? ((SimControlsMsgHeader*)message)->GetControls() : NULL;
+}
+
+uint64_t SimClient::SendControls(uint32_t arenaIndex, uint32_t numCars, uint32_t ticks) {
+	ArenaChannel& channel = _GetClaimedChannel(arenaIndex);
+
+	void* message = channel.isReady ? channel.controlsRing.BeginWrite() : NULL;
+	if (!message)
+		RS_ERR_CLOSE("SimClient::SendControls(): Controls ring of arena " << arenaIndex << " is full or not ready, BeginControls() must succeed first");
+
+	if (numCars > _header->maxCars)
+		RS_ERR_CLOSE("SimClient::SendControls(): Too many cars (" << numCars << "/" << _header->maxCars << ")");
+
+	auto& header = *(SimControlsMsgHeader*)message;
+	header.seq = channel.nextSeq++;
+	header.ticks = ticks;
+	header.numCars = numCars;
+	channel.controlsRing.EndWrite();
+	return header.seq;
+}
+
+SimStatesView SimClient::PeekStates(uint32_t arenaIndex) {
+	ArenaChannel& channel = _GetClaimedChannel(arenaIndex);
+	const void* message = channel.isReady ? channel.statesRing.BeginRead() : NULL;
+	return message ? SimStatesView::FromMessage(message, *_header) : SimStatesView();
+}
+
+SimStatesView SimClient::WaitStates(uint32_t arenaIndex) {
+	ArenaChannel* channel = &_GetClaimedChannel(arenaIndex);
+	for (int i = 1;; i++) {
+		const void* message = channel->isReady ? channel->statesRing.BeginRead() : NULL;
+		if (message)
+			return SimStatesView::FromMessage(message, *_header);
+
+		// Until the arena is ready, check every time if it became ready
+		if (i % SIM_CLIENT_WAIT_CHECK_INTERVAL == 0 || !channel->isReady) {
+			if (!IsServerRunning())
+				RS_ERR_CLOSE("SimClient::WaitStates(): Server \"" << _memory.GetName() << "\" has stopped");
+
+			channel = &_GetClaimedChannel(arenaIndex); // Keeps the heartbeat going while the server is busy
+		}
+
+		std::this_thread::yield();
+	}
+}
+
+void SimClient::PopStates(uint32_t arenaIndex) {
+	ArenaChannel& channel = _GetClaimedChannel(arenaIndex);
+	if (!channel.isReady || !channel.statesRing.BeginRead())
+		RS_ERR_CLOSE("SimClient::PopStates(): No states to pop for arena " << arenaIndex);
+	channel.statesRing.EndRead();
+}
+
+const SimEvent* SimClient::PeekEvent(uint32_t arenaIndex) {
+	ArenaChannel& channel = _GetClaimedChannel(arenaIndex);
+	return channel.isReady ? (const SimEvent*)channel.eventsRing.BeginRead() : NULL;
+}
+
+void SimClient::PopEvent(uint32_t arenaIndex) {
+	ArenaChannel& channel = _GetClaimedChannel(arenaIndex);
+	if (!channel.isReady || !channel.eventsRing.BeginRead())
+		RS_ERR_CLOSE("SimClient::PopEvent(): No event to pop for arena " << arenaIndex);
+	channel.eventsRing.EndRead();
+}
+
+void SimClient::_ReleaseClaim(ArenaChannel& channel) {
+	// Only release our own claim, the server could have released it and another client claimed the arena since
+	uint64_t claim = SimArenaBlockHeader::MakeClaim(channel.generation, _processID);
+	channel.blockHeader->claim.compare_exchange_strong(claim, SimArenaBlockHeader::MakeClaim(channel.generation, 0), std::memory_order_acq_rel);
+	channel.blockHeader = NULL;
+	channel.isReady = false;
+}
+
+void SimClient::_ReleaseClaims() {
+	for (ArenaChannel& channel : _channels)
+		if (channel.blockHeader)
+			_ReleaseClaim(channel);
+}
+
+SimClient::ArenaChannel& SimClient::_GetClaimedChannel(uint32_t arenaIndex) {
+	if (arenaIndex >= _channels.size() || !_channels[arenaIndex].blockHeader)
+		RS_ERR_CLOSE("SimClient: Arena " << arenaIndex << " is not claimed by this client");
+
+	ArenaChannel& channel = _channels[arenaIndex];
+	SimArenaBlockHeader* blockHeader = channel.blockHeader;
+	if (blockHeader->claim.load(std::memory_order_acquire) != SimArenaBlockHeader::MakeClaim(channel.generation, _processID)) {
+		channel.blockHeader = NULL;
+		channel.isReady = false;
+		RS_ERR_CLOSE("SimClient: Arena " << arenaIndex << " was released by the server");
+	}
+
+	if (blockHeader->revokedGeneration.load(std::memory_order_acquire) == channel.generation) {
+		// This client won't touch the rings anymore, so the arena can be claimed again
+		_ReleaseClaim(channel);
+		RS_ERR_CLOSE("SimClient: Arena " << arenaIndex << " was revoked by the server, as this client stopped sending heartbeats");
+	}
+
+	blockHeader->heartbeatTime.store(SimArenaBlockHeader::GetHeartbeatTime(), std::memory_order_relaxed);
+
+	if (!channel.isReady && blockHeader->readyGeneration.load(std::memory_order_acquire) == channel.generation) {
+		byte* block = (byte*)blockHeader;
+		channel.controlsRing = ShmRing::Attach(block + _header->controlsRingOffset);
+		channel.statesRing = ShmRing::Attach(block + _header->statesRingOffset);
+		channel.eventsRing = ShmRing::Attach(block + _header->eventsRingOffset);
+		channel.isReady = true;
+	}
+
+	return channel;
+}
+
+RS_NS_END
@@ -0,0 +1,401 @@
+#include <RocketSim/Server/SimServer/SimServer.h>
+
+#include <RocketSim/Sim/CompactState/CompactState.h>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+RS_NS_START
+
+// Messages are written into shared memory as raw bytes
+static_assert(std::is_trivially_copyable_v<CarControls>);
+static_assert(std::is_trivially_copyable_v<PhysState>);
+static_assert(std::is_trivially_copyable_v<SimEvent>);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+// How many times to poll (yielding in between) before sleeping, and how long to sleep for
+constexpr int SIM_SERVER_IDLE_SPIN_COUNT = 4096;
+constexpr int SIM_SERVER_IDLE_SLEEP_US = 100;
+
+// How often to look for clients that crashed or stopped sending heartbeats
+constexpr uint64_t SIM_SERVER_CLIENT_CHECK_INTERVAL_NS = 100 * 1000 * 1000;
+
+static bool _IsProcessAlive(uint32_t pid) {
+#ifdef _WIN32
+	return true;
+#else
+	// Signal 0 only checks that the process exists, EPERM means it exists but belongs to another user
+	return kill((pid_t)pid, 0) == 0 || errno != ESRCH;
+#endif
+}
+
+static uint32_t _GetProcessID() {
+#ifdef _WIN32
+	return 1; // Unreachable, as creating shared memory fails on Windows
+#else
+	return (uint32_t)getpid();
+#endif
+}
+
+// A region left over from a server of this version whose process is gone
+static bool _IsLeftOverServer(const SharedMemory& memory) {
+	if (memory.GetSize() < sizeof(SimServerHeader))
+		return false;
+
+	auto& header = *(const SimServerHeader*)memory.GetData();
+	return
+		header.magic.load(std::memory_order_acquire) == SimServerHeader::MAGIC && header.formatVersion == SimServerHeader::FORMAT_VERSION &&
+		!_IsProcessAlive(header.serverPID);
+}
+
+static size_t _AlignUp(size_t value, size_t alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+void SimServerHeader::MakeLayout(SimServerHeader& header, uint32_t numArenas, uint32_t maxCars, uint32_t maxBoostPads, uint32_t numRingSlots, uint32_t numEventSlots) {
+	header.formatVersion = FORMAT_VERSION;
+	header.rocketSimVersion = RS_VERSION_ID;
+
+	header.carControlsSize = sizeof(CarControls);
+	header.vecSize = sizeof(Vec);
+	header.rotMatSize = sizeof(RotMat);
+	header.physStateSize = sizeof(PhysState);
+	header.eventSize = sizeof(SimEvent);
+
+	header.numArenas = numArenas;
+	header.maxCars = maxCars;
+	header.maxBoostPads = maxBoostPads;
+	header.numRingSlots = numRingSlots;
+	header.numEventSlots = numEventSlots;
+
+	size_t curOffset = sizeof(SimStatesMsgHeader);
+	auto fnAddSection = [&](size_t sectionSize) -> uint32_t {
+		curOffset = _AlignUp(curOffset, SECTION_ALIGNMENT);
+		uint32_t sectionOffset = curOffset;
+		curOffset += sectionSize;
+		return sectionOffset;
+	};
+
+	header.statesOffsets.carIDs = fnAddSection(sizeof(uint32_t) * maxCars);
+	header.statesOffsets.carTeams = fnAddSection(sizeof(Team) * maxCars);
+	header.statesOffsets.carPos = fnAddSection(sizeof(Vec) * maxCars);
+	header.statesOffsets.carRotMat = fnAddSection(sizeof(RotMat) * maxCars);
+	header.statesOffsets.carVel = fnAddSection(sizeof(Vec) * maxCars);
+	header.statesOffsets.carAngVel = fnAddSection(sizeof(Vec) * maxCars);
+	header.statesOffsets.carBoost = fnAddSection(sizeof(float) * maxCars);
+	header.statesOffsets.carFlags = fnAddSection(sizeof(uint16_t) * maxCars);
+	header.statesOffsets.boostPadIsActive = fnAddSection(sizeof(uint8_t) * maxBoostPads);
+
+	header.statesMsgSize = fnAddSection(0);
+	header.controlsMsgSize = sizeof(SimControlsMsgHeader) + sizeof(CarControls) * maxCars;
+
+	size_t controlsRingSize = ShmRing::GetRequiredSize(numRingSlots, header.controlsMsgSize);
+	size_t statesRingSize = ShmRing::GetRequiredSize(numRingSlots, header.statesMsgSize);
+	size_t eventsRingSize = ShmRing::GetRequiredSize(numEventSlots, sizeof(SimEvent));
+
+	header.controlsRingOffset = _AlignUp(sizeof(SimArenaBlockHeader), BLOCK_ALIGNMENT);
+	header.statesRingOffset = _AlignUp(header.controlsRingOffset + controlsRingSize, BLOCK_ALIGNMENT);
+	header.eventsRingOffset = _AlignUp(header.statesRingOffset + statesRingSize, BLOCK_ALIGNMENT);
+	header.arenaBlockSize = _AlignUp(header.eventsRingOffset + eventsRingSize, BLOCK_ALIGNMENT);
+
+	header.arenasOffset = _AlignUp(sizeof(SimServerHeader), BLOCK_ALIGNMENT);
+	header.totalSize = header.arenasOffset + header.arenaBlockSize * numArenas;
+}
+
+SimStatesView SimStatesView::FromMessage(const void* message, const SimServerHeader& serverHeader) {
+	const byte* bytes = (const byte*)message;
+	auto& offsets = serverHeader.statesOffsets;
+
+	SimStatesView view = {};
+	view.header = (const SimStatesMsgHeader*)bytes;
+	view.carIDs = (const uint32_t*)(bytes + offsets.carIDs);
+	view.carTeams = (const Team*)(bytes + offsets.carTeams);
+	view.carPos = (const Vec*)(bytes + offsets.carPos);
+	view.carRotMat = (const RotMat*)(bytes + offsets.carRotMat);
+	view.carVel = (const Vec*)(bytes + offsets.carVel);
+	view.carAngVel = (const Vec*)(bytes + offsets.carAngVel);
+	view.carBoost = (const float*)(bytes + offsets.carBoost);
+	view.carFlags = (const uint16_t*)(bytes + offsets.carFlags);
+	view.boostPadIsActive = (const uint8_t*)(bytes + offsets.boostPadIsActive);
+	return view;
+}
+
+SimServer::SimServer(std::string name, const std::vector<Arena*>& arenas, const SimServerConfig& config) {
+	constexpr char ERROR_PREFIX[] = "SimServer: ";
+
+	if (arenas.empty())
+		RS_ERR_CLOSE(ERROR_PREFIX << "No arenas to host");
+
+	uint32_t maxCars = config.maxCars, maxBoostPads = 0;
+	for (Arena* arena : arenas) {
+		if (!arena)
+			RS_ERR_CLOSE(ERROR_PREFIX << "Arena is NULL");
+
+		if (config.maxCars == 0)
+			maxCars = RS_MAX(maxCars, (uint32_t)arena->_cars.size());
+		else if (arena->_cars.size() > config.maxCars)
+			RS_ERR_CLOSE(ERROR_PREFIX << "Arena has more cars than the max (" << arena->_cars.size() << "/" << config.maxCars << ")");
+
+		maxBoostPads = RS_MAX(maxBoostPads, (uint32_t)arena->_boostPads.size());
+	}
+
+	for (uint32_t numSlots : { config.numRingSlots, config.numEventSlots })
+		if (numSlots == 0 || (numSlots & (numSlots - 1)) != 0)
+			RS_ERR_CLOSE(ERROR_PREFIX << "Ring slot counts must be powers of two (got " << numSlots << ")");
+
+	if (!(config.clientTimeout >= 0))
+		RS_ERR_CLOSE(ERROR_PREFIX << "Client timeout cannot be negative (got " << config.clientTimeout << ")");
+	_clientTimeoutNs = (uint64_t)((double)config.clientTimeout * 1e9);
+
+	SimServerHeader layout = {};
+	SimServerHeader::MakeLayout(layout, arenas.size(), maxCars, maxBoostPads, config.numRingSlots, config.numEventSlots);
+
+	// Never replace the region of a running server, clients could be using it
+	if (SharedMemory::Exists(name)) {
+		if (!_IsLeftOverServer(SharedMemory::Open(name)))
+			RS_ERR_CLOSE(ERROR_PREFIX << "Shared memory \"" << name << "\" is used by a running server or something else");
+
+		SharedMemory::Remove(name);
+	}
+
+	_memory = SharedMemory::Create(name, layout.totalSize);
+	byte* data = _memory.GetData();
+
+	_header = new (data) SimServerHeader();
+	SimServerHeader::MakeLayout(*_header, arenas.size(), maxCars, maxBoostPads, config.numRingSlots, config.numEventSlots);
+	_header->serverPID = _GetProcessID();
+	_header->isRunning.store(1, std::memory_order_relaxed);
+	_header->numDroppedEvents.store(0, std::memory_order_relaxed);
+
+	_channels.resize(arenas.size());
+	for (size_t i = 0; i < arenas.size(); i++) {
+		byte* block = data + _header->arenasOffset + _header->arenaBlockSize * i;
+		ArenaChannel& channel = _channels[i];
+		channel.server = this;
+		channel.arena = arenas[i];
+		channel.blockHeader = new (block) SimArenaBlockHeader();
+		channel.controlsRing = ShmRing::Init(block + _header->controlsRingOffset, _header->numRingSlots, _header->controlsMsgSize);
+		channel.statesRing = ShmRing::Init(block + _header->statesRingOffset, _header->numRingSlots, _header->statesMsgSize);
+		channel.eventsRing = ShmRing::Init(block + _header->eventsRingOffset, _header->numEventSlots, sizeof(SimEvent));
+		channel.readyGeneration = 0;
+
+		// Events are recorded straight from the callbacks, while stepping
+		channel.arena->SetGoalScoreCallback(
+			[](Arena* arena, Team scoringTeam, void* userInfo) {
+				ArenaChannel& channel = *(ArenaChannel*)userInfo;
+				channel.server->_PushEvent(channel, { arena->tickCount, 0, 0, SimEventType::GOAL, scoringTeam });
+			},
+			&channel
+		);
+		channel.arena->SetCarBumpCallback(
+			[](Arena* arena, Car* bumper, Car* victim, bool isDemo, void* userInfo) {
+				ArenaChannel& channel = *(ArenaChannel*)userInfo;
+				SimEventType type = isDemo ? SimEventType::DEMO : SimEventType::BUMP;
+				channel.server->_PushEvent(channel, { arena->tickCount, bumper->id, victim->id, type, bumper->team });
+			},
+			&channel
+		);
+	}
+
+	// Clients only attach once they see the magic number
+	_header->magic.store(SimServerHeader::MAGIC, std::memory_order_release);
+}
+
+SimServer::~SimServer() {
+	_header->isRunning.store(0, std::memory_order_release);
+
+	for (ArenaChannel& channel : _channels) {
+		channel.arena->SetGoalScoreCallback(NULL);
+		channel.arena->SetCarBumpCallback(NULL);
+	}
+}
+
+size_t SimServer::Poll() {
+	uint64_t curTime = SimArenaBlockHeader::GetHeartbeatTime();
+	if (curTime >= _nextClientCheckTime) {
+		_ReleaseLostClients();
+		_nextClientCheckTime = curTime + SIM_SERVER_CLIENT_CHECK_INTERVAL_NS;
+	}
+
+	size_t numHandled = 0;
+	for (ArenaChannel& channel : _channels) {
+		SimArenaBlockHeader* blockHeader = channel.blockHeader;
+		uint64_t claim = blockHeader->claim.load(std::memory_order_acquire);
+		uint32_t generation = SimArenaBlockHeader::GetClaimGeneration(claim);
+		if (SimArenaBlockHeader::GetClaimPID(claim) == 0 || generation == blockHeader->revokedGeneration.load(std::memory_order_acquire))
+			continue;
+
+		// The previous client released its claim, so nothing else uses the rings
+		if (generation != channel.readyGeneration)
+			_ResetChannel(channel, generation);
+
+		const void* controlsMsg = channel.controlsRing.BeginRead();
+		if (!controlsMsg)
+			continue;
+
+		void* statesMsg = channel.statesRing.BeginWrite();
+		if (!statesMsg)
+			continue; // Client hasn't read its states yet
+
+		Arena* arena = channel.arena;
+		auto& header = *(const SimControlsMsgHeader*)controlsMsg;
+
+		if (header.numCars != arena->_cars.size()) {
+			RS_WARN(
+				"SimServer::Poll(): Invalid controls message for arena " << (&channel - _channels.data()) <<
+				" (" << header.numCars << "/" << arena->_cars.size() << " cars), not stepping"
+			);
+		} else {
+			const CarControls* controls = header.GetControls();
+			size_t carIndex = 0;
+			for (Car* car : arena->_cars)
+				car->controls = controls[carIndex++];
+
+			// A message with 0 ticks only sets the controls, and is answered with the current states
+			if (header.ticks > 0) {
+				uint64_t startTickCount = arena->tickCount;
+				arena->Step(header.ticks);
+
+				for (Car* car : arena->_cars) {
+					const BallHitInfo& hitInfo = car->_internalState.ballHitInfo;
+					if (hitInfo.isValid && hitInfo.tickCountWhenHit >= startTickCount && hitInfo.tickCountWhenHit != ~0ULL)
+						_PushEvent(channel, { hitInfo.tickCountWhenHit, car->id, 0, SimEventType::BALL_TOUCH, car->team });
+				}
+			}
+		}
+
+		_WriteStates(channel, header.seq, statesMsg);
+
+		channel.controlsRing.EndRead();
+		channel.statesRing.EndWrite();
+		numHandled++;
+	}
+
+	return numHandled;
+}
+
+void SimServer::Run() {
+	int numIdlePolls = 0;
+	while (!_shouldStop.load(std::memory_order_relaxed)) {
+		if (Poll() > 0) {
+			numIdlePolls = 0;
+		} else if (numIdlePolls < SIM_SERVER_IDLE_SPIN_COUNT) {
+			numIdlePolls++;
+			std::this_thread::yield();
+		} else {
+			std::this_thread::sleep_for(std::chrono::microseconds(SIM_SERVER_IDLE_SLEEP_US));
+		}
+	}
+	_shouldStop = false;
+}
+
+void SimServer::Stop() {
+	_shouldStop = true;
+}
+
+void SimServer::_ReleaseLostClients() {
+	uint64_t curTime = SimArenaBlockHeader::GetHeartbeatTime();
+	for (ArenaChannel& channel : _channels) {
+		SimArenaBlockHeader* blockHeader = channel.blockHeader;
+		size_t arenaIndex = &channel - _channels.data();
+
+		uint64_t claim = blockHeader->claim.load(std::memory_order_acquire);
+		uint32_t clientPID = SimArenaBlockHeader::GetClaimPID(claim);
+		uint32_t generation = SimArenaBlockHeader::GetClaimGeneration(claim);
+		if (clientPID == 0)
+			continue;
+
+		if (!_IsProcessAlive(clientPID)) {
+			// Only release the claim we checked, the client could have released it and another one claimed it since
+			uint64_t releasedClaim = SimArenaBlockHeader::MakeClaim(generation, 0);
+			if (blockHeader->claim.compare_exchange_strong(claim, releasedClaim, std::memory_order_acq_rel))
+				RS_WARN("SimServer: Released arena " << arenaIndex << " from client process " << clientPID << " (process is gone)");
+			continue;
+		}
+
+		if (generation == blockHeader->revokedGeneration.load(std::memory_order_relaxed))
+			continue;
+
+		// Clients set their heartbeat before claiming, so it is never older than the claim
+		uint64_t heartbeatTime = blockHeader->heartbeatTime.load(std::memory_order_relaxed);
+		bool timedOut = _clientTimeoutNs > 0 && curTime > heartbeatTime && curTime - heartbeatTime > _clientTimeoutNs;
+		if (timedOut) {
+			blockHeader->revokedGeneration.store(generation, std::memory_order_release);
+			RS_WARN(
+				"SimServer: Revoked arena " << arenaIndex << " from client process " << clientPID << " (no heartbeat), " <<
+				"it can be claimed again once that client notices or exits"
+			);
+		}
+	}
+}
+
+void SimServer::_ResetChannel(ArenaChannel& channel, uint32_t generation) {
+	byte* block = (byte*)channel.blockHeader;
+	channel.controlsRing = ShmRing::Init(block + _header->controlsRingOffset, _header->numRingSlots, _header->controlsMsgSize);
+	channel.statesRing = ShmRing::Init(block + _header->statesRingOffset, _header->numRingSlots, _header->statesMsgSize);
+	channel.eventsRing = ShmRing::Init(block + _header->eventsRingOffset, _header->numEventSlots, sizeof(SimEvent));
+
+	_WriteStates(channel, 0, channel.statesRing.BeginWrite());
+	channel.statesRing.EndWrite();
+
+	channel.readyGeneration = generation;
+	channel.blockHeader->readyGeneration.store(generation, std::memory_order_release);
+}
+
+void SimServer::_WriteStates(ArenaChannel& channel, uint64_t seq, void* message) {
+	Arena* arena = channel.arena;
+	if (arena->_cars.size() > _header->maxCars || arena->_boostPads.size() > _header->maxBoostPads)
+		RS_ERR_CLOSE("SimServer: Arena has more cars or boost pads than the server was created with");
+
+	byte* bytes = (byte*)message;
+	auto& offsets = _header->statesOffsets;
+
+	auto& header = *(SimStatesMsgHeader*)bytes;
+	header.seq = seq;
+	header.tickCount = arena->tickCount;
+	header.numCars = arena->_cars.size();
+	header.numBoostPads = arena->_boostPads.size();
+	header.ball = arena->ball->GetState();
+
+	uint32_t* carIDs = (uint32_t*)(bytes + offsets.carIDs);
+	Team* carTeams = (Team*)(bytes + offsets.carTeams);
+	Vec* carPos = (Vec*)(bytes + offsets.carPos);
+	RotMat* carRotMat = (RotMat*)(bytes + offsets.carRotMat);
+	Vec* carVel = (Vec*)(bytes + offsets.carVel);
+	Vec* carAngVel = (Vec*)(bytes + offsets.carAngVel);
+	float* carBoost = (float*)(bytes + offsets.carBoost);
+	uint16_t* carFlags = (uint16_t*)(bytes + offsets.carFlags);
+
+	size_t carIndex = 0;
+	for (Car* car : arena->_cars) {
+		const CarState& state = car->GetState();
+		carIDs[carIndex] = car->id;
+		carTeams[carIndex] = car->team;
+		carPos[carIndex] = state.pos;
+		carRotMat[carIndex] = state.rotMat;
+		carVel[carIndex] = state.vel;
+		carAngVel[carIndex] = state.angVel;
+		carBoost[carIndex] = state.boost;
+		carFlags[carIndex] = CompactState::GetCarFlags(state);
+		carIndex++;
+	}
+
+	uint8_t* boostPadIsActive = (uint8_t*)(bytes + offsets.boostPadIsActive);
+	for (size_t i = 0; i < arena->_boostPads.size(); i++)
+		boostPadIsActive[i] = arena->_boostPads[i]->_internalState.isActive;
+}
+
+void SimServer::_PushEvent(ArenaChannel& channel, const SimEvent& event) {
+	void* slot = channel.eventsRing.BeginWrite();
+	if (slot) {
+		memcpy(slot, &event, sizeof(SimEvent));
+		channel.eventsRing.EndWrite();
+	} else {
+		_header->numDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+RS_NS_END
@@ -149,8 +149,12 @@ void Arena::ResetToRandomKickoff(int seed) {
 		CAR_RESPAWN_LOCATIONS = CAR_RESPAWN_LOCATIONS_DROPSHOT;
 	}
 
+	// Hand out the spots in car ID order, as the order of _cars depends on where the cars were allocated
+	std::vector<Car*> cars(_cars.begin(), _cars.end());
+	std::sort(cars.begin(), cars.end(), [](Car* a, Car* b) { return a->id < b->id; });
+
 	std::vector<Car*> blueCars, orangeCars;
-	for (Car* car : _cars)
+	for (Car* car : cars)
 		((car->team == Team::BLUE) ? blueCars : orangeCars).push_back(car);
 
 	int numCarsAtRespawnPos[CAR_RESPAWN_LOCATION_AMOUNT] = {};
@@ -225,22 +229,35 @@ void Arena::ResetToRandomKickoff(int seed) {
 }
 
 void Arena::SetDropshotTilesState(const DropshotTilesState& state) {
-	for (int teamIdx = 0; teamIdx <= 1; teamIdx++) {
-		for (int tileIdx = 0; tileIdx < RLConst::Dropshot::NUM_TILES_PER_TEAM; tileIdx++) {
-			auto& newState = state.states[teamIdx][tileIdx];
+	for (int teamIdx = 0; teamIdx <= 1; teamIdx++)
+		for (int tileIdx = 0; tileIdx < RLConst::Dropshot::NUM_TILES_PER_TEAM; tileIdx++)
+			if (state.states[teamIdx][tileIdx].damageState != _dropshotTilesState.states[teamIdx][tileIdx].damageState)
+				_dropshotTilesChanged.Set(tileIdx + (RLConst::Dropshot::NUM_TILES_PER_TEAM * teamIdx));
+
+	_dropshotTilesState = state;
+	_UpdateDropshotTileRBs();
+}
+
+void Arena::_UpdateDropshotTileRBs() {
+	if (!_dropshotTilesChanged.Any())
+		return;
+
+	_dropshotTilesChanged.ForEach(
+		[&](int rbIndex) {
+			int teamIdx = rbIndex / RLConst::Dropshot::NUM_TILES_PER_TEAM;
+			int tileIdx = rbIndex % RLConst::Dropshot::NUM_TILES_PER_TEAM;
 
-			int rbIndex = tileIdx + (RLConst::Dropshot::NUM_TILES_PER_TEAM * teamIdx);
 			assert(rbIndex < _worldDropshotTileRBs.size());
 			auto dropshotTileRB = _worldDropshotTileRBs[rbIndex];
-			if (newState.damageState == DropshotTileState::STATE_BROKEN) {
+			if (_dropshotTilesState.states[teamIdx][tileIdx].damageState == DropshotTileState::STATE_BROKEN) {
 				dropshotTileRB->m_collisionFlags |= btCollisionObject::CF_NO_CONTACT_RESPONSE;
 			} else {
 				dropshotTileRB->m_collisionFlags &= ~btCollisionObject::CF_NO_CONTACT_RESPONSE;
 			}
 		}
-	}
+	);
 
-	_dropshotTilesState = state;
+	_dropshotTilesChanged.Clear();
 }
 
 bool Arena::_BulletContactAddedCallback(
@@ -294,7 +311,7 @@ bool Arena::_BulletContactAddedCallback(
 
 		Arena* arenaInst = (Arena*)bodyB->getUserPointer();
 		arenaInst->ball->_OnDropshotTileCollision(
-			arenaInst->_dropshotTilesState, bodyB->getUserIndex2(), bodyB, arenaInst->tickCount, arenaInst->tickTime
+			arenaInst->_dropshotTilesState, arenaInst->_dropshotTilesChanged, bodyB->getUserIndex2(), bodyB, arenaInst->tickCount, arenaInst->tickTime
 		);
 
 	} else if (userIndexA == BT_USERINFO_TYPE_BALL && userIndexB == -1) {
@@ -415,7 +432,7 @@ void Arena::_BtCallback_OnCarWorldCollision(Car* car, btCollisionObject* world,
 	manifoldPoint.m_combinedRestitution = _mutatorConfig.carWorldRestitution;
 }
 
-Arena::Arena(GameMode gameMode, const ArenaConfig& config, float tickRate) : _mutatorConfig(gameMode), _config(config) {
+Arena::Arena(GameMode gameMode, const ArenaConfig& config, float tickRate, const Arena* staticSource) : _mutatorConfig(gameMode), _config(config) {
 
 	// Tickrate must be from 15 to 120tps
 	assert(tickRate >= 15 && tickRate <= 120);
@@ -457,7 +474,13 @@ Arena::Arena(GameMode gameMode, const ArenaConfig& config, float tickRate) : _mu
 				_config.maxPos * UU_TO_BT,
 				_config.maxAABBLen * UU_TO_BT * cellSizeMultiplier,
 				_bulletWorldParams.overlappingPairCache,
-				_config.maxObjects);
+				_config.maxObjects,
+				_config.useSparseBroadphaseGrid);
+
+			if (staticSource && staticSource->_config.useCustomBroadphase) {
+				// Static collision objects are created in the same order as in staticSource, so its static grid will match
+				((btRSBroadphase*)_bulletWorldParams.broadphase)->shareStaticGrid(*(btRSBroadphase*)staticSource->_bulletWorldParams.broadphase);
+			}
 		} else {
 			_bulletWorldParams.broadphase = new btDbvtBroadphase(_bulletWorldParams.overlappingPairCache);
 		}
@@ -475,6 +498,17 @@ Arena::Arena(GameMode gameMode, const ArenaConfig& config, float tickRate) : _mu
 		auto& solverInfo = _bulletWorld.getSolverInfo();
 		solverInfo.m_splitImpulsePenetrationThreshold = 1.0e30f;
 		solverInfo.m_erp2 = 0.8f;
+
+		// Cars read the timestep before the world is stepped, which would otherwise be Bullet's default on the first tick
+		solverInfo.m_timeStep = tickTime;
+	}
+
+	if (_config.carUpdateThreads > 1) {
+		if (_config.useCustomBroadphase) {
+			_carThreading.team = new ThreadTeam(_config.carUpdateThreads);
+		} else {
+			RS_WARN("Arena: ArenaConfig::carUpdateThreads requires useCustomBroadphase, cars will be updated on one thread");
+		}
 	}
 
 	bool loadArenaStuff = gameMode != GameMode::THE_VOID;
@@ -530,9 +564,10 @@ Arena::Arena(GameMode gameMode, const ArenaConfig& config, float tickRate) : _mu
 				pad->_Setup(padConfig);
 
 				_boostPads.push_back(pad);
-				_boostPadGrid.Add(pad);
 			}
 		}
+
+		_boostPadGrid.Build(_boostPads, tickTime);
 	}
 
 	// Set internal tick callback
@@ -645,34 +680,238 @@ Arena* Arena::DeserializeNew(DataStreamIn& in) {
 	return newArena;
 }
 
+ArenaSnapshotBodyState Arena::_GetSnapshotBodyState(const btRigidBody& rigidBody, const Vec& velocityImpulseCache) {
+	ArenaSnapshotBodyState bodyState = {};
+	bodyState.pos = rigidBody.getWorldTransform().getOrigin();
+	bodyState.rotMat = rigidBody.getWorldTransform().getBasis();
+	bodyState.vel = rigidBody.getLinearVelocity();
+	bodyState.angVel = rigidBody.getAngularVelocity();
+	bodyState.velocityImpulseCache = velocityImpulseCache;
+	return bodyState;
+}
+
+void Arena::_SetSnapshotBodyState(btRigidBody& rigidBody, Vec& velocityImpulseCache, const ArenaSnapshotBodyState& bodyState) {
+	// Applied after SetState(), which converted the same values from UU
+	btTransform transform;
+	transform.setOrigin(bodyState.pos);
+	transform.setBasis(bodyState.rotMat);
+	rigidBody.setWorldTransform(transform);
+	rigidBody.setLinearVelocity(bodyState.vel);
+	rigidBody.setAngularVelocity(bodyState.angVel);
+	rigidBody.updateInertiaTensor();
+	velocityImpulseCache = bodyState.velocityImpulseCache;
+}
+
+size_t Arena::GetSnapshotSize() const {
+	return ArenaSnapshotHeader::MakeLayout(_cars.size(), _boostPads.size(), !_worldDropshotTileRBs.empty()).totalSize;
+}
+
+size_t Arena::WriteSnapshot(void* buffer, size_t bufferSize) const {
+	constexpr char ERROR_PREFIX[] = "Arena::WriteSnapshot(): ";
+
+	ArenaSnapshotHeader header = ArenaSnapshotHeader::MakeLayout(_cars.size(), _boostPads.size(), !_worldDropshotTileRBs.empty());
+
+	if (bufferSize < header.totalSize)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Buffer is too small (" << bufferSize << "/" << header.totalSize << " bytes)");
+
+#ifndef RS_MAX_SPEED
+	if ((uintptr_t)buffer % ArenaSnapshotHeader::SECTION_ALIGNMENT != 0)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Buffer is not aligned to " << ArenaSnapshotHeader::SECTION_ALIGNMENT << " bytes");
+#endif
+
+	header.gameMode = gameMode;
+	header.tickTime = tickTime;
+	header.tickCount = tickCount;
+	header.lastCarID = _lastCarID;
+
+	byte* bytes = (byte*)buffer;
+	memcpy(bytes, &header, sizeof(header));
+
+	// Returns the start of a section, zeroing the alignment padding before it
+	size_t writtenEnd = sizeof(header);
+	auto fnBeginSection = [&](uint32_t offset, size_t size) -> byte* {
+		memset(bytes + writtenEnd, 0, offset - writtenEnd);
+		writtenEnd = offset + size;
+		return bytes + offset;
+	};
+
+	{ // Cars
+		byte* carStates = fnBeginSection(header.offsets.carStates, sizeof(CarState) * header.numCars);
+		byte* carBodyStates = fnBeginSection(header.offsets.carBodyStates, sizeof(ArenaSnapshotBodyState) * header.numCars);
+		size_t carWheelStatesSize = sizeof(ArenaSnapshotWheelState) * ArenaSnapshotHeader::WHEELS_PER_CAR * header.numCars;
+		byte* carWheelStates = fnBeginSection(header.offsets.carWheelStates, carWheelStatesSize);
+		memset(carWheelStates, 0, carWheelStatesSize); // For cars with fewer wheels
+		byte* carConfigs = fnBeginSection(header.offsets.carConfigs, sizeof(CarConfig) * header.numCars);
+		byte* carControls = fnBeginSection(header.offsets.carControls, sizeof(CarControls) * header.numCars);
+		byte* carIDs = fnBeginSection(header.offsets.carIDs, sizeof(uint32_t) * header.numCars);
+		byte* carTeams = fnBeginSection(header.offsets.carTeams, sizeof(Team) * header.numCars);
+
+		size_t carIdx = 0;
+		for (Car* car : _cars) {
+			CarState carState = car->GetState();
+			memcpy(carStates + carIdx * sizeof(CarState), &carState, sizeof(CarState));
+			ArenaSnapshotBodyState bodyState = _GetSnapshotBodyState(car->_rigidBody, car->_velocityImpulseCache);
+			memcpy(carBodyStates + carIdx * sizeof(ArenaSnapshotBodyState), &bodyState, sizeof(ArenaSnapshotBodyState));
+			for (int i = 0; i < car->_bulletVehicle.getNumWheels(); i++) {
+				const btWheelInfoRL& wheel = car->_bulletVehicle.m_wheelInfo[i];
+				ArenaSnapshotWheelState wheelState = {};
+				wheelState.engineForce = wheel.m_engineForce;
+				wheelState.brake = wheel.m_brake;
+				wheelState.steerAngle = wheel.m_steerAngle;
+				wheelState.latFriction = wheel.m_latFriction;
+				wheelState.longFriction = wheel.m_longFriction;
+				wheelState.extraPushback = wheel.m_extraPushback;
+				size_t wheelIdx = carIdx * ArenaSnapshotHeader::WHEELS_PER_CAR + i;
+				memcpy(carWheelStates + wheelIdx * sizeof(ArenaSnapshotWheelState), &wheelState, sizeof(ArenaSnapshotWheelState));
+			}
+			memcpy(carConfigs + carIdx * sizeof(CarConfig), &car->config, sizeof(CarConfig));
+			memcpy(carControls + carIdx * sizeof(CarControls), &car->controls, sizeof(CarControls));
+			memcpy(carIDs + carIdx * sizeof(uint32_t), &car->id, sizeof(uint32_t));
+			memcpy(carTeams + carIdx * sizeof(Team), &car->team, sizeof(Team));
+			carIdx++;
+		}
+	}
+
+	{ // Ball
+		BallState ballState = ball->GetState();
+		memcpy(fnBeginSection(header.offsets.ballState, sizeof(BallState)), &ballState, sizeof(BallState));
+		ArenaSnapshotBodyState bodyState = _GetSnapshotBodyState(ball->_rigidBody, ball->_velocityImpulseCache);
+		memcpy(fnBeginSection(header.offsets.ballBodyState, sizeof(ArenaSnapshotBodyState)), &bodyState, sizeof(ArenaSnapshotBodyState));
+	}
+
+	{ // Boost pads
+		byte* padStates = fnBeginSection(header.offsets.boostPadStates, sizeof(BoostPadState) * header.numBoostPads);
+		for (size_t i = 0; i < _boostPads.size(); i++) {
+			BoostPadState padState = _boostPads[i]->GetState();
+			padState.curLockedCar = NULL; // Pointers are meaningless outside of this arena
+			memcpy(padStates + i * sizeof(BoostPadState), &padState, sizeof(BoostPadState));
+		}
+	}
+
+	if (header.hasDropshotTiles)
+		memcpy(fnBeginSection(header.offsets.dropshotTilesState, sizeof(DropshotTilesState)), &_dropshotTilesState, sizeof(DropshotTilesState));
+
+	memcpy(fnBeginSection(header.offsets.mutatorConfig, sizeof(MutatorConfig)), &_mutatorConfig, sizeof(MutatorConfig));
+
+	fnBeginSection(header.totalSize, 0);
+	return header.totalSize;
+}
+
+void Arena::ApplySnapshot(const ArenaSnapshotView& snapshot) {
+	constexpr char ERROR_PREFIX[] = "Arena::ApplySnapshot(): ";
+
+	const ArenaSnapshotHeader& header = *snapshot.header;
+
+#ifndef RS_MAX_SPEED
+	if (header.gameMode != gameMode || header.tickTime != tickTime)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Snapshot is from an arena with a different game mode or tick rate");
+
+	if (header.numBoostPads != _boostPads.size())
+		RS_ERR_CLOSE(ERROR_PREFIX << "Different boost pad amount in snapshot (" << header.numBoostPads << "/" << _boostPads.size() << ")");
+
+	if (header.numCars != _cars.size())
+		RS_ERR_CLOSE(ERROR_PREFIX << "Different car amount in snapshot (" << header.numCars << "/" << _cars.size() << ")");
+#endif
+
+	for (uint32_t i = 0; i < header.numCars; i++) {
+		auto itr = _carIDMap.find(snapshot.carIDs[i]);
+		if (itr == _carIDMap.end())
+			RS_ERR_CLOSE(ERROR_PREFIX << "Snapshot has a car with ID " << snapshot.carIDs[i] << ", which is not in this arena");
+
+		Car* car = itr->second;
+		car->SetState(snapshot.carStates[i]);
+		_SetSnapshotBodyState(car->_rigidBody, car->_velocityImpulseCache, snapshot.carBodyStates[i]);
+		car->_internalState.tickCountSinceUpdate = snapshot.carStates[i].tickCountSinceUpdate;
+		for (int j = 0; j < car->_bulletVehicle.getNumWheels(); j++) {
+			btWheelInfoRL& wheel = car->_bulletVehicle.m_wheelInfo[j];
+			const ArenaSnapshotWheelState& wheelState = snapshot.carWheelStates[i * ArenaSnapshotHeader::WHEELS_PER_CAR + j];
+			wheel.m_engineForce = wheelState.engineForce;
+			wheel.m_brake = wheelState.brake;
+			wheel.m_steerAngle = wheelState.steerAngle;
+			wheel.m_latFriction = wheelState.latFriction;
+			wheel.m_longFriction = wheelState.longFriction;
+			wheel.m_extraPushback = wheelState.extraPushback;
+		}
+		car->controls = snapshot.carControls[i];
+	}
+
+	ball->SetState(*snapshot.ballState);
+	_SetSnapshotBodyState(ball->_rigidBody, ball->_velocityImpulseCache, *snapshot.ballBodyState);
+	ball->_internalState.tickCountSinceUpdate = snapshot.ballState->tickCountSinceUpdate;
+
+	for (size_t i = 0; i < _boostPads.size(); i++)
+		_boostPads[i]->SetState(snapshot.boostPadStates[i]);
+
+	if (snapshot.dropshotTilesState && !_worldDropshotTileRBs.empty())
+		SetDropshotTilesState(*snapshot.dropshotTilesState);
+
+	SetMutatorConfig(*snapshot.mutatorConfig);
+
+	// Contact manifolds carry over between ticks, so they are dropped to continue like any other arena that applies this snapshot
+	_bulletWorldParams.broadphase->resetPool(&_bulletWorldParams.collisionDispatcher);
+
+	tickCount = header.tickCount;
+	_lastCarID = RS_MAX(_lastCarID, header.lastCarID); // Never hand out an ID twice
+}
+
 Arena* Arena::Clone(bool copyCallbacks) {
 	Arena* newArena = new Arena(this->gameMode, this->_config, this->GetTickRate());
-	
+	_CopyDynamicState(newArena, copyCallbacks);
+	return newArena;
+}
+
+Arena* Arena::Fork(bool copyCallbacks) {
+	Arena* newArena = new Arena(this->gameMode, this->_config, this->GetTickRate(), this);
+	_CopyDynamicState(newArena, copyCallbacks);
+	return newArena;
+}
+
+void Arena::_CopyDynamicState(Arena* newArena, bool copyCallbacks) {
 	if (copyCallbacks) {
 		newArena->_goalScoreCallback = this->_goalScoreCallback;
 		newArena->_carBumpCallback = this->_carBumpCallback;
 	}
 
+	newArena->SetMutatorConfig(this->_mutatorConfig);
+
 	newArena->ball->SetState(this->ball->GetState());
 	newArena->ball->_velocityImpulseCache = this->ball->_velocityImpulseCache;
 
-	for (Car* car : this->_cars) {
-		Car* newCar = newArena->AddCar(car->team, car->config);
-		
-		newCar->SetState(car->GetState());
+	// Add cars in the same order as in our bullet world
+	auto& collisionObjects = _bulletWorld.getCollisionObjectArray();
+	for (int i = 0; i < collisionObjects.size(); i++) {
+		if (collisionObjects[i]->getUserIndex() != BT_USERINFO_TYPE_CAR)
+			continue;
+
+		Car* car = (Car*)collisionObjects[i]->getUserPointer();
+
+		// Not using AddCar(), as respawning would use the global random engine
+		Car* newCar = Car::_AllocateCar();
+		newCar->config = car->config;
+		newCar->team = car->team;
 		newCar->id = car->id;
+		newArena->_carIDMap[newCar->id] = newCar;
+		newArena->_cars.insert(newCar);
+
+		newCar->_BulletSetup(gameMode, &newArena->_bulletWorld, newArena->_mutatorConfig);
+		newCar->SetState(car->GetState());
 		newCar->controls = car->controls;
 		newCar->_velocityImpulseCache = car->_velocityImpulseCache;
 	}
 
 	assert(this->_boostPads.size() == newArena->_boostPads.size());
-	for (int i = 0; i < this->_boostPads.size(); i++)
-		newArena->_boostPads[i]->SetState(this->_boostPads[i]->GetState());
+	for (size_t i = 0; i < this->_boostPads.size(); i++) {
+		BoostPadState padState = this->_boostPads[i]->GetState();
+		if (padState.curLockedCar)
+			padState.curLockedCar = newArena->_carIDMap.at(padState.curLockedCar->id);
+		newArena->_boostPads[i]->SetState(padState);
+	}
+
+	if (!_worldDropshotTileRBs.empty())
+		newArena->SetDropshotTilesState(this->_dropshotTilesState);
 
 	newArena->tickCount = this->tickCount;
 	newArena->_lastCarID = this->_lastCarID;
-
-	return newArena;
 }
 
 Car* Arena::DeserializeNewCar(DataStreamIn& in, Team team) {
@@ -705,47 +944,48 @@ void Arena::Step(int ticksToSimulate) {
 
 		bool hasArenaStuff = (gameMode != GameMode::THE_VOID);
 		
-		for (Car* car : _cars)
-			car->_PreTickUpdate(gameMode, tickTime, _mutatorConfig);
-
-		if (hasArenaStuff && !ballOnly) {
-			for (BoostPad* pad : _boostPads)
-				pad->_PreTickUpdate(tickTime);
+		if (_carThreading.team) {
+			_PreTickUpdateCarsThreaded();
+		} else {
+			for (Car* car : _cars)
+				car->_PreTickUpdate(gameMode, tickTime, _mutatorConfig);
 		}
 
+		if (hasArenaStuff && !ballOnly)
+			_boostPadGrid.PreTickUpdate();
+
 		// Update ball
 		ball->_PreTickUpdate(gameMode, tickTime);
 
 		// Update world
 		_bulletWorld.stepSimulation(tickTime, 0, tickTime);
 
-		for (Car* car : _cars) {
-			car->_PostTickUpdate(gameMode, tickTime, _mutatorConfig);
-			car->_FinishPhysicsTick(_mutatorConfig);
-			if (hasArenaStuff) {
-				if (_config.useCustomBoostPads) {
-					// TODO: This is quite slow, we should use a sorting method of some sort
-					for (auto& boostPad : _boostPads) {
-						boostPad->_CheckCollide(car);
-					}
-				} else {
-					_boostPadGrid.CheckCollision(car);
-				}
+		// Post-tick updates only touch their own car, so they can all happen before the boost pad checks
+		if (_carThreading.team) {
+			_PostTickUpdateCarsThreaded();
+		} else {
+			for (Car* car : _cars) {
+				car->_PostTickUpdate(gameMode, tickTime, _mutatorConfig);
+				car->_FinishPhysicsTick(_mutatorConfig);
 			}
 		}
 
+		// Boost pads are shared between cars, so they are always checked in order
+		if (hasArenaStuff) {
+			for (Car* car : _cars)
+				_boostPadGrid.CheckCollision(car);
+		}
+
 		if (hasArenaStuff && !ballOnly)
-			for (BoostPad* pad : _boostPads)
-				pad->_PostTickUpdate(tickTime, _mutatorConfig);
+			_boostPadGrid.PostTickUpdate(_mutatorConfig);
 
 		ball->_FinishPhysicsTick(_mutatorConfig);
 
 		// Sync tiles state after the tick ends.
 		// We don't want to sync the state on tile damage, 
 		//	because that would cause the ball to immediately fall through the newly-broken tile.
-		if (gameMode == GameMode::DROPSHOT)
-			if (ball->_internalState.dsInfo.lastDamageTick && ball->_internalState.dsInfo.lastDamageTick == tickCount)
-				SetDropshotTilesState(_dropshotTilesState);
+		// Only the tiles damaged this tick are updated.
+		_UpdateDropshotTileRBs();
 
 		if (_goalScoreCallback.func != NULL) { // Potentially fire goal score callback
 			if (IsBallScored()) {
@@ -757,6 +997,95 @@ void Arena::Step(int ticksToSimulate) {
 	}
 }
 
+void Arena::_PreTickUpdateCarsThreaded() {
+	auto& ct = _carThreading;
+
+	ct.cars.assign(_cars.begin(), _cars.end());
+	size_t numCars = ct.cars.size();
+
+	bool updateInOrder = numCars < 2;
+	for (Car* car : ct.cars) {
+		// Respawning moves the car and uses the global random engine
+		if (car->_internalState.isDemoed && RS_MAX(car->_internalState.demoRespawnTimer - tickTime, 0) == 0) {
+			updateInOrder = true;
+			break;
+		}
+	}
+
+	if (updateInOrder) {
+		for (Car* car : ct.cars)
+			car->_PreTickUpdate(gameMode, tickTime, _mutatorConfig);
+		return;
+	}
+
+	// A car's update only reads another car if one of its wheel rays hits it (in which case the other car's velocity is read)
+	// Cars that can reach each other are linked, and updated in order on one thread, so the results match updating every car in order
+	ct.reachMins.resize(numCars);
+	ct.reachMaxs.resize(numCars);
+	for (size_t i = 0; i < numCars; i++) {
+		Car* car = ct.cars[i];
+		const btTransform& transform = car->_rigidBody.getWorldTransform();
+		car->_rigidBody.getCollisionShape()->getAabb(transform, ct.reachMins[i], ct.reachMaxs[i]);
+
+		float maxRayReach = 0;
+		for (int j = 0; j < car->_bulletVehicle.getNumWheels(); j++) {
+			const btWheelInfoRL& wheel = car->_bulletVehicle.m_wheelInfo[j];
+			float rayReach =
+				wheel.m_chassisConnectionPointCS.length()
+				+ wheel.getSuspensionRestLength() + (wheel.m_maxSuspensionTravelCm / 100) + wheel.m_wheelsRadius;
+			maxRayReach = RS_MAX(maxRayReach, rayReach);
+		}
+
+		btVector3 rayReachVec = btVector3(maxRayReach, maxRayReach, maxRayReach);
+		ct.reachMins[i].setMin(transform.m_origin - rayReachVec);
+		ct.reachMaxs[i].setMax(transform.m_origin + rayReachVec);
+	}
+
+	ct.independentCars.clear();
+	ct.linkedCars.clear();
+	for (size_t i = 0; i < numCars; i++) {
+		bool linked = false;
+		for (size_t j = 0; j < numCars; j++) {
+			if (i != j && TestAabbAgainstAabb2(ct.reachMins[i], ct.reachMaxs[i], ct.reachMins[j], ct.reachMaxs[j])) {
+				linked = true;
+				break;
+			}
+		}
+
+		if (linked) {
+			ct.linkedCars.push_back(ct.cars[i]);
+		} else {
+			ct.independentCars.push_back(ct.cars[i]);
+		}
+	}
+
+	size_t firstIndependentJob = ct.linkedCars.empty() ? 0 : 1;
+	ct.team->Run(firstIndependentJob + ct.independentCars.size(),
+		[&](size_t jobIndex) {
+			if (jobIndex < firstIndependentJob) {
+				for (Car* car : ct.linkedCars)
+					car->_PreTickUpdate(gameMode, tickTime, _mutatorConfig);
+			} else {
+				ct.independentCars[jobIndex - firstIndependentJob]->_PreTickUpdate(gameMode, tickTime, _mutatorConfig);
+			}
+		}
+	);
+}
+
+void Arena::_PostTickUpdateCarsThreaded() {
+	auto& ct = _carThreading;
+
+	// Post-tick updates only touch their own car
+	ct.cars.assign(_cars.begin(), _cars.end());
+	ct.team->Run(ct.cars.size(),
+		[&](size_t i) {
+			Car* car = ct.cars[i];
+			car->_PostTickUpdate(gameMode, tickTime, _mutatorConfig);
+			car->_FinishPhysicsTick(_mutatorConfig);
+		}
+	);
+}
+
 // Returns negative: within
 // Note that the returned margin is squared
 float BallWithinHoopsGoalXYMarginSq(float x, float y) {
@@ -934,6 +1263,10 @@ Arena::~Arena() {
 	while (_bulletWorld.getNumConstraints() > 0)
 		_bulletWorld.removeConstraint(0);
 
+	// Static proxies don't need to be removed from the grid one by one
+	if (_config.useCustomBroadphase)
+		((btRSBroadphase*)_bulletWorldParams.broadphase)->releaseStaticGrid();
+
 	// Manually remove all collision objects
 	// Otherwise we run into issues regarding deconstruction order
 	while (_bulletWorld.getNumCollisionObjects() > 0)
@@ -955,6 +1288,9 @@ Arena::~Arena() {
 			// Remove all boost pads
 			for (BoostPad* boostPad : _boostPads)
 				delete boostPad;
+		} else {
+			for (BoostPad* boostPad : _boostPads)
+				boostPad->_grid = NULL;
 		}
 	}
 
@@ -963,8 +1299,9 @@ Arena::~Arena() {
 		auto shape = rb->getCollisionShape();
 		
 		bool isBvh = dynamic_cast<btBvhTriangleMeshShape*>(shape);
-		if (isBvh) {
-			// Don't free BVH shapes because we don't own them
+		bool isDropshotTile = (rb->getUserIndex() == BT_USERINFO_TYPE_DROPSHOT_TILE);
+		if (isBvh || isDropshotTile) {
+			// Don't free BVH shapes or dropshot tile shapes because we don't own them
 		} else {
 			delete shape;
 		}
@@ -974,6 +1311,8 @@ Arena::~Arena() {
 
 	delete _bulletWorldParams.overlappingPairCache;
 	delete _bulletWorldParams.broadphase;
+
+	delete _carThreading.team;
 }
 
 btRigidBody* Arena::_AddStaticCollisionShape(btCollisionShape* shape, btVector3 posBT, int group, int mask) {
@@ -1071,7 +1410,7 @@ void Arena::_SetupArenaCollisionShapes() {
 
 	if (isDropShot) {
 		// Add tiles
-		auto tileShapes = DropshotTiles::MakeTileShapes();
+		const auto& tileShapes = DropshotTiles::GetTileShapes();
 		for (int i = 0; i < tileShapes.size(); i++) {
 			int teamIdx = i / RLConst::Dropshot::NUM_TILES_PER_TEAM;
 			int tileIdx = i % RLConst::Dropshot::NUM_TILES_PER_TEAM;
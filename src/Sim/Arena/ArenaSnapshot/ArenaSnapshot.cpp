@@ -0,0 +1,131 @@
+#include <RocketSim/Sim/Arena/ArenaSnapshot/ArenaSnapshot.h>
+
+RS_NS_START
+
+// All state structs are copied into snapshots as raw bytes
+static_assert(std::is_trivially_copyable_v<CarState>);
+static_assert(std::is_trivially_copyable_v<CarConfig>);
+static_assert(std::is_trivially_copyable_v<CarControls>);
+static_assert(std::is_trivially_copyable_v<BallState>);
+static_assert(std::is_trivially_copyable_v<BoostPadState>);
+static_assert(std::is_trivially_copyable_v<DropshotTilesState>);
+static_assert(std::is_trivially_copyable_v<MutatorConfig>);
+static_assert(std::is_trivially_copyable_v<ArenaSnapshotBodyState>);
+static_assert(std::is_trivially_copyable_v<ArenaSnapshotWheelState>);
+
+ArenaSnapshotHeader ArenaSnapshotHeader::MakeLayout(uint32_t numCars, uint32_t numBoostPads, bool hasDropshotTiles) {
+	ArenaSnapshotHeader header = {};
+	header.magic = MAGIC;
+	header.formatVersion = FORMAT_VERSION;
+	header.rocketSimVersion = RS_VERSION_ID;
+
+	header.carStateSize = sizeof(CarState);
+	header.carConfigSize = sizeof(CarConfig);
+	header.carControlsSize = sizeof(CarControls);
+	header.ballStateSize = sizeof(BallState);
+	header.boostPadStateSize = sizeof(BoostPadState);
+	header.mutatorConfigSize = sizeof(MutatorConfig);
+	header.bodyStateSize = sizeof(ArenaSnapshotBodyState);
+	header.wheelStateSize = sizeof(ArenaSnapshotWheelState);
+
+	header.hasDropshotTiles = hasDropshotTiles;
+	header.numCars = numCars;
+	header.numBoostPads = numBoostPads;
+
+	// Offsets are computed in 64 bits, so that huge object counts can't wrap around
+	uint64_t curOffset = sizeof(ArenaSnapshotHeader);
+	auto fnAddSection = [&](uint64_t sectionSize) -> uint32_t {
+		curOffset = (curOffset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+		if (curOffset > UINT32_MAX)
+			RS_ERR_CLOSE("ArenaSnapshotHeader::MakeLayout(): Snapshot of " << numCars << " cars and " << numBoostPads << " boost pads would be too large");
+
+		uint32_t sectionOffset = curOffset;
+		curOffset += sectionSize;
+		return sectionOffset;
+	};
+
+	header.offsets.carStates = fnAddSection((uint64_t)sizeof(CarState) * numCars);
+	header.offsets.carBodyStates = fnAddSection((uint64_t)sizeof(ArenaSnapshotBodyState) * numCars);
+	header.offsets.carWheelStates = fnAddSection((uint64_t)sizeof(ArenaSnapshotWheelState) * WHEELS_PER_CAR * numCars);
+	header.offsets.carConfigs = fnAddSection((uint64_t)sizeof(CarConfig) * numCars);
+	header.offsets.carControls = fnAddSection((uint64_t)sizeof(CarControls) * numCars);
+	header.offsets.carIDs = fnAddSection((uint64_t)sizeof(uint32_t) * numCars);
+	header.offsets.carTeams = fnAddSection((uint64_t)sizeof(Team) * numCars);
+	header.offsets.ballState = fnAddSection(sizeof(BallState));
+	header.offsets.ballBodyState = fnAddSection(sizeof(ArenaSnapshotBodyState));
+	header.offsets.boostPadStates = fnAddSection((uint64_t)sizeof(BoostPadState) * numBoostPads);
+	header.offsets.dropshotTilesState = fnAddSection(hasDropshotTiles ? sizeof(DropshotTilesState) : 0);
+	header.offsets.mutatorConfig = fnAddSection(sizeof(MutatorConfig));
+
+	header.totalSize = fnAddSection(0);
+	return header;
+}
+
+ArenaSnapshotView ArenaSnapshotView::FromBuffer(const void* data, size_t size) {
+	constexpr char ERROR_PREFIX[] = "ArenaSnapshotView::FromBuffer(): ";
+
+	if (size < sizeof(ArenaSnapshotHeader))
+		RS_ERR_CLOSE(ERROR_PREFIX << "Buffer is too small to contain a snapshot header (" << size << " bytes)");
+
+	if ((uintptr_t)data % ArenaSnapshotHeader::SECTION_ALIGNMENT != 0)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Buffer is not aligned to " << ArenaSnapshotHeader::SECTION_ALIGNMENT << " bytes");
+
+	const byte* bytes = (const byte*)data;
+	const ArenaSnapshotHeader* header = (const ArenaSnapshotHeader*)bytes;
+
+	if (header->magic != ArenaSnapshotHeader::MAGIC)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Invalid snapshot (bad magic number)");
+
+	if (header->formatVersion != ArenaSnapshotHeader::FORMAT_VERSION || header->rocketSimVersion != RS_VERSION_ID)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Snapshot was written by a different version " <<
+			"(format: " << header->formatVersion << ", RocketSim: " << header->rocketSimVersion << ")");
+
+	// Read as a byte, as a bool that isn't 0 or 1 is undefined behavior
+	uint8_t hasDropshotTilesByte;
+	memcpy(&hasDropshotTilesByte, &header->hasDropshotTiles, sizeof(hasDropshotTilesByte));
+	if (hasDropshotTilesByte > 1)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Invalid snapshot (bad dropshot tiles flag)");
+
+	// The expected layout is fully determined by the object counts, so compare against that
+	ArenaSnapshotHeader expected = ArenaSnapshotHeader::MakeLayout(header->numCars, header->numBoostPads, header->hasDropshotTiles);
+	if (
+		header->carStateSize != expected.carStateSize || header->carConfigSize != expected.carConfigSize ||
+		header->carControlsSize != expected.carControlsSize || header->ballStateSize != expected.ballStateSize ||
+		header->boostPadStateSize != expected.boostPadStateSize || header->mutatorConfigSize != expected.mutatorConfigSize ||
+		header->bodyStateSize != expected.bodyStateSize || header->wheelStateSize != expected.wheelStateSize ||
+		memcmp(&header->offsets, &expected.offsets, sizeof(expected.offsets)) != 0 ||
+		header->totalSize != expected.totalSize
+		) {
+		RS_ERR_CLOSE(ERROR_PREFIX << "Snapshot layout does not match this build of RocketSim");
+	}
+
+	if (size < header->totalSize)
+		RS_ERR_CLOSE(ERROR_PREFIX << "Buffer is too small for the snapshot (" << size << "/" << header->totalSize << " bytes)");
+
+	ArenaSnapshotView view = {};
+	view.header = header;
+	view.carStates = (const CarState*)(bytes + header->offsets.carStates);
+	view.carBodyStates = (const ArenaSnapshotBodyState*)(bytes + header->offsets.carBodyStates);
+	view.carWheelStates = (const ArenaSnapshotWheelState*)(bytes + header->offsets.carWheelStates);
+	view.carConfigs = (const CarConfig*)(bytes + header->offsets.carConfigs);
+	view.carControls = (const CarControls*)(bytes + header->offsets.carControls);
+	view.carIDs = (const uint32_t*)(bytes + header->offsets.carIDs);
+	view.carTeams = (const Team*)(bytes + header->offsets.carTeams);
+	view.ballState = (const BallState*)(bytes + header->offsets.ballState);
+	view.ballBodyState = (const ArenaSnapshotBodyState*)(bytes + header->offsets.ballBodyState);
+	view.boostPadStates = (const BoostPadState*)(bytes + header->offsets.boostPadStates);
+	if (header->hasDropshotTiles)
+		view.dropshotTilesState = (const DropshotTilesState*)(bytes + header->offsets.dropshotTilesState);
+	view.mutatorConfig = (const MutatorConfig*)(bytes + header->offsets.mutatorConfig);
+	return view;
+}
+
+int ArenaSnapshotView::FindCarIndex(uint32_t carID) const {
+	for (uint32_t i = 0; i < header->numCars; i++)
+		if (carIDs[i] == carID)
+			return i;
+
+	return -1;
+}
+
+RS_NS_END
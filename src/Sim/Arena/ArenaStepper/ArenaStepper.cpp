@@ -0,0 +1,152 @@
+#include <RocketSim/Sim/Arena/ArenaStepper/ArenaStepper.h>
+
+RS_NS_START
+
+// Snapshots are read in place from std::vector<byte> buffers
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= ArenaSnapshotHeader::SECTION_ALIGNMENT);
+
+ArenaStepper::ArenaStepper(const std::vector<Arena*>& arenas, int numThreads) : _arenas(arenas) {
+	for (Arena* arena : _arenas)
+		if (!arena)
+			RS_ERR_CLOSE("ArenaStepper: Arena is NULL");
+
+	_arenaSlots.resize(_arenas.size());
+	for (size_t i = 0; i < _arenas.size(); i++) {
+		Arena* arena = _arenas[i];
+		ArenaSlots& slots = _arenaSlots[i];
+
+		slots.states[0].resize(arena->GetSnapshotSize());
+		arena->WriteSnapshot(slots.states[0].data(), slots.states[0].size());
+
+		for (Car* car : arena->_cars)
+			slots.controls[0].push_back(car->controls);
+		slots.controls[1] = slots.controls[0];
+	}
+
+	if (numThreads > 1 && _arenas.size() > 1)
+		_threadTeam = new ThreadTeam(RS_MIN(numThreads, (int)_arenas.size()));
+
+	_executor = std::thread(&ArenaStepper::_ExecutorLoop, this);
+}
+
+ArenaStepper::~ArenaStepper() {
+	try {
+		Wait();
+	} catch (...) {
+		// Already reported by RS_ERR_CLOSE
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_shouldStop = true;
+	}
+	_jobCV.notify_one();
+	_executor.join();
+
+	delete _threadTeam;
+}
+
+ArenaSnapshotView ArenaStepper::GetStates(size_t arenaIndex) const {
+	const std::vector<byte>& states = _arenaSlots[arenaIndex].states[_finishedStatesSlot.load(std::memory_order_acquire)];
+	return ArenaSnapshotView::FromBuffer(states.data(), states.size());
+}
+
+std::shared_future<void> ArenaStepper::StepAsync(int ticks) {
+	Wait();
+
+	if (ticks < 1)
+		RS_ERR_CLOSE("ArenaStepper::StepAsync(): Invalid tick amount (" << ticks << ")");
+
+	// Hand the controls over to the executor, the caller continues in the other slot
+	_stepControlsSlot = _nextControlsSlot;
+	_nextControlsSlot = 1 - _nextControlsSlot;
+	for (ArenaSlots& slots : _arenaSlots)
+		slots.controls[_nextControlsSlot] = slots.controls[_stepControlsSlot];
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_pendingPromise = std::promise<void>();
+		_inFlight = _pendingPromise.get_future().share();
+		_pendingTicks = ticks;
+	}
+	_jobCV.notify_one();
+
+	return _inFlight;
+}
+
+void ArenaStepper::Wait() {
+	if (_inFlight.valid()) {
+		std::shared_future<void> inFlight = _inFlight;
+		_inFlight = {};
+		inFlight.get();
+	}
+}
+
+bool ArenaStepper::IsStepping() const {
+	return _inFlight.valid() && _inFlight.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void ArenaStepper::_ExecutorLoop() {
+	while (true) {
+		int ticks;
+		std::promise<void> promise;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobCV.wait(lock, [this] { return _pendingTicks > 0 || _shouldStop; });
+			if (_shouldStop)
+				return;
+
+			ticks = _pendingTicks;
+			_pendingTicks = 0;
+			promise = std::move(_pendingPromise);
+		}
+
+		try {
+			_RunStep(ticks);
+			promise.set_value();
+		} catch (...) {
+			promise.set_exception(std::current_exception());
+		}
+	}
+}
+
+void ArenaStepper::_RunStep(int ticks) {
+	int statesSlot = 1 - _finishedStatesSlot.load(std::memory_order_relaxed);
+
+	// Checked up front, as errors can't be thrown from the thread team
+	for (size_t i = 0; i < _arenas.size(); i++) {
+		size_t numControls = _arenaSlots[i].controls[_stepControlsSlot].size();
+		if (numControls != _arenas[i]->_cars.size())
+			RS_ERR_CLOSE(
+				"ArenaStepper::StepAsync(): Controls count for arena " << i << " does not match its car count "
+				"(" << numControls << "/" << _arenas[i]->_cars.size() << ")"
+			);
+	}
+
+	auto fnStepArena = [&](size_t arenaIndex) {
+		Arena* arena = _arenas[arenaIndex];
+		ArenaSlots& slots = _arenaSlots[arenaIndex];
+
+		const std::vector<CarControls>& controls = slots.controls[_stepControlsSlot];
+		size_t carIndex = 0;
+		for (Car* car : arena->_cars)
+			car->controls = controls[carIndex++];
+
+		arena->Step(ticks);
+
+		std::vector<byte>& states = slots.states[statesSlot];
+		states.resize(arena->GetSnapshotSize());
+		arena->WriteSnapshot(states.data(), states.size());
+	};
+
+	if (_threadTeam) {
+		_threadTeam->Run(_arenas.size(), fnStepArena);
+	} else {
+		for (size_t i = 0; i < _arenas.size(); i++)
+			fnStepArena(i);
+	}
+
+	_finishedStatesSlot.store(statesSlot, std::memory_order_release);
+}
+
+RS_NS_END
@@ -5,9 +5,11 @@ RS_NS_START
 
 static Vec g_TilePositions[RLConst::Dropshot::NUM_TILES_PER_TEAM] = {};
 
+// Neighbors of each tile for each radius (from 1 to 3)
 // NOTE: Neighbors include the starting tile
-static std::vector<int> g_TileNeighbors1[RLConst::Dropshot::NUM_TILES_PER_TEAM] = {};
-static std::vector<int> g_TileNeighbors2[RLConst::Dropshot::NUM_TILES_PER_TEAM] = {};
+static std::vector<int> g_TileNeighbors[3][RLConst::Dropshot::NUM_TILES_PER_TEAM] = {};
+
+static std::vector<btCollisionShape*> g_TileShapes = {};
 
 Vec DropshotTiles::GetTilePos(int team, int index) {
 	using namespace RLConst;
@@ -95,8 +97,11 @@ void DropshotTiles::Init() {
 		int maxNeighbors1 = 0, maxNeighbors2 = 0;
 		for (int i = 0; i < Dropshot::NUM_TILES_PER_TEAM; i++) {
 			Vec pos = GetTilePos(0, i);
-			auto& neighborMap1 = g_TileNeighbors1[i];
-			auto& neighborMap2 = g_TileNeighbors2[i];
+			g_TileNeighbors[0][i] = { i };
+			auto& neighborMap1 = g_TileNeighbors[1][i];
+			auto& neighborMap2 = g_TileNeighbors[2][i];
+			neighborMap1.clear();
+			neighborMap2.clear();
 			for (int j = 0; j < Dropshot::NUM_TILES_PER_TEAM; j++) {
 				Vec otherPos = GetTilePos(0, j);
 				if (pos.Dist(otherPos) < NEIGHBOR_MAX_RADIUS)
@@ -112,20 +117,20 @@ void DropshotTiles::Init() {
 		if (maxNeighbors1 > 7 || maxNeighbors2 > 20)
 			RS_ERR_CLOSE("DropshotTiles::Init(): Too high neighbor count, tile placement may be incorrect");
 	}
+
+	if (g_TileShapes.empty())
+		g_TileShapes = MakeTileShapes();
 }
 
-// TODO: Return reference instead of copy
-std::vector<int> DropshotTiles::GetNeighborIndices(int startIdx, int radius) {
+const std::vector<btCollisionShape*>& DropshotTiles::GetTileShapes() {
+	return g_TileShapes;
+}
+
+const std::vector<int>& DropshotTiles::GetNeighborIndices(int startIdx, int radius) {
 	if (radius < 1 || radius > 3)
 		RS_ERR_CLOSE("DropshotTiles::GetNeighborIndices(): Radius must be from 1-3");
 
-	if (radius == 1) {
-		return { startIdx };
-	} else if (radius == 2) {
-		return g_TileNeighbors1[startIdx];
-	} else {
-		return g_TileNeighbors2[startIdx];
-	}
+	return g_TileNeighbors[radius - 1][startIdx];
 }
 
 RS_NS_END
\ No newline at end of file
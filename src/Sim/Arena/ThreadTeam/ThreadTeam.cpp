@@ -0,0 +1,102 @@
+#include <RocketSim/Sim/Arena/ThreadTeam/ThreadTeam.h>
+
+RS_NS_START
+
+// How many times to poll (yielding in between) before sleeping
+constexpr int THREAD_TEAM_SPIN_COUNT = 256;
+
+ThreadTeam::ThreadTeam(int numThreads) {
+	if (numThreads < 1)
+		RS_ERR_CLOSE("ThreadTeam: Invalid thread count " << numThreads << ", must be at least 1");
+
+	_workers.reserve(numThreads - 1);
+	for (int i = 0; i < numThreads - 1; i++)
+		_workers.emplace_back(&ThreadTeam::_WorkerLoop, this);
+}
+
+ThreadTeam::~ThreadTeam() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_shouldStop = true;
+		_generation++;
+	}
+	_startCV.notify_all();
+
+	for (std::thread& worker : _workers)
+		worker.join();
+}
+
+void ThreadTeam::Run(size_t count, const JobFn& fn) {
+	if (count == 0)
+		return;
+
+	if (_workers.empty() || count == 1) {
+		for (size_t i = 0; i < count; i++)
+			fn(i);
+		return;
+	}
+
+	_job = &fn;
+	_jobCount = count;
+	_nextIndex.store(0, std::memory_order_relaxed);
+	_numBusyWorkers.store((int)_workers.size(), std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_generation.fetch_add(1, std::memory_order_release);
+	}
+	_startCV.notify_all();
+
+	_DoWork();
+
+	for (int i = 0; i < THREAD_TEAM_SPIN_COUNT; i++) {
+		if (_numBusyWorkers.load(std::memory_order_acquire) == 0)
+			break;
+		std::this_thread::yield();
+	}
+
+	if (_numBusyWorkers.load(std::memory_order_acquire) != 0) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_doneCV.wait(lock, [this] { return _numBusyWorkers.load(std::memory_order_acquire) == 0; });
+	}
+
+	_job = NULL;
+}
+
+void ThreadTeam::_DoWork() {
+	const JobFn& fn = *_job;
+	while (true) {
+		size_t index = _nextIndex.fetch_add(1, std::memory_order_relaxed);
+		if (index >= _jobCount)
+			break;
+		fn(index);
+	}
+}
+
+void ThreadTeam::_WorkerLoop() {
+	uint64_t lastGeneration = 0;
+	while (true) {
+		for (int i = 0; i < THREAD_TEAM_SPIN_COUNT; i++) {
+			if (_generation.load(std::memory_order_acquire) != lastGeneration)
+				break;
+			std::this_thread::yield();
+		}
+
+		if (_generation.load(std::memory_order_acquire) == lastGeneration) {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startCV.wait(lock, [&] { return _generation.load(std::memory_order_acquire) != lastGeneration; });
+		}
+
+		if (_shouldStop.load(std::memory_order_acquire))
+			return;
+
+		lastGeneration = _generation.load(std::memory_order_acquire);
+		_DoWork();
+
+		if (_numBusyWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_doneCV.notify_one();
+		}
+	}
+}
+
+RS_NS_END
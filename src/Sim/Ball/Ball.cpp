@@ -363,7 +363,7 @@ void Ball::_OnWorldCollision(GameMode gameMode, Vec normal, float tickTime) {
 }
 
 bool Ball::_OnDropshotTileCollision(
-	DropshotTilesState& tilesState, int tileTotalIndex, const btCollisionObject* tileObj,
+	DropshotTilesState& tilesState, DropshotTileMask& changedTiles, int tileTotalIndex, const btCollisionObject* tileObj,
 	uint64_t tickCount, float tickTime
 ) {
 	int teamIdx = tileTotalIndex / RLConst::Dropshot::NUM_TILES_PER_TEAM;
@@ -394,11 +394,13 @@ bool Ball::_OnDropshotTileCollision(
 
 	// Break the tile(s)
 	{
-		std::vector<int> indicesToBreak = DropshotTiles::GetNeighborIndices(tileIdx, dsInfo.chargeLevel);
+		const std::vector<int>& indicesToBreak = DropshotTiles::GetNeighborIndices(tileIdx, dsInfo.chargeLevel);
 		for (int i : indicesToBreak) {
 			DropshotTileState& state = tilesState.states[teamIdx][i];
-			if (state.damageState != DropshotTileState::STATE_BROKEN)
+			if (state.damageState != DropshotTileState::STATE_BROKEN) {
 				state.damageState++;
+				changedTiles.Set(i + (RLConst::Dropshot::NUM_TILES_PER_TEAM * teamIdx));
+			}
 		}
 	}
 	dsInfo.hasDamaged = true;
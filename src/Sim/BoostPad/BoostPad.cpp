@@ -1,4 +1,5 @@
 #include <RocketSim/Sim/BoostPad/BoostPad.h>
+#include <RocketSim/Sim/BoostPad/BoostPadGrid/BoostPadGrid.h>
 #include <RocketSim/RLConst.h>
 #include <bullet3-3.24/BulletDynamics/Dynamics/btRigidBody.h>
 
@@ -47,15 +48,36 @@ void BoostPad::_Setup(const BoostPadConfig& config) {
 	}
 }
 
-void BoostPad::_PreTickUpdate(float tickTime) {
+void BoostPad::SetState(const BoostPadState& state) {
+	_internalState = state;
+	_internalState.isActive = (state.cooldown == 0);
 
-	if (_internalState.cooldown > 0) {
-		_internalState.cooldown = RS_MAX(_internalState.cooldown - tickTime, 0);
+	if (_grid)
+		_grid->_OnPadStateSet(this);
+}
+
+float BoostPad::_GetCooldown() const {
+	float cooldown = _internalState.cooldown;
+	if (!_grid)
+		return cooldown;
+
+	// Same steps as counting down on every tick
+	for (uint64_t tick = _cooldownTick; tick < _grid->cooldownTimers.tick && cooldown > 0; tick++) {
+		float nextCooldown = RS_MAX(cooldown - _grid->tickTime, 0);
+		if (nextCooldown == cooldown)
+			break; // Too large to ever count down
+		cooldown = nextCooldown;
 	}
 
-	_internalState.isActive = (_internalState.cooldown == 0);
+	return cooldown;
+}
+
+void BoostPad::_SyncCooldown() {
+	if (!_grid)
+		return;
 
-	_internalState.curLockedCar = NULL;
+	_internalState.cooldown = _GetCooldown();
+	_cooldownTick = _grid->cooldownTimers.tick;
 }
 
 void BoostPad::_CheckCollide(Car* car) {
@@ -84,7 +106,7 @@ void BoostPad::_CheckCollide(Car* car) {
 		_internalState.curLockedCar = car;
 }
 
-void BoostPad::_PostTickUpdate(float tickTime, const MutatorConfig& mutatorConfig) {
+void BoostPad::_PostTickUpdate(const MutatorConfig& mutatorConfig) {
 	using namespace RLConst::BoostPads;
 
 	uint32_t lockedCarID = 0;
@@ -97,6 +119,8 @@ void BoostPad::_PostTickUpdate(float tickTime, const MutatorConfig& mutatorConfi
 
 			_internalState.isActive = false;
 			_internalState.cooldown = config.isBig ? mutatorConfig.boostPadCooldown_Big : mutatorConfig.boostPadCooldown_Small;
+			if (_grid)
+				_grid->_ScheduleCooldown(this);
 		}
 	}
 
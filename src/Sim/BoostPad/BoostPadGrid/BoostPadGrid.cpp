@@ -2,42 +2,240 @@
 
 RS_NS_START
 
+// Furthest a car's origin can be from a pad (horizontally) while touching it, ignoring the car
+constexpr float PAD_REACH = RS_MAX(RLConst::BoostPads::CYL_RAD_BIG, RLConst::BoostPads::BOX_RAD_BIG);
+
+void BoostPadGrid::Build(const std::vector<BoostPad*>& pads, float tickTime) {
+	this->pads.clear();
+	cellStarts.clear();
+	cellsX = cellsY = 0;
+
+	this->tickTime = tickTime;
+	padsByIdx = pads;
+	lockedPads.clear();
+	prevLockedPads.clear();
+	cooldownTimers.tick = 0;
+	cooldownTimers.Reset(pads.size());
+	for (size_t i = 0; i < pads.size(); i++) {
+		pads[i]->_grid = this;
+		pads[i]->_gridIdx = i;
+		_OnPadStateSet(pads[i]);
+	}
+
+	if (pads.empty())
+		return;
+
+	Vec maxPos = minPos = pads[0]->config.pos;
+	for (BoostPad* pad : pads) {
+		for (int i = 0; i < 3; i++) {
+			minPos[i] = RS_MIN(minPos[i], pad->config.pos[i]);
+			maxPos[i] = RS_MAX(maxPos[i], pad->config.pos[i]);
+		}
+	}
+	minPadZ = minPos.z;
+	maxPadZ = maxPos.z;
+
+	// Cells hold about one pad each on average, but are never much smaller than the area a car can reach
+	float area = (maxPos.x - minPos.x) * (maxPos.y - minPos.y);
+	cellSize = RS_MAX(PAD_REACH * 2, sqrtf(area / pads.size()));
+	invCellSize = 1 / cellSize;
+	cellsX = (int)((maxPos.x - minPos.x) * invCellSize) + 1;
+	cellsY = (int)((maxPos.y - minPos.y) * invCellSize) + 1;
+
+	auto fnGetCellIdx = [&](const Vec& pos) {
+		int i = RS_CLAMP((int)((pos.x - minPos.x) * invCellSize), 0, cellsX - 1);
+		int j = RS_CLAMP((int)((pos.y - minPos.y) * invCellSize), 0, cellsY - 1);
+		return i * cellsY + j;
+	};
+
+	// Counting sort by cell, keeping the order of pads within a cell
+	cellStarts.assign(cellsX * cellsY + 1, 0);
+	for (BoostPad* pad : pads)
+		cellStarts[fnGetCellIdx(pad->config.pos) + 1]++;
+	for (int i = 0; i < cellsX * cellsY; i++)
+		cellStarts[i + 1] += cellStarts[i];
+
+	std::vector<int> cellFill = std::vector<int>(cellStarts.begin(), cellStarts.end() - 1);
+	this->pads.resize(pads.size());
+	for (BoostPad* pad : pads)
+		this->pads[cellFill[fnGetCellIdx(pad->config.pos)]++] = pad;
+
+	size_t numPads = pads.size();
+	for (auto* vals : { &padPosX, &padPosY, &padPosZ, &padCylRadSq, &padBoxMin[0], &padBoxMin[1], &padBoxMin[2], &padBoxMax[0], &padBoxMax[1], &padBoxMax[2] })
+		vals->resize(numPads);
+	padPrevLockedCarIDs.resize(numPads);
+	padColliding.resize(numPads);
+
+	for (size_t i = 0; i < numPads; i++) {
+		const BoostPad* pad = this->pads[i];
+		padPosX[i] = pad->_posBT.x;
+		padPosY[i] = pad->_posBT.y;
+		padPosZ[i] = pad->_posBT.z;
+
+		float rad = (pad->config.isBig ? RLConst::BoostPads::CYL_RAD_BIG : RLConst::BoostPads::CYL_RAD_SMALL) * UU_TO_BT;
+		padCylRadSq[i] = rad * rad;
+
+		for (int j = 0; j < 3; j++) {
+			padBoxMin[j][i] = pad->_boxMinBT[j];
+			padBoxMax[j][i] = pad->_boxMaxBT[j];
+		}
+	}
+}
+
+// Same as BoostPad::_CheckCollide() for pads [start, end)
+void BoostPadGrid::_CheckPadRange(Car* car, int start, int end) {
+	using namespace RLConst::BoostPads;
+
+	uint32_t carID = car->id;
+	btVector3 carPosBT = car->_rigidBody.getWorldTransform().m_origin;
+	float carX = carPosBT.x(), carY = carPosBT.y(), carZ = carPosBT.z();
+	constexpr float CYL_HEIGHT_BT = CYL_HEIGHT * UU_TO_BT;
+
+	int32_t anyLocked = 0;
+	for (int k = start; k < end; k++) {
+		padPrevLockedCarIDs[k] = pads[k]->_internalState.prevLockedCarID;
+		anyLocked |= (padPrevLockedCarIDs[k] == carID);
+	}
+
+	for (int k = start; k < end; k++) {
+		float dx = carX - padPosX[k];
+		float dy = carY - padPosY[k];
+		padColliding[k] = ((dx * dx + dy * dy) < padCylRadSq[k]) & (fabsf(carZ - padPosZ[k]) < CYL_HEIGHT_BT);
+	}
+
+	if (anyLocked) {
+		// Pads that this car was locked to last tick check against its AABB instead
+		btVector3 carMinBT, carMaxBT;
+		car->_rigidBody.getAabb(carMinBT, carMaxBT);
+
+		// TODO: Account for orientation
+		for (int k = start; k < end; k++) {
+			if (padPrevLockedCarIDs[k] != carID)
+				continue;
+
+			int32_t inBox = 1;
+			for (int j = 0; j < 3; j++)
+				inBox &= (padBoxMax[j][k] > carMinBT[j]) & (padBoxMin[j][k] < carMaxBT[j]);
+			padColliding[k] = inBox;
+		}
+	}
+
+	for (int k = start; k < end; k++) {
+		if (padColliding[k]) {
+			BoostPad* pad = pads[k];
+			if (!pad->_internalState.curLockedCar)
+				lockedPads.push_back(pad->_gridIdx);
+			pad->_internalState.curLockedCar = car;
+		}
+	}
+}
+
 void BoostPadGrid::CheckCollision(Car* car) {
+	using namespace RLConst::BoostPads;
+
+	if (pads.empty())
+		return;
+
 	if (car->_internalState.isDemoed || car->_internalState.boost >= RLConst::BOOST_MAX)
 		return;
 
 	Vec carPos = car->_rigidBody.getWorldTransform().m_origin * BT_TO_UU;
 
-	if (carPos.z > EXTENT_Z)
+	// Furthest the car's AABB can stick out from its origin (for pads that check against the AABB)
+	float carAabbReach = (car->config.hitboxSize / 2).Length() + car->config.hitboxPosOffset.Length() + CAR_AABB_MARGIN;
+
+	if (carPos.z > maxPadZ + RS_MAX(CYL_HEIGHT, BOX_HEIGHT + carAabbReach) || carPos.z < minPadZ - RS_MAX(CYL_HEIGHT, carAabbReach))
 		return;
 
-	int indexX = carPos.x / CELL_SIZE_X + (CELLS_X / 2);
-	int indexY = carPos.y / CELL_SIZE_Y + (CELLS_Y / 2);
+	float reach = RS_MAX(PAD_REACH, BOX_RAD_BIG + carAabbReach);
+	int
+		iMin = RS_MAX((int)floorf((carPos.x - reach - minPos.x) * invCellSize), 0),
+		iMax = RS_MIN((int)floorf((carPos.x + reach - minPos.x) * invCellSize), cellsX - 1),
+		jMin = RS_MAX((int)floorf((carPos.y - reach - minPos.y) * invCellSize), 0),
+		jMax = RS_MIN((int)floorf((carPos.y + reach - minPos.y) * invCellSize), cellsY - 1);
 
-	for (int i = RS_MAX(indexX - 1, 0); i <= RS_MIN(indexX + 1, CELLS_X - 1); i++) {
-		for (int j = RS_MAX(indexY - 1, 0); j <= RS_MIN(indexY + 1, CELLS_Y - 1); j++) {
-			BoostPad* pad = pads[i][j];
-			if (pad) {
-				pad->_CheckCollide(car);
-			}
+	if (jMin > jMax)
+		return;
+
+	// The cells of a row are next to each other in pads
+	for (int i = iMin; i <= iMax; i++) {
+		int start = cellStarts[i * cellsY + jMin], end = cellStarts[i * cellsY + jMax + 1];
+		if (start < end)
+			_CheckPadRange(car, start, end);
+	}
+}
+
+void BoostPadGrid::PreTickUpdate() {
+	expiredPads.clear();
+	cooldownTimers.Advance(expiredPads);
+	for (uint32_t padIdx : expiredPads) {
+		BoostPad* pad = padsByIdx[padIdx];
+		pad->_SyncCooldown();
+
+		if (pad->_internalState.cooldown > 0) {
+			_ScheduleCooldown(pad);
+		} else {
+			pad->_internalState.isActive = true;
 		}
 	}
+
+	for (uint32_t padIdx : lockedPads)
+		padsByIdx[padIdx]->_internalState.curLockedCar = NULL;
+	lockedPads.clear();
 }
 
-void BoostPadGrid::Add(BoostPad* pad) {
-	int indexX = pad->config.pos.x / CELL_SIZE_X + (CELLS_X / 2);
-	int indexY = pad->config.pos.y / CELL_SIZE_Y + (CELLS_Y / 2);
+void BoostPadGrid::PostTickUpdate(const MutatorConfig& mutatorConfig) {
+	// Same order as updating every pad, as a car can pick up multiple pads in one tick
+	updatePads = lockedPads;
+	updatePads.insert(updatePads.end(), prevLockedPads.begin(), prevLockedPads.end());
+	std::sort(updatePads.begin(), updatePads.end());
+	updatePads.erase(std::unique(updatePads.begin(), updatePads.end()), updatePads.end());
 
-	BoostPad*& ptrInArray = pads[indexX][indexY];
-	if (ptrInArray != NULL) {
-		RS_ERR_CLOSE(
-			"BoostPadGrid::Add(): Failed to add a boost pad where there already was one " <<
-			"(old: " << ptrInArray->config.pos << ", new: " << pad->config.pos << ") -> " <<
-			"[" << indexX << ", " << indexY << "]"
-		);
-	} else {
-		ptrInArray = pad;
+	for (uint32_t padIdx : updatePads)
+		padsByIdx[padIdx]->_PostTickUpdate(mutatorConfig);
+
+	// Car IDs are never 0, so every locked pad now has a prevLockedCarID
+	prevLockedPads = lockedPads;
+}
+
+void BoostPadGrid::_ScheduleCooldown(BoostPad* pad) {
+	pad->_cooldownTick = cooldownTimers.tick;
+
+	float cooldown = pad->_internalState.cooldown;
+	if (cooldown <= 0 || RS_MAX(cooldown - tickTime, 0) == cooldown) {
+		// Not cooling down, or too large to ever count down (so the pad stays inactive)
+		cooldownTimers.Cancel(pad->_gridIdx);
+		return;
+	}
+
+	// Each step counts down at most a float rounding more than tickTime, so a cooldown of more than COOLDOWN_SYNC_INTERVAL + 1 ticks can't end before the next sync
+	if (cooldown > tickTime * (COOLDOWN_SYNC_INTERVAL + 1)) {
+		cooldownTimers.Schedule(pad->_gridIdx, COOLDOWN_SYNC_INTERVAL);
+		return;
 	}
+
+	// Close to the end, so count the ticks until it reaches 0 with the same steps as BoostPad::_GetCooldown()
+	uint64_t ticks = 0;
+	while (cooldown > 0) {
+		cooldown = RS_MAX(cooldown - tickTime, 0);
+		ticks++;
+	}
+	cooldownTimers.Schedule(pad->_gridIdx, ticks);
+}
+
+void BoostPadGrid::_OnPadStateSet(BoostPad* pad) {
+	_ScheduleCooldown(pad);
+
+	const BoostPadState& state = pad->_internalState;
+	auto fnContains = [](const std::vector<uint32_t>& list, uint32_t padIdx) {
+		return std::find(list.begin(), list.end(), padIdx) != list.end();
+	};
+
+	if (state.curLockedCar && !fnContains(lockedPads, pad->_gridIdx))
+		lockedPads.push_back(pad->_gridIdx);
+
+	if (state.prevLockedCarID && !fnContains(prevLockedPads, pad->_gridIdx))
+		prevLockedPads.push_back(pad->_gridIdx);
 }
 
-RS_NS_END
\ No newline at end of file
+RS_NS_END
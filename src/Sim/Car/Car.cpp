@@ -31,6 +31,16 @@ void Car::SetState(const CarState& state) {
 
 	_velocityImpulseCache = { 0, 0, 0 };
 
+	// Enable or disable the rigidbody like _PreTickUpdate() does, as other cars' wheel rays can check it before this car's update
+	// Otherwise it would keep whatever the car was before this state, and the next tick would depend on that
+	if (state.isDemoed) {
+		_rigidBody.m_activationState1 = DISABLE_SIMULATION;
+		_rigidBody.m_collisionFlags |= btCollisionObject::CF_NO_CONTACT_RESPONSE;
+	} else {
+		_rigidBody.m_activationState1 = ACTIVE_TAG;
+		_rigidBody.m_collisionFlags &= ~btCollisionObject::CF_NO_CONTACT_RESPONSE;
+	}
+
 	_internalState = state;
 	_internalState.tickCountSinceUpdate = 0;
 }
@@ -402,7 +412,8 @@ void Car::_UpdateWheels(float tickTime, const MutatorConfig& mutatorConfig, int
 	}
 
 	{ // Update steering
-		float steerAngle = (config.threeWheels ? STEER_ANGLE_FROM_SPEED_CURVE_THREEWHEEL : STEER_ANGLE_FROM_SPEED_CURVE).GetOutput(absForwardSpeed_UU);
+		float steerAngle = config.threeWheels ?
+			STEER_ANGLE_FROM_SPEED_CURVE_THREEWHEEL.GetOutput(absForwardSpeed_UU) : STEER_ANGLE_FROM_SPEED_CURVE.GetOutput(absForwardSpeed_UU);
 
 		if (_internalState.handbrakeVal) {
 			steerAngle +=
@@ -416,7 +427,10 @@ void Car::_UpdateWheels(float tickTime, const MutatorConfig& mutatorConfig, int
 	}
 
 	{ // Update friction
-		for (int i = 0; i < _bulletVehicle.m_wheelInfo.size(); i++) {
+		// Curve inputs are gathered for all wheels first, so each curve is evaluated for all 4 wheels at once
+		float frictionCurveInputs[4] = {};
+		float contactNormalZs[4] = {};
+		for (int i = 0; i < 4; i++) {
 			auto& wheel = _bulletVehicle.m_wheelInfo[i];
 			if (wheel.m_raycastInfo.m_groundObject) {
 
@@ -428,8 +442,6 @@ void Car::_UpdateWheels(float tickTime, const MutatorConfig& mutatorConfig, int
 					latDir = wheel.m_worldTransform.getBasis().getColumn(1),
 					longDir = latDir.cross(wheel.m_raycastInfo.m_contactNormalWS);
 
-				float frictionCurveInput = 0;
-
 				btVector3 wheelDelta = wheel.m_raycastInfo.m_hardPointWS - _rigidBody.getWorldTransform().m_origin;
 
 				auto crossVec = (angularVel.cross(wheelDelta) + vel) * BT_TO_UU;
@@ -438,33 +450,50 @@ void Car::_UpdateWheels(float tickTime, const MutatorConfig& mutatorConfig, int
 
 				// Significant friction results in lateral slip
 				if (baseFriction > 5)
-					frictionCurveInput = baseFriction / (abs(crossVec.dot(longDir)) + baseFriction);
+					frictionCurveInputs[i] = baseFriction / (abs(crossVec.dot(longDir)) + baseFriction);
 
-				float latFriction = (config.threeWheels ? LAT_FRICTION_CURVE_THREEWHEEL : LAT_FRICTION_CURVE).GetOutput(frictionCurveInput);
-				float longFriction = LONG_FRICTION_CURVE.GetOutput(frictionCurveInput);
+				contactNormalZs[i] = wheel.m_raycastInfo.m_contactNormalWS.z();
+			}
+		}
 
-				if (_internalState.handbrakeVal) {
-					float handbrakeAmount = _internalState.handbrakeVal;
+		float latFrictions[4], longFrictions[4];
+		(config.threeWheels ? LAT_FRICTION_CURVE_THREEWHEEL : LAT_FRICTION_CURVE).GetOutput4(frictionCurveInputs, latFrictions);
+		LONG_FRICTION_CURVE.GetOutput4(frictionCurveInputs, longFrictions);
 
-					latFriction *= (HANDBRAKE_LAT_FRICTION_FACTOR_CURVE.GetOutput(frictionCurveInput) - 1) * handbrakeAmount + 1;
-					longFriction *= (HANDBRAKE_LONG_FRICTION_FACTOR_CURVE.GetOutput(frictionCurveInput) - 1) * handbrakeAmount + 1;
-				} else {
-					longFriction = 1; // If we aren't powersliding, it's not scaled down
-				}
+		if (_internalState.handbrakeVal) {
+			float handbrakeAmount = _internalState.handbrakeVal;
+
+			float latFactors[4], longFactors[4];
+			HANDBRAKE_LAT_FRICTION_FACTOR_CURVE.GetOutput4(frictionCurveInputs, latFactors);
+			HANDBRAKE_LONG_FRICTION_FACTOR_CURVE.GetOutput4(frictionCurveInputs, longFactors);
+			for (int i = 0; i < 4; i++) {
+				latFrictions[i] *= (latFactors[i] - 1) * handbrakeAmount + 1;
+				longFrictions[i] *= (longFactors[i] - 1) * handbrakeAmount + 1;
+			}
+		} else {
+			for (int i = 0; i < 4; i++)
+				longFrictions[i] = 1; // If we aren't powersliding, it's not scaled down
+		}
 
-				bool isContactSticky = realThrottle != 0;
+		bool isContactSticky = realThrottle != 0;
 
-				if (isContactSticky) {
-					// Keep current friction values
-				} else {
-					// Scale friction down with non-sticky friction curve
-					float nonStickyScale = NON_STICKY_FRICTION_FACTOR_CURVE.GetOutput(wheel.m_raycastInfo.m_contactNormalWS.z());
-					latFriction *= nonStickyScale;
-					longFriction *= nonStickyScale;
-				}
+		if (isContactSticky) {
+			// Keep current friction values
+		} else {
+			// Scale friction down with non-sticky friction curve
+			float nonStickyScales[4];
+			NON_STICKY_FRICTION_FACTOR_CURVE.GetOutput4(contactNormalZs, nonStickyScales);
+			for (int i = 0; i < 4; i++) {
+				latFrictions[i] *= nonStickyScales[i];
+				longFrictions[i] *= nonStickyScales[i];
+			}
+		}
 
-				wheel.m_latFriction = latFriction;
-				wheel.m_longFriction = longFriction;
+		for (int i = 0; i < 4; i++) {
+			auto& wheel = _bulletVehicle.m_wheelInfo[i];
+			if (wheel.m_raycastInfo.m_groundObject) {
+				wheel.m_latFriction = latFrictions[i];
+				wheel.m_longFriction = longFrictions[i];
 			}
 		}
 	}
@@ -0,0 +1,225 @@
+#include <RocketSim/Sim/CompactState/CompactState.h>
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define RS_COMPACT_STATE_SIMD
+#include <immintrin.h>
+#endif
+
+RS_NS_START
+
+namespace CompactState {
+
+	constexpr float QUAT_COMPONENT_MAX = 0.70710678f; // 1/sqrt(2), no smaller component can be larger than this
+	constexpr uint32_t QUAT_COMPONENT_BITS = 10;
+	constexpr uint32_t QUAT_COMPONENT_RANGE = (1 << QUAT_COMPONENT_BITS) - 1;
+
+	static void CheckConfig(const Config& config) {
+		if (!(config.posStep > 0 && config.velStep > 0 && config.angVelStep > 0 && config.timeStep > 0))
+			RS_ERR_CLOSE("CompactState: Invalid config, all step sizes must be positive");
+	}
+
+	// Rounds to the nearest integer, with halfway values rounded to even (like the SIMD path, see QuantizeVec())
+	inline float Round(float val) {
+		return nearbyintf(val);
+	}
+
+	// Quantizes x, y, and z of vec to out[0-2]
+	inline void QuantizeVec(const Vec& vec, float invStep, int16_t* out) {
+#ifdef RS_COMPACT_STATE_SIMD
+		__m128 scaled = _mm_mul_ps(_mm_load_ps(&vec.x), _mm_set1_ps(invStep));
+		scaled = _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(-INT16_MAX)), _mm_set1_ps(INT16_MAX));
+		__m128i ints = _mm_cvtps_epi32(_mm_round_ps(scaled, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		__m128i packed = _mm_packs_epi32(ints, ints);
+
+		int32_t xy = _mm_cvtsi128_si32(packed);
+		memcpy(out, &xy, sizeof(xy));
+		out[2] = (int16_t)_mm_extract_epi16(packed, 2);
+#else
+		for (int i = 0; i < 3; i++) {
+			float scaled = RS_CLAMP(vec[i] * invStep, -INT16_MAX, INT16_MAX);
+			out[i] = (int16_t)Round(scaled);
+		}
+#endif
+	}
+
+	// Dequantizes in[0-2] to x, y, and z
+	inline Vec DequantizeVec(const int16_t* in, float step) {
+#ifdef RS_COMPACT_STATE_SIMD
+		int32_t xy;
+		memcpy(&xy, in, sizeof(xy));
+		__m128i ints = _mm_cvtepi16_epi32(_mm_insert_epi16(_mm_cvtsi32_si128(xy), in[2], 2));
+		__m128 result = _mm_mul_ps(_mm_cvtepi32_ps(ints), _mm_set1_ps(step));
+		Vec vec;
+		_mm_store_ps(&vec.x, result);
+		return vec;
+#else
+		return Vec(in[0] * step, in[1] * step, in[2] * step);
+#endif
+	}
+
+	inline uint16_t QuantizeTime(float time, float invStep) {
+		float scaled = Round(time * invStep);
+		return (uint16_t)RS_CLAMP(scaled, 0, UINT16_MAX);
+	}
+
+	// Smallest-three quaternion encoding:
+	// The largest component is dropped (and recomputed from the other three on decode), its sign is made positive by negating the quaternion
+	uint32_t EncodeRotation(const RotMat& rotMat) {
+		btQuaternion quat;
+		((btMatrix3x3)rotMat).getRotation(quat);
+		float comps[4] = { quat.x(), quat.y(), quat.z(), quat.w() };
+
+		uint32_t largestIdx = 0;
+		for (uint32_t i = 1; i < 4; i++)
+			if (fabsf(comps[i]) > fabsf(comps[largestIdx]))
+				largestIdx = i;
+
+		float sign = (comps[largestIdx] < 0) ? -1 : 1;
+
+		uint32_t result = largestIdx << (QUAT_COMPONENT_BITS * 3);
+		uint32_t shift = QUAT_COMPONENT_BITS * 2;
+		for (uint32_t i = 0; i < 4; i++) {
+			if (i == largestIdx)
+				continue;
+
+			float normalized = (comps[i] * sign / QUAT_COMPONENT_MAX) * 0.5f + 0.5f;
+			float scaled = Round(normalized * QUAT_COMPONENT_RANGE);
+			result |= (uint32_t)RS_CLAMP(scaled, 0, QUAT_COMPONENT_RANGE) << shift;
+			shift -= QUAT_COMPONENT_BITS;
+		}
+
+		return result;
+	}
+
+	RotMat DecodeRotation(uint32_t rot) {
+		uint32_t largestIdx = rot >> (QUAT_COMPONENT_BITS * 3);
+
+		float comps[4];
+		float sumSq = 0;
+		uint32_t shift = QUAT_COMPONENT_BITS * 2;
+		for (uint32_t i = 0; i < 4; i++) {
+			if (i == largestIdx)
+				continue;
+
+			uint32_t val = (rot >> shift) & QUAT_COMPONENT_RANGE;
+			comps[i] = ((val / (float)QUAT_COMPONENT_RANGE) * 2 - 1) * QUAT_COMPONENT_MAX;
+			sumSq += comps[i] * comps[i];
+			shift -= QUAT_COMPONENT_BITS;
+		}
+		comps[largestIdx] = sqrtf(RS_MAX(1 - sumSq, 0));
+
+		btQuaternion quat = btQuaternion(comps[0], comps[1], comps[2], comps[3]);
+		quat.normalize();
+		return RotMat(btMatrix3x3(quat));
+	}
+
+	inline void EncodePhys(const PhysState& state, CompactPhysState& out, const Config& config) {
+		QuantizeVec(state.pos, 1 / config.posStep, out.pos);
+		QuantizeVec(state.vel, 1 / config.velStep, out.vel);
+		QuantizeVec(state.angVel, 1 / config.angVelStep, out.angVel);
+		out._padding = 0;
+		out.rot = EncodeRotation(state.rotMat);
+	}
+
+	inline void DecodePhys(const CompactPhysState& compactState, PhysState& out, const Config& config) {
+		out.pos = DequantizeVec(compactState.pos, config.posStep);
+		out.vel = DequantizeVec(compactState.vel, config.velStep);
+		out.angVel = DequantizeVec(compactState.angVel, config.angVelStep);
+		out.rotMat = DecodeRotation(compactState.rot);
+	}
+
+	uint16_t GetCarFlags(const CarState& state) {
+		uint16_t flags =
+			(state.isOnGround ? CAR_FLAG_ON_GROUND : 0) |
+			(state.hasJumped ? CAR_FLAG_HAS_JUMPED : 0) |
+			(state.hasDoubleJumped ? CAR_FLAG_HAS_DOUBLE_JUMPED : 0) |
+			(state.hasFlipped ? CAR_FLAG_HAS_FLIPPED : 0) |
+			(state.isFlipping ? CAR_FLAG_IS_FLIPPING : 0) |
+			(state.isJumping ? CAR_FLAG_IS_JUMPING : 0) |
+			(state.isBoosting ? CAR_FLAG_IS_BOOSTING : 0) |
+			(state.isSupersonic ? CAR_FLAG_IS_SUPERSONIC : 0) |
+			(state.isAutoFlipping ? CAR_FLAG_IS_AUTO_FLIPPING : 0) |
+			(state.isDemoed ? CAR_FLAG_IS_DEMOED : 0) |
+			(state.worldContact.hasContact ? CAR_FLAG_WORLD_CONTACT : 0);
+		for (int i = 0; i < 4; i++)
+			if (state.wheelsWithContact[i])
+				flags |= CAR_FLAG_WHEEL_CONTACT_FIRST << i;
+		return flags;
+	}
+
+	void EncodeCars(const CarState* states, size_t count, CompactCarState* out, const Config& config) {
+		CheckConfig(config);
+		float invTimeStep = 1 / config.timeStep;
+
+		for (size_t i = 0; i < count; i++) {
+			const CarState& state = states[i];
+			CompactCarState& compactState = out[i];
+
+			EncodePhys(state, compactState.phys, config);
+
+			compactState.flags = GetCarFlags(state);
+
+			float scaledBoost = Round(state.boost * (255 / 100.f));
+			compactState.boost = (uint8_t)RS_CLAMP(scaledBoost, 0, 255);
+
+			for (int j = 0; j < 2; j++) {
+				float scaledTorque = Round(state.flipRelTorque[j] * 127);
+				compactState.flipRelTorque[j] = (int8_t)RS_CLAMP(scaledTorque, -127, 127);
+			}
+			compactState._padding = 0;
+
+			compactState.jumpTime = QuantizeTime(state.jumpTime, invTimeStep);
+			compactState.flipTime = QuantizeTime(state.flipTime, invTimeStep);
+			compactState.airTimeSinceJump = QuantizeTime(state.airTimeSinceJump, invTimeStep);
+			compactState.demoRespawnTimer = QuantizeTime(state.demoRespawnTimer, invTimeStep);
+		}
+	}
+
+	void DecodeCars(const CompactCarState* compactStates, size_t count, CarState* out, const Config& config) {
+		CheckConfig(config);
+
+		for (size_t i = 0; i < count; i++) {
+			const CompactCarState& compactState = compactStates[i];
+			CarState& state = out[i];
+
+			DecodePhys(compactState.phys, state, config);
+
+			uint16_t flags = compactState.flags;
+			state.isOnGround = flags & CAR_FLAG_ON_GROUND;
+			state.hasJumped = flags & CAR_FLAG_HAS_JUMPED;
+			state.hasDoubleJumped = flags & CAR_FLAG_HAS_DOUBLE_JUMPED;
+			state.hasFlipped = flags & CAR_FLAG_HAS_FLIPPED;
+			state.isFlipping = flags & CAR_FLAG_IS_FLIPPING;
+			state.isJumping = flags & CAR_FLAG_IS_JUMPING;
+			state.isBoosting = flags & CAR_FLAG_IS_BOOSTING;
+			state.isSupersonic = flags & CAR_FLAG_IS_SUPERSONIC;
+			state.isAutoFlipping = flags & CAR_FLAG_IS_AUTO_FLIPPING;
+			state.isDemoed = flags & CAR_FLAG_IS_DEMOED;
+			state.worldContact.hasContact = flags & CAR_FLAG_WORLD_CONTACT;
+			for (int j = 0; j < 4; j++)
+				state.wheelsWithContact[j] = flags & (CAR_FLAG_WHEEL_CONTACT_FIRST << j);
+
+			state.boost = compactState.boost * (100 / 255.f);
+			state.flipRelTorque = Vec(compactState.flipRelTorque[0] / 127.f, compactState.flipRelTorque[1] / 127.f, 0);
+
+			state.jumpTime = compactState.jumpTime * config.timeStep;
+			state.flipTime = compactState.flipTime * config.timeStep;
+			state.airTimeSinceJump = compactState.airTimeSinceJump * config.timeStep;
+			state.demoRespawnTimer = compactState.demoRespawnTimer * config.timeStep;
+		}
+	}
+
+	void EncodeBalls(const BallState* states, size_t count, CompactBallState* out, const Config& config) {
+		CheckConfig(config);
+		for (size_t i = 0; i < count; i++)
+			EncodePhys(states[i], out[i].phys, config);
+	}
+
+	void DecodeBalls(const CompactBallState* compactStates, size_t count, BallState* out, const Config& config) {
+		CheckConfig(config);
+		for (size_t i = 0; i < count; i++)
+			DecodePhys(compactStates[i].phys, out[i], config);
+	}
+}
+
+RS_NS_END
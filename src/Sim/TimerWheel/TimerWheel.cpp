@@ -0,0 +1,56 @@
+#include <RocketSim/Sim/TimerWheel/TimerWheel.h>
+
+RS_NS_START
+
+void TimerWheel::Reset(size_t numIDs) {
+	for (auto& slot : _slots)
+		slot.clear();
+	_expiryTicks.assign(numIDs, NO_TIMER);
+}
+
+void TimerWheel::Schedule(uint32_t id, uint64_t delayTicks) {
+	assert(delayTicks > 0);
+
+	Cancel(id);
+
+	uint64_t expiryTick = tick + delayTicks;
+	_expiryTicks[id] = expiryTick;
+	_slots[GetSlot(expiryTick)].push_back({ expiryTick, id });
+}
+
+void TimerWheel::Cancel(uint32_t id) {
+	uint64_t expiryTick = _expiryTicks[id];
+	if (expiryTick == NO_TIMER)
+		return;
+
+	// Erasing (instead of swapping the last entry in) keeps the scheduling order
+	auto& slot = _slots[GetSlot(expiryTick)];
+	for (size_t i = 0; i < slot.size(); i++) {
+		if (slot[i].id == id) {
+			slot.erase(slot.begin() + i);
+			break;
+		}
+	}
+
+	_expiryTicks[id] = NO_TIMER;
+}
+
+void TimerWheel::Advance(std::vector<uint32_t>& expiredIDs) {
+	tick++;
+
+	auto& slot = _slots[GetSlot(tick)];
+	size_t numKept = 0;
+	for (size_t i = 0; i < slot.size(); i++) {
+		Entry entry = slot[i];
+		if (entry.expiryTick == tick) {
+			expiredIDs.push_back(entry.id);
+			_expiryTicks[entry.id] = NO_TIMER;
+		} else {
+			// Expires on a later rotation
+			slot[numKept++] = entry;
+		}
+	}
+	slot.resize(numKept);
+}
+
+RS_NS_END
@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+
+#include <bullet3-3.24/BulletCollision/BroadphaseCollision/btRSBroadphase.h>
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures car-sized AABB queries (triggers, region checks) against the custom broadphase, with few and many cars in the arena
+RS_BENCHMARK(AabbTest) {
+	constexpr int ITERATIONS = 1000 * 1000;
+	constexpr int NUM_BOXES = 1024;
+	constexpr float BOX_HALF_SIZE = 150;
+
+	std::vector<std::pair<btVector3, btVector3>> boxes;
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float>
+		distX(-4000, 4000), distY(-5000, 5000), distZ(0, 2000);
+	for (int i = 0; i < NUM_BOXES; i++) {
+		btVector3 center = btVector3(distX(rng), distY(rng), distZ(rng));
+		btVector3 halfSize = btVector3(BOX_HALF_SIZE, BOX_HALF_SIZE, BOX_HALF_SIZE);
+		boxes.push_back({ (center - halfSize) * UU_TO_BT, (center + halfSize) * UU_TO_BT });
+	}
+
+	for (int numCars : { 4, 64 }) {
+		Arena* arena = Arena::Create(GameMode::SOCCAR);
+		for (int i = 0; i < numCars; i++) {
+			Car* car = arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+			CarState carState = {};
+			carState.pos = Vec(distX(rng), distY(rng), 17);
+			car->SetState(carState);
+		}
+		arena->Step();
+
+		auto broadphase = (btRSBroadphase*)arena->_bulletWorldParams.broadphase;
+
+		volatile int sink = 0;
+		Benchmark::Time(std::to_string(numCars) + " cars", ITERATIONS,
+			[&](int i) {
+				auto& box = boxes[i % NUM_BOXES];
+				btBroadphaseProxy* results[64];
+				sink = broadphase->aabbQuery(box.first, box.second, results, 64);
+			}
+		);
+
+		delete arena;
+	}
+}
@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures simulation cost that is dominated by queries against the arena collision meshes
+// See the MeshLayout benchmark for the effect of CollisionMeshFile::SortForLocality() alone
+RS_BENCHMARK(ArenaMeshes) {
+	constexpr int TICKS = 20 * 1000;
+	constexpr int RELAUNCH_INTERVAL = 90;
+
+	for (GameMode gameMode : { GameMode::SOCCAR, GameMode::HOOPS }) {
+		if (GetArenaCollisionShapes(gameMode).empty())
+			continue;
+
+		Arena* arena = Arena::Create(gameMode);
+		for (int i = 0; i < 4; i++)
+			arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+
+		std::mt19937 rng(0);
+		std::uniform_real_distribution<float> dist(-1, 1);
+
+		Benchmark::Time(std::string(GAMEMODE_STRS[(int)gameMode]) + " ball and cars against walls", TICKS,
+			[&](int tick) {
+				if (tick % RELAUNCH_INTERVAL == 0) {
+					// Throw the ball at a random part of the arena so it keeps hitting the curved walls and corners
+					BallState ballState = {};
+					ballState.pos = Vec(dist(rng) * 2000, dist(rng) * 3000, 300 + (dist(rng) + 1) * 400);
+					ballState.vel = Vec(dist(rng), dist(rng), dist(rng) * 0.3f).Normalized() * RLConst::BALL_MAX_SPEED;
+					ballState.angVel = Vec(dist(rng), dist(rng), dist(rng)) * 5;
+					arena->ball->SetState(ballState);
+
+					for (Car* car : arena->GetCars()) {
+						car->controls.throttle = 1;
+						car->controls.boost = true;
+						car->controls.steer = dist(rng);
+						car->controls.jump = dist(rng) > 0.8f;
+					}
+				}
+
+				arena->Step(1);
+			}
+		);
+
+		delete arena;
+	}
+}
@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures a giant custom map (a flat floor in the void) with many cars driving around,
+//	with the dense and sparse custom broadphase grids and with bullet's dbvt broadphase
+RS_BENCHMARK(BigMap) {
+	constexpr int CREATE_ITERATIONS = 5;
+	constexpr int TICKS = 2000;
+	constexpr int NUM_CARS = 64;
+	constexpr float MAP_EXTENT = 50 * 1000;
+
+	struct Setup {
+		const char* name;
+		bool useCustomBroadphase, useSparseBroadphaseGrid;
+	};
+
+	for (Setup setup : { Setup{ "Dense grid", true, false }, Setup{ "Sparse grid", true, true }, Setup{ "Dbvt", false, false } }) {
+		ArenaConfig arenaConfig = {};
+		arenaConfig.minPos = Vec(-MAP_EXTENT, -MAP_EXTENT, -1000);
+		arenaConfig.maxPos = Vec(MAP_EXTENT, MAP_EXTENT, 9000);
+		arenaConfig.useCustomBroadphase = setup.useCustomBroadphase;
+		arenaConfig.useSparseBroadphaseGrid = setup.useSparseBroadphaseGrid;
+
+		Benchmark::Time(std::string(setup.name) + " Arena::Create() + delete", CREATE_ITERATIONS,
+			[&](int) {
+				delete Arena::Create(GameMode::THE_VOID, arenaConfig);
+			}
+		);
+
+		Arena* arena = Arena::Create(GameMode::THE_VOID, arenaConfig);
+
+		// Floor covering the whole map
+		btBoxShape floorShape = btBoxShape(btVector3(MAP_EXTENT, MAP_EXTENT, 100) * UU_TO_BT);
+		btRigidBody floorRB = btRigidBody(btRigidBody::btRigidBodyConstructionInfo(0, NULL, &floorShape));
+		floorRB.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), btVector3(0, 0, -100) * UU_TO_BT));
+		arena->_bulletWorld.addRigidBody(&floorRB);
+
+		// Cars are spread across a few far apart groups
+		std::mt19937 rng(0);
+		std::uniform_real_distribution<float> dist(-1, 1);
+		for (int i = 0; i < NUM_CARS; i++) {
+			Car* car = arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+			Vec groupPos = Vec(((i % 4) - 1.5f) * MAP_EXTENT * 0.5f, ((i / 4 % 4) - 1.5f) * MAP_EXTENT * 0.5f, 0);
+
+			CarState carState = {};
+			carState.pos = groupPos + Vec(dist(rng) * 1000, dist(rng) * 1000, 17);
+			car->SetState(carState);
+			car->controls.throttle = 1;
+			car->controls.steer = dist(rng);
+		}
+
+		Benchmark::Time(std::string(setup.name) + " Arena::Step()", TICKS,
+			[&](int) {
+				arena->Step();
+			}
+		);
+
+		delete arena;
+	}
+}
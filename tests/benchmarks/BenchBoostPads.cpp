@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures boost pad pickup checks with the standard soccar pads and big custom pad layouts (spread out and packed together),
+//	through the boost pad grid and by checking every pad, and the whole boost pad part of a tick (including pickups and cooldowns)
+RS_BENCHMARK(BoostPads) {
+	constexpr int ITERATIONS = 100 * 1000;
+	constexpr int NUM_CARS = 8;
+
+	struct Layout {
+		const char* name;
+		int numPads; // 0 for the standard pads
+		float extent; // Half-size of the area that pads and cars are placed in
+	};
+
+	for (Layout layout : { Layout{ "Standard pads", 0, 4000 }, Layout{ "256 spread out pads", 256, 4000 }, Layout{ "256 packed pads", 256, 600 } }) {
+		std::mt19937 rng(0);
+		std::uniform_real_distribution<float> dist(-layout.extent, layout.extent);
+
+		ArenaConfig arenaConfig = {};
+		arenaConfig.useCustomBoostPads = layout.numPads > 0;
+		for (int i = 0; i < layout.numPads; i++)
+			arenaConfig.customBoostPads.push_back({ Vec(dist(rng), dist(rng) * 1.25f, 70), (i % 8) == 0 });
+
+		Arena* arena = Arena::Create(GameMode::SOCCAR, arenaConfig);
+		for (int i = 0; i < NUM_CARS; i++) {
+			Car* car = arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+			CarState carState = {};
+			carState.pos = Vec(dist(rng), dist(rng) * 1.25f, 17);
+			carState.boost = 0;
+			car->SetState(carState);
+		}
+
+		Benchmark::Time(std::string(layout.name) + ", BoostPadGrid::CheckCollision() (all cars)", ITERATIONS,
+			[&](int) {
+				for (Car* car : arena->GetCars())
+					arena->_boostPadGrid.CheckCollision(car);
+			}
+		);
+
+		Benchmark::Time(std::string(layout.name) + ", boost pad tick update (all cars)", ITERATIONS,
+			[&](int i) {
+				// Keep picking up pads
+				if (i % 1000 == 0)
+					for (Car* car : arena->GetCars())
+						car->_internalState.boost = 0;
+
+				arena->_boostPadGrid.PreTickUpdate();
+				for (Car* car : arena->GetCars())
+					arena->_boostPadGrid.CheckCollision(car);
+				arena->_boostPadGrid.PostTickUpdate(arena->_mutatorConfig);
+			}
+		);
+
+		Benchmark::Time(std::string(layout.name) + ", BoostPad::_CheckCollide() (all cars and pads)", ITERATIONS,
+			[&](int) {
+				for (Car* car : arena->GetCars())
+					for (BoostPad* pad : arena->_boostPads)
+						pad->_CheckCollide(car);
+			}
+		);
+
+		delete arena;
+	}
+}
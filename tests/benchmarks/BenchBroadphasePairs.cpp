@@ -0,0 +1,39 @@
+#include "Benchmark.h"
+
+using namespace RocketSim;
+
+// Measures stepping an arena where many cars stay in contact with each other and the ball,
+//	so most broadphase pairs persist from tick to tick
+RS_BENCHMARK(BroadphasePairs) {
+	constexpr int ITERATIONS = 20 * 1000;
+	constexpr int NUM_CARS = 16;
+
+	Arena* arena = Arena::Create(GameMode::SOCCAR);
+	for (int i = 0; i < NUM_CARS; i++) {
+		Car* car = arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+		CarState carState = {};
+		carState.pos = Vec((i % 4) * 130 - 200, (i / 4) * 130 - 200, 17);
+		car->SetState(carState);
+	}
+
+	BallState ballState = {};
+	ballState.pos = Vec(0, 0, 300);
+	arena->ball->SetState(ballState);
+
+	Benchmark::Time("Arena::Step() (clustered cars)", ITERATIONS,
+		[&](int) {
+			arena->Step();
+		}
+	);
+
+	// Only the broadphase pair update, with nothing moving between calls
+	btBroadphaseInterface* broadphase = arena->_bulletWorld.getBroadphase();
+	btCollisionDispatcher* dispatcher = &arena->_bulletWorldParams.collisionDispatcher;
+	Benchmark::Time("calculateOverlappingPairs()", ITERATIONS,
+		[&](int) {
+			broadphase->calculateOverlappingPairs(dispatcher);
+		}
+	);
+
+	delete arena;
+}
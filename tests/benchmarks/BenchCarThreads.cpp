@@ -0,0 +1,52 @@
+#include "Benchmark.h"
+
+#include <random>
+#include <thread>
+
+using namespace RocketSim;
+
+// Measures Arena::Step() with many cars per arena, for different ArenaConfig::carUpdateThreads values
+RS_BENCHMARK(CarThreads) {
+	constexpr int TICKS = 5 * 1000;
+	constexpr int CONTROLS_INTERVAL = 30;
+
+	int maxThreads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+
+	for (int numCars : { 16, 64 }) {
+		for (int numThreads = 1; numThreads <= maxThreads && numThreads <= 8; numThreads *= 2) {
+			ArenaConfig arenaConfig = {};
+			arenaConfig.carUpdateThreads = numThreads;
+			Arena* arena = Arena::Create(GameMode::SOCCAR, arenaConfig);
+
+			for (int i = 0; i < numCars; i++) {
+				Car* car = arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+
+				// Spread cars out in a grid
+				CarState carState = {};
+				carState.pos = Vec((i % 8) * 500 - 1750, (i / 8) * 600 - 2400, RLConst::CAR_SPAWN_REST_Z);
+				car->SetState(carState);
+			}
+
+			std::mt19937 rng(0);
+			std::uniform_real_distribution<float> dist(-1, 1);
+
+			Benchmark::Time(
+				std::to_string(numCars) + " cars, " + std::to_string(numThreads) + " threads", TICKS,
+				[&](int tick) {
+					if (tick % CONTROLS_INTERVAL == 0) {
+						for (Car* car : arena->GetCars()) {
+							car->controls.throttle = 1;
+							car->controls.boost = dist(rng) > 0;
+							car->controls.steer = dist(rng);
+							car->controls.jump = dist(rng) > 0.8f;
+						}
+					}
+
+					arena->Step(1);
+				}
+			);
+
+			delete arena;
+		}
+	}
+}
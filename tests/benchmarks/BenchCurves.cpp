@@ -0,0 +1,44 @@
+#include "Benchmark.h"
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures evaluating the steer angle curve as a map-based LinearPieceCurve and as a FixedLinearPieceCurve
+RS_BENCHMARK(Curves) {
+	constexpr int ITERATIONS = 10 * 1000 * 1000;
+
+	const auto& fixedCurve = RLConst::STEER_ANGLE_FROM_SPEED_CURVE;
+
+	LinearPieceCurve mapCurve = {};
+	for (size_t i = 0; i < std::size(fixedCurve.inputs); i++)
+		mapCurve.valueMappings[fixedCurve.inputs[i]] = fixedCurve.outputs[i];
+
+	std::vector<float> inputs(1024);
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float> dist(0, RLConst::CAR_MAX_SPEED);
+	for (float& input : inputs)
+		input = dist(rng);
+
+	volatile float sink = 0;
+
+	Benchmark::Time("LinearPieceCurve::GetOutput()", ITERATIONS,
+		[&](int i) {
+			sink = mapCurve.GetOutput(inputs[i % inputs.size()]);
+		}
+	);
+
+	Benchmark::Time("FixedLinearPieceCurve::GetOutput()", ITERATIONS,
+		[&](int i) {
+			sink = fixedCurve.GetOutput(inputs[i % inputs.size()]);
+		}
+	);
+
+	Benchmark::Time("FixedLinearPieceCurve::GetOutput4() (4 inputs)", ITERATIONS / 4,
+		[&](int i) {
+			float outputs[4];
+			fixedCurve.GetOutput4(&inputs[(i * 4) % inputs.size()], outputs);
+			sink = outputs[0] + outputs[3];
+		}
+	);
+}
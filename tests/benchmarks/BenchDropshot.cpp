@@ -0,0 +1,44 @@
+#include "Benchmark.h"
+
+using namespace RocketSim;
+
+// Measures creating dropshot arenas (with their tile rigidbodies), and updating the tiles after damage
+RS_BENCHMARK(Dropshot) {
+	constexpr int ITERATIONS = 100 * 1000;
+
+	if (GetArenaCollisionShapes(GameMode::DROPSHOT).empty())
+		return;
+
+	Benchmark::Time("Arena::Create() + delete", ITERATIONS / 100,
+		[&](int) {
+			delete Arena::Create(GameMode::DROPSHOT);
+		}
+	);
+
+	Arena* arena = Arena::Create(GameMode::DROPSHOT);
+	for (int i = 0; i < 4; i++)
+		arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+	arena->ResetToRandomKickoff(0);
+	arena->Step(10);
+
+	Benchmark::Time("Arena::Fork() + delete", ITERATIONS / 100,
+		[&](int) {
+			delete arena->Fork();
+		}
+	);
+
+	// Like a charged ball hit, which damages a tile and its neighbors
+	DropshotTilesState tilesState = arena->GetDropshotTilesState();
+	Benchmark::Time("Arena::SetDropshotTilesState() (one hit)", ITERATIONS,
+		[&](int i) {
+			int tileIdx = i % RLConst::Dropshot::NUM_TILES_PER_TEAM;
+			for (int neighborIdx : DropshotTiles::GetNeighborIndices(tileIdx, 3)) {
+				auto& damageState = tilesState.states[i % 2][neighborIdx].damageState;
+				damageState = (damageState + 1) % 3;
+			}
+			arena->SetDropshotTilesState(tilesState);
+		}
+	);
+
+	delete arena;
+}
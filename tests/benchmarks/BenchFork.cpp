@@ -0,0 +1,44 @@
+#include "Benchmark.h"
+
+using namespace RocketSim;
+
+// Measures creating branches of an arena, as done in tree search
+RS_BENCHMARK(Fork) {
+	constexpr int ITERATIONS = 2000;
+	constexpr int BRANCH_TICKS = 30;
+
+	for (GameMode gameMode : { GameMode::SOCCAR, GameMode::HOOPS }) {
+		if (GetArenaCollisionShapes(gameMode).empty())
+			continue;
+
+		Arena* arena = Arena::Create(gameMode);
+		for (int i = 0; i < 4; i++)
+			arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+		arena->ResetToRandomKickoff(0);
+		arena->Step(10);
+
+		std::string gameModeStr = GAMEMODE_STRS[(int)gameMode];
+
+		Benchmark::Time(gameModeStr + " Clone() + delete", ITERATIONS / 100,
+			[&](int) {
+				delete arena->Clone(false);
+			}
+		);
+
+		Benchmark::Time(gameModeStr + " Fork() + delete", ITERATIONS,
+			[&](int) {
+				delete arena->Fork();
+			}
+		);
+
+		Benchmark::Time(gameModeStr + " Fork() + " + std::to_string(BRANCH_TICKS) + " ticks + delete", ITERATIONS,
+			[&](int) {
+				Arena* fork = arena->Fork();
+				fork->Step(BRANCH_TICKS);
+				delete fork;
+			}
+		);
+
+		delete arena;
+	}
+}
@@ -0,0 +1,98 @@
+#include "Benchmark.h"
+
+#include <bullet3-3.24/BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <random>
+
+using namespace RocketSim;
+
+// Builds a BVH for every soccar collision mesh, with triangles in file order or sorted with CollisionMeshFile::SortForLocality()
+static std::vector<btBvhTriangleMeshShape*> LoadSoccarMeshes(bool sortForLocality) {
+	std::vector<btBvhTriangleMeshShape*> shapes;
+
+	std::filesystem::path folder = Benchmark::meshesFolder / "soccar";
+	if (!std::filesystem::exists(folder))
+		return shapes;
+
+	for (auto& entry : std::filesystem::directory_iterator(folder)) {
+		if (entry.path().extension() != COLLISION_MESH_FILE_EXTENSION)
+			continue;
+
+		DataStreamIn in = DataStreamIn(entry.path(), false);
+		CollisionMeshFile meshFile = {};
+		meshFile.ReadFromStream(in, true);
+		if (sortForLocality)
+			meshFile.SortForLocality();
+
+		shapes.push_back(new btBvhTriangleMeshShape(meshFile.MakeBulletMesh(), true));
+	}
+
+	return shapes;
+}
+
+static void DeleteMeshes(std::vector<btBvhTriangleMeshShape*>& shapes) {
+	for (btBvhTriangleMeshShape* shape : shapes) {
+		delete shape->getMeshInterface();
+		delete shape;
+	}
+	shapes.clear();
+}
+
+struct CountTrianglesCallback : btTriangleCallback {
+	size_t numTriangles = 0;
+
+	void processTriangle(btVector3* triangle, int partId, int triangleIndex) override {
+		numTriangles++;
+	}
+};
+
+// Measures BVH queries (like the ones done for contacts and wheel raycasts) against the soccar meshes, in file order and sorted for locality
+// Both layouts get the exact same queries, so the difference is only from memory layout
+RS_BENCHMARK(MeshLayout) {
+	constexpr int ITERATIONS = 200 * 1000;
+	constexpr int NUM_QUERIES = 4096;
+	constexpr float QUERY_BOX_SIZE = 200;
+
+	std::vector<btVector3> queryPoints;
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float>
+		distX(-4100, 4100), distY(-5200, 5200), distZ(0, 2050), distOffset(-1, 1);
+	for (int i = 0; i < NUM_QUERIES; i++)
+		queryPoints.push_back(btVector3(distX(rng), distY(rng), distZ(rng)) * UU_TO_BT);
+
+	// Rays go from each query point to a random point up to 500uu away
+	std::vector<btVector3> rayEnds;
+	for (int i = 0; i < NUM_QUERIES; i++)
+		rayEnds.push_back(queryPoints[i] + btVector3(distOffset(rng), distOffset(rng), distOffset(rng)) * (500 * UU_TO_BT));
+
+	for (bool sortForLocality : { false, true }) {
+		std::vector<btBvhTriangleMeshShape*> shapes = LoadSoccarMeshes(sortForLocality);
+		if (shapes.empty())
+			return;
+
+		std::string layoutName = sortForLocality ? "sorted" : "file order";
+		btVector3 boxHalfSize = btVector3(QUERY_BOX_SIZE, QUERY_BOX_SIZE, QUERY_BOX_SIZE) * (UU_TO_BT / 2);
+
+		CountTrianglesCallback aabbCallback = {};
+		Benchmark::Time(layoutName + ", AABB queries (all meshes)", ITERATIONS,
+			[&](int i) {
+				const btVector3& point = queryPoints[i % NUM_QUERIES];
+				for (btBvhTriangleMeshShape* shape : shapes)
+					shape->processAllTriangles(&aabbCallback, point - boxHalfSize, point + boxHalfSize);
+			}
+		);
+
+		CountTrianglesCallback rayCallback = {};
+		Benchmark::Time(layoutName + ", ray casts (all meshes)", ITERATIONS,
+			[&](int i) {
+				for (btBvhTriangleMeshShape* shape : shapes)
+					shape->performRaycast(&rayCallback, queryPoints[i % NUM_QUERIES], rayEnds[i % NUM_QUERIES]);
+			}
+		);
+
+		// Same queries, so this must match between layouts
+		std::cout << "  " << layoutName << ", triangles found: " << aabbCallback.numTriangles << " (AABB), " << rayCallback.numTriangles << " (rays)" << std::endl;
+
+		DeleteMeshes(shapes);
+	}
+}
@@ -0,0 +1,44 @@
+#include "Benchmark.h"
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures long ray casts (line-of-sight/shot checks) through a soccar arena, with the custom broadphase and with bullet's dbvt broadphase
+RS_BENCHMARK(RayTest) {
+	constexpr int ITERATIONS = 200 * 1000;
+	constexpr int NUM_RAYS = 1024;
+
+	std::vector<std::pair<btVector3, btVector3>> rays;
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<float>
+		distX(-4000, 4000), distY(-5000, 5000), distZ(20, 2000);
+	for (int i = 0; i < NUM_RAYS; i++) {
+		btVector3
+			from = btVector3(distX(rng), distY(rng), distZ(rng)),
+			to = btVector3(distX(rng), distY(rng), distZ(rng));
+		rays.push_back({ from * UU_TO_BT, to * UU_TO_BT });
+	}
+
+	for (bool useCustomBroadphase : { true, false }) {
+		ArenaConfig arenaConfig = {};
+		arenaConfig.useCustomBroadphase = useCustomBroadphase;
+		Arena* arena = Arena::Create(GameMode::SOCCAR, arenaConfig);
+		for (int i = 0; i < 4; i++)
+			arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+		arena->ResetToRandomKickoff(0);
+		arena->Step();
+
+		volatile float sink = 0;
+		Benchmark::Time(useCustomBroadphase ? "Custom broadphase" : "Dbvt broadphase", ITERATIONS,
+			[&](int i) {
+				auto& ray = rays[i % NUM_RAYS];
+				btCollisionWorld::ClosestRayResultCallback callback(ray.first, ray.second, NULL);
+				arena->_bulletWorld.rayTest(ray.first, ray.second, callback);
+				sink = callback.m_closestHitFraction;
+			}
+		);
+
+		delete arena;
+	}
+}
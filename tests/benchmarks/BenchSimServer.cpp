@@ -0,0 +1,100 @@
+#include "Benchmark.h"
+
+#ifndef _WIN32
+
+#include <RocketSim/Server/SimServer/SimServer.h>
+#include <RocketSim/Server/SimClient/SimClient.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace RocketSim;
+
+// Measures a SimServer driven by a client in a separate process:
+//	round-trip latency of single-tick steps, and throughput of all arenas with several steps in flight each
+RS_BENCHMARK(SimServer) {
+	constexpr int NUM_ARENAS = 8;
+	constexpr int NUM_CARS = 4;
+	constexpr int LATENCY_ITERATIONS = 5000;
+	constexpr int THROUGHPUT_ITERATIONS = 500;
+	constexpr int THROUGHPUT_TICKS = 8;
+	constexpr char SERVER_NAME[] = "rocketsim_benchmark";
+
+	std::vector<Arena*> arenas;
+	for (int i = 0; i < NUM_ARENAS; i++) {
+		Arena* arena = Arena::Create(GameMode::SOCCAR);
+		for (int j = 0; j < NUM_CARS; j++)
+			arena->AddCar((j % 2) ? Team::ORANGE : Team::BLUE);
+		arena->ResetToRandomKickoff(i);
+		arenas.push_back(arena);
+	}
+
+	SimServerConfig serverConfig = {};
+	serverConfig.numRingSlots = 4;
+	SimServer* server = new SimServer(SERVER_NAME, arenas, serverConfig);
+
+	// Fork before the server thread exists, the child only uses the client
+	pid_t clientPID = fork();
+	if (clientPID == 0) {
+		SimClient client(SERVER_NAME);
+
+		auto fnStep = [&](uint32_t arenaIndex, uint32_t ticks) {
+			SimStatesView states = client.WaitStates(arenaIndex);
+			uint32_t numCars = states.header->numCars;
+			CarControls* controls = client.BeginControls(arenaIndex);
+			for (uint32_t i = 0; i < numCars; i++) {
+				controls[i] = {};
+				controls[i].throttle = 1;
+				controls[i].boost = states.carBoost[i] > 50;
+			}
+			client.PopStates(arenaIndex);
+			client.SendControls(arenaIndex, numCars, ticks);
+
+			while (client.PeekEvent(arenaIndex))
+				client.PopEvent(arenaIndex);
+		};
+
+		Benchmark::Time("Round trip, 1 arena, 1 tick", LATENCY_ITERATIONS,
+			[&](int) {
+				fnStep(0, 1);
+			}
+		);
+
+		// Fill every arena's pipeline, then keep it full
+		for (uint32_t i = 0; i < NUM_ARENAS; i++) {
+			client.WaitStates(i); // Until the arena is ready for this client
+			for (uint32_t j = 1; j < serverConfig.numRingSlots; j++) {
+				CarControls* controls = client.BeginControls(i);
+				for (int k = 0; k < NUM_CARS; k++)
+					controls[k] = {};
+				client.SendControls(i, NUM_CARS, THROUGHPUT_TICKS);
+			}
+		}
+
+		Benchmark::Time(
+			std::to_string(NUM_ARENAS) + " arenas, " + std::to_string(THROUGHPUT_TICKS) + " ticks, " +
+			std::to_string(serverConfig.numRingSlots) + " steps in flight (per step of all arenas)",
+			THROUGHPUT_ITERATIONS,
+			[&](int) {
+				for (uint32_t i = 0; i < NUM_ARENAS; i++)
+					fnStep(i, THROUGHPUT_TICKS);
+			}
+		);
+
+		std::cout << std::flush;
+		_exit(0);
+	}
+
+	std::thread serverThread([&] { server->Run(); });
+
+	int clientStatus;
+	waitpid(clientPID, &clientStatus, 0);
+	server->Stop();
+	serverThread.join();
+
+	delete server;
+	for (Arena* arena : arenas)
+		delete arena;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include <RocketSim/Sim/Arena/ArenaStepper/ArenaStepper.h>
+
+#include <random>
+
+using namespace RocketSim;
+
+// Measures overlapping simulation with a fake inference workload, using two ArenaSteppers in alternation
+RS_BENCHMARK(StepAsync) {
+	constexpr int NUM_ARENAS = 16;
+	constexpr int ITERATIONS = 300;
+	constexpr int TICK_SKIP = 8;
+	constexpr int INFERENCE_ROUNDS = 200 * 1000;
+
+	auto fnCreateArenas = [](int count) {
+		std::vector<Arena*> arenas;
+		for (int i = 0; i < count; i++) {
+			Arena* arena = Arena::Create(GameMode::SOCCAR);
+			for (int j = 0; j < 4; j++)
+				arena->AddCar((j % 2) ? Team::ORANGE : Team::BLUE);
+			arena->ResetToRandomKickoff(i);
+			arenas.push_back(arena);
+		}
+		return arenas;
+	};
+
+	// Stand-in for running a policy, writes controls based on the states
+	std::mt19937 rng(0);
+	auto fnInference = [&](const ArenaSnapshotView& states, CarControls* controlsOut) {
+		volatile float sink = 0;
+		for (int i = 0; i < INFERENCE_ROUNDS / NUM_ARENAS; i++)
+			sink = sink + sqrtf((float)i);
+
+		for (uint32_t i = 0; i < states.header->numCars; i++) {
+			controlsOut[i].throttle = 1;
+			controlsOut[i].steer = (rng() % 3) - 1.f;
+			controlsOut[i].boost = states.carStates[i].boost > 50;
+		}
+	};
+
+	{
+		std::vector<Arena*> arenas = fnCreateArenas(NUM_ARENAS);
+		std::vector<CarControls> controls;
+		Benchmark::Time("Synchronous", ITERATIONS,
+			[&](int) {
+				for (Arena* arena : arenas) {
+					std::vector<byte> states(arena->GetSnapshotSize());
+					arena->WriteSnapshot(states.data(), states.size());
+					controls.resize(arena->GetCars().size());
+					fnInference(ArenaSnapshotView::FromBuffer(states.data(), states.size()), controls.data());
+
+					size_t i = 0;
+					for (Car* car : arena->GetCars())
+						car->controls = controls[i++];
+					arena->Step(TICK_SKIP);
+				}
+			}
+		);
+		for (Arena* arena : arenas)
+			delete arena;
+	}
+
+	{
+		std::vector<Arena*> arenasA = fnCreateArenas(NUM_ARENAS / 2), arenasB = fnCreateArenas(NUM_ARENAS / 2);
+		ArenaStepper stepperA(arenasA), stepperB(arenasB);
+
+		auto fnInferenceAll = [&](ArenaStepper& stepper) {
+			for (size_t i = 0; i < stepper.GetNumArenas(); i++)
+				fnInference(stepper.GetStates(i), stepper.GetNextControls(i).data());
+		};
+
+		stepperA.StepAsync(TICK_SKIP);
+		Benchmark::Time("Pipelined (2 steppers)", ITERATIONS,
+			[&](int) {
+				fnInferenceAll(stepperB);
+				stepperB.StepAsync(TICK_SKIP);
+				stepperA.Wait();
+				fnInferenceAll(stepperA);
+				stepperA.StepAsync(TICK_SKIP);
+				stepperB.Wait();
+			}
+		);
+		stepperA.Wait();
+
+		for (Arena* arena : arenasA)
+			delete arena;
+		for (Arena* arena : arenasB)
+			delete arena;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <RocketSim/RocketSim.h>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+// Minimal benchmark registry, each benchmark file registers its functions with RS_BENCHMARK()
+namespace Benchmark {
+	typedef std::function<void()> BenchmarkFn;
+
+	// Collision meshes folder given to main(), for benchmarks that load meshes themselves
+	inline std::filesystem::path meshesFolder;
+
+	inline std::map<std::string, BenchmarkFn>& GetAll() {
+		static std::map<std::string, BenchmarkFn> benchmarks;
+		return benchmarks;
+	}
+
+	struct Registrar {
+		Registrar(const char* name, BenchmarkFn fn) {
+			GetAll()[name] = fn;
+		}
+	};
+
+	// Runs fn for the given amount of iterations and prints the average time per iteration
+	template <typename T>
+	inline double Time(const std::string& label, int iterations, T fn) {
+		auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+			fn(i);
+		auto endTime = std::chrono::steady_clock::now();
+
+		double totalNS = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+		double nsPerIteration = totalNS / iterations;
+		std::cout << "  " << label << ": " << nsPerIteration << "ns/iter (" << iterations << " iters, " << (totalNS / 1e6) << "ms total)" << std::endl;
+		return nsPerIteration;
+	}
+}
+
+#define RS_BENCHMARK(name) \
+	static void Benchmark_##name(); \
+	static Benchmark::Registrar _benchmarkRegistrar_##name(#name, Benchmark_##name); \
+	static void Benchmark_##name()
@@ -0,0 +1,20 @@
+#include "Benchmark.h"
+
+int main(int argc, char** argv) {
+	using std::cout, std::endl;
+	using namespace RocketSim;
+
+	std::string meshesFolder = (argc > 1) ? argv[1] : "./resources/collision_meshes";
+	std::string onlyBenchmark = (argc > 2) ? argv[2] : "";
+
+	Init(meshesFolder, true);
+	Benchmark::meshesFolder = meshesFolder;
+
+	for (auto& pair : Benchmark::GetAll()) {
+		if (!onlyBenchmark.empty() && pair.first != onlyBenchmark)
+			continue;
+
+		cout << pair.first << ":" << endl;
+		pair.second();
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <RocketSim/RocketSim.h>
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+// Minimal test registry, each test file registers its tests with RS_TEST() and checks conditions with RS_CHECK()
+// A failed check is reported and fails the test, but the test keeps running
+namespace Test {
+	typedef std::function<void()> TestFn;
+
+	inline std::map<std::string, TestFn>& GetAll() {
+		static std::map<std::string, TestFn> tests;
+		return tests;
+	}
+
+	struct Registrar {
+		Registrar(const char* name, TestFn fn) {
+			GetAll()[name] = fn;
+		}
+	};
+
+	// Failed checks of the test that is running
+	inline int numFailedChecks = 0;
+
+	inline void Fail(const char* file, int line, const std::string& message) {
+		std::cout << "  " << file << ":" << line << ": " << message << std::endl;
+		numFailedChecks++;
+	}
+
+	// Arena with cars alternating between teams, reset to a kickoff
+	inline RocketSim::Arena* MakeArena(RocketSim::GameMode gameMode, int numCars, int seed, float tickRate = 120) {
+		using namespace RocketSim;
+		Arena* arena = Arena::Create(gameMode, {}, tickRate);
+		for (int i = 0; i < numCars; i++)
+			arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+		arena->ResetToRandomKickoff(seed);
+		return arena;
+	}
+
+	// Gives every car new random controls, the same for the same rng state and car IDs
+	inline void RandomizeControls(RocketSim::Arena* arena, std::mt19937& rng) {
+		using namespace RocketSim;
+		std::uniform_real_distribution<float> dist(-1, 1);
+
+		std::vector<Car*> cars(arena->GetCars().begin(), arena->GetCars().end());
+		std::sort(cars.begin(), cars.end(), [](Car* a, Car* b) { return a->id < b->id; });
+		for (Car* car : cars) {
+			CarControls& controls = car->controls;
+			controls.throttle = dist(rng) * 0.5f + 0.5f;
+			controls.steer = dist(rng);
+			controls.pitch = dist(rng);
+			controls.yaw = dist(rng);
+			controls.roll = dist(rng);
+			controls.jump = dist(rng) > 0.7f;
+			controls.boost = dist(rng) > 0.2f;
+			controls.handbrake = dist(rng) > 0.9f;
+		}
+	}
+}
+
+#define RS_TEST(name) \
+	static void Test_##name(); \
+	static Test::Registrar _testRegistrar_##name(#name, Test_##name); \
+	static void Test_##name()
+
+#define RS_CHECK(cond) \
+	do { \
+		if (!(cond)) \
+			Test::Fail(__FILE__, __LINE__, "Check failed: " #cond); \
+	} while (0)
+
+// Checks that two values are equal, printing both if not
+#define RS_CHECK_EQ(a, b) \
+	do { \
+		auto _a = (a); auto _b = (b); \
+		if (!(_a == _b)) { \
+			std::stringstream _stream; \
+			_stream << "Check failed: " #a " == " #b " (" << _a << " vs " << _b << ")"; \
+			Test::Fail(__FILE__, __LINE__, _stream.str()); \
+		} \
+	} while (0)
+
+// Checks that two values are at most maxError apart, printing both if not
+#define RS_CHECK_NEAR(a, b, maxError) \
+	do { \
+		double _a = (a), _b = (b); \
+		if (!(std::abs(_a - _b) <= (maxError))) { \
+			std::stringstream _stream; \
+			_stream << "Check failed: " #a " ~= " #b " (" << _a << " vs " << _b << ", max error " << (maxError) << ")"; \
+			Test::Fail(__FILE__, __LINE__, _stream.str()); \
+		} \
+	} while (0)
+
+// Checks that two vectors are at most maxDist apart, printing both if not
+#define RS_CHECK_VEC_NEAR(a, b, maxDist) \
+	do { \
+		RocketSim::Vec _a = (a), _b = (b); \
+		if (!(_a.Dist(_b) <= (maxDist))) { \
+			std::stringstream _stream; \
+			_stream << "Check failed: " #a " ~= " #b " (" << _a << " vs " << _b << ", max distance " << (maxDist) << ")"; \
+			Test::Fail(__FILE__, __LINE__, _stream.str()); \
+		} \
+	} while (0)
@@ -0,0 +1,72 @@
+#include "Test.h"
+
+#include <RocketSim/Sim/Arena/ArenaStepper/ArenaStepper.h>
+#include <RocketSim/Recording/Replay/Replay.h>
+
+using namespace RocketSim;
+
+// Arenas stepped by an ArenaStepper end up exactly like the same arenas stepped with Arena::Step()
+RS_TEST(ArenaStepperMatchesStep) {
+	constexpr int NUM_ARENAS = 3;
+	constexpr int NUM_STEPS = 100;
+	constexpr int TICKS_PER_STEP = 4;
+
+	std::vector<Arena*> arenas, refArenas;
+	for (int i = 0; i < NUM_ARENAS; i++) {
+		arenas.push_back(Test::MakeArena(GameMode::SOCCAR, 2 + i, i));
+		refArenas.push_back(Test::MakeArena(GameMode::SOCCAR, 2 + i, i));
+	}
+
+	{
+		ArenaStepper stepper(arenas, 2);
+
+		std::mt19937 rng(0);
+		std::uniform_real_distribution<float> dist(-1, 1);
+		for (int step = 0; step < NUM_STEPS; step++) {
+			for (int i = 0; i < NUM_ARENAS; i++) {
+				ArenaSnapshotView states = stepper.GetStates(i);
+				std::vector<CarControls>& controls = stepper.GetNextControls(i);
+				RS_CHECK_EQ(controls.size(), (size_t)states.header->numCars);
+
+				for (uint32_t carIndex = 0; carIndex < states.header->numCars; carIndex++) {
+					CarControls carControls = {};
+					carControls.throttle = 1;
+					carControls.steer = dist(rng);
+					carControls.boost = dist(rng) > 0;
+					carControls.jump = dist(rng) > 0.8f;
+
+					controls[carIndex] = carControls;
+					refArenas[i]->GetCar(states.carIDs[carIndex])->controls = carControls;
+				}
+			}
+
+			stepper.StepAsync(TICKS_PER_STEP);
+			for (Arena* refArena : refArenas)
+				refArena->Step(TICKS_PER_STEP);
+			stepper.Wait();
+
+			for (int i = 0; i < NUM_ARENAS; i++) {
+				ArenaSnapshotView states = stepper.GetStates(i);
+				RS_CHECK_EQ(states.header->tickCount, refArenas[i]->tickCount);
+				RS_CHECK(states.ballState->pos == refArenas[i]->ball->GetState().pos);
+
+				for (uint32_t carIndex = 0; carIndex < states.header->numCars; carIndex++) {
+					CarState refState = refArenas[i]->GetCar(states.carIDs[carIndex])->GetState();
+					RS_CHECK(states.carStates[carIndex].pos == refState.pos);
+					RS_CHECK(states.carStates[carIndex].vel == refState.vel);
+					RS_CHECK_EQ(states.carStates[carIndex].boost, refState.boost);
+				}
+
+				RS_CHECK_EQ(Replay::HashArenaState(arenas[i]), Replay::HashArenaState(refArenas[i]));
+			}
+
+			if (Test::numFailedChecks > 0)
+				break;
+		}
+	}
+
+	for (int i = 0; i < NUM_ARENAS; i++) {
+		delete arenas[i];
+		delete refArenas[i];
+	}
+}
@@ -0,0 +1,202 @@
+#include "Test.h"
+
+using namespace RocketSim;
+
+// Pads that the grid locks to the car, clearing the locks afterwards
+static std::vector<BoostPad*> GetGridCollisions(Arena* arena, Car* car) {
+	std::vector<BoostPad*> result;
+	arena->_boostPadGrid.CheckCollision(car);
+	for (BoostPad* pad : arena->GetBoostPads()) {
+		if (pad->_internalState.curLockedCar == car)
+			result.push_back(pad);
+		pad->_internalState.curLockedCar = NULL;
+	}
+	arena->_boostPadGrid.lockedPads.clear();
+	return result;
+}
+
+// Pads that lock to the car when checking every pad on its own, like before the grid was used for all layouts
+static std::vector<BoostPad*> GetBruteForceCollisions(Arena* arena, Car* car) {
+	std::vector<BoostPad*> result;
+	if (car->_internalState.isDemoed || car->_internalState.boost >= RLConst::BOOST_MAX)
+		return result;
+
+	for (BoostPad* pad : arena->GetBoostPads()) {
+		pad->_CheckCollide(car);
+		if (pad->_internalState.curLockedCar == car)
+			result.push_back(pad);
+		pad->_internalState.curLockedCar = NULL;
+	}
+	return result;
+}
+
+// The boost pad grid finds exactly the pads that checking every pad finds, for the standard and a custom pad layout
+RS_TEST(BoostPadGridMatchesBruteForce) {
+	constexpr int NUM_PLACEMENTS = 5000;
+
+	ArenaConfig customConfig = {};
+	customConfig.useCustomBoostPads = true;
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1, 1);
+		for (int i = 0; i < 60; i++) {
+			BoostPadConfig padConfig = {};
+			padConfig.pos = Vec(dist(rng) * 3500, dist(rng) * 4500, (dist(rng) + 1) * 300);
+			padConfig.isBig = dist(rng) > 0.5f;
+			customConfig.customBoostPads.push_back(padConfig);
+		}
+	}
+
+	for (bool useCustomPads : { false, true }) {
+		Arena* arena = Arena::Create(GameMode::SOCCAR, useCustomPads ? customConfig : ArenaConfig());
+		Car* car = arena->AddCar(Team::BLUE);
+		const std::vector<BoostPad*>& pads = arena->GetBoostPads();
+
+		std::mt19937 rng(2);
+		std::uniform_real_distribution<float> dist(-1, 1);
+		int numCollisions = 0;
+		for (int i = 0; i < NUM_PLACEMENTS; i++) {
+			BoostPad* nearPad = pads[rng() % pads.size()];
+
+			// Near the pad, with the car's AABB sometimes touching it while its origin is outside the pad's cylinder
+			CarState state = {};
+			state.pos = nearPad->config.pos + Vec(dist(rng) * 350, dist(rng) * 350, dist(rng) * 150 + 80);
+			state.rotMat = Angle(dist(rng) * M_PI, dist(rng) * M_PI / 2, dist(rng) * M_PI).ToRotMat();
+			state.boost = (i % 10 == 0) ? 100 : (dist(rng) + 1) * 49;
+			state.isDemoed = (i % 17 == 0);
+			car->SetState(state);
+
+			// Pads that were locked to the car last tick check its AABB instead of its origin
+			for (BoostPad* pad : pads)
+				pad->_internalState.prevLockedCarID = (dist(rng) > 0) ? car->id : 0;
+
+			std::vector<BoostPad*> gridCollisions = GetGridCollisions(arena, car);
+			std::vector<BoostPad*> bruteForceCollisions = GetBruteForceCollisions(arena, car);
+			RS_CHECK(gridCollisions == bruteForceCollisions);
+			numCollisions += bruteForceCollisions.size();
+		}
+
+		// Make sure the placements actually test collisions
+		RS_CHECK(numCollisions > NUM_PLACEMENTS / 10);
+
+		for (BoostPad* pad : pads)
+			pad->_internalState.prevLockedCarID = 0;
+		delete arena;
+	}
+}
+
+// Pad cooldowns count down and end on the same ticks as counting down every tick, whatever amount of ticks is stepped at once
+RS_TEST(BoostPadCooldownTiming) {
+	for (float tickRate : { 120.f, 30.f }) {
+		for (int ticksPerStep : { 1, 7, 97 }) {
+			Arena* arena = Arena::Create(GameMode::SOCCAR, {}, tickRate);
+			const std::vector<BoostPad*>& pads = arena->GetBoostPads();
+
+			// Reference cooldowns, counted down every tick
+			std::vector<float> refCooldowns(pads.size());
+			for (size_t i = 0; i < pads.size(); i++) {
+				refCooldowns[i] = (i % 3 == 0) ? 0 : (0.37f + i * 0.29f);
+				BoostPadState state = {};
+				state.cooldown = refCooldowns[i];
+				pads[i]->SetState(state);
+			}
+
+			// A car picking up a big pad on the first tick
+			BoostPad* bigPad = NULL;
+			for (size_t i = 0; i < pads.size(); i++) {
+				if (pads[i]->config.isBig && refCooldowns[i] == 0) {
+					bigPad = pads[i];
+					break;
+				}
+			}
+			RS_CHECK(bigPad != NULL);
+
+			Car* car = arena->AddCar(Team::BLUE);
+			CarState carState = {};
+			carState.pos = bigPad->config.pos + Vec(0, 0, 17);
+			carState.boost = 0;
+			car->SetState(carState);
+
+			float tickTime = 1 / tickRate;
+			int totalTicks = (int)(12 * tickRate);
+			for (int tick = 0; tick < totalTicks; tick += ticksPerStep) {
+				int ticks = RS_MIN(ticksPerStep, totalTicks - tick);
+				for (int i = 0; i < ticks; i++) {
+					for (size_t j = 0; j < pads.size(); j++) {
+						if (refCooldowns[j] > 0)
+							refCooldowns[j] = RS_MAX(refCooldowns[j] - tickTime, 0);
+
+						// The pickup happens after counting down on the first tick
+						if (tick + i == 0 && pads[j] == bigPad)
+							refCooldowns[j] = arena->GetMutatorConfig().boostPadCooldown_Big;
+					}
+				}
+				arena->Step(ticks);
+
+				for (size_t i = 0; i < pads.size(); i++) {
+					BoostPadState state = pads[i]->GetState();
+					RS_CHECK_EQ(state.cooldown, refCooldowns[i]);
+					RS_CHECK_EQ(state.isActive, refCooldowns[i] == 0);
+				}
+
+				if (Test::numFailedChecks > 0)
+					break;
+			}
+
+			RS_CHECK_EQ(car->GetState().boost, RLConst::BOOST_MAX);
+			delete arena;
+		}
+	}
+}
+
+// Cooldowns that end right around the next count down, huge cooldowns, and cooldowns too large to ever count down also match counting down every tick
+RS_TEST(BoostPadCooldownEdgeValues) {
+	for (float tickRate : { 120.f, 30.f }) {
+		Arena* arena = Arena::Create(GameMode::SOCCAR, {}, tickRate);
+		const std::vector<BoostPad*>& pads = arena->GetBoostPads();
+		float tickTime = 1 / tickRate;
+
+		std::vector<float> cooldowns = { 1e5f, 1e7f, 1e30f, tickTime, std::nextafter(tickTime, 0.f) };
+		for (int ticks = 14; ticks <= 20; ticks++) {
+			float cooldown = tickTime * ticks;
+			cooldowns.push_back(cooldown);
+			cooldowns.push_back(std::nextafter(cooldown, 0.f));
+			cooldowns.push_back(std::nextafter(cooldown, FLT_MAX));
+		}
+		RS_CHECK(cooldowns.size() <= pads.size());
+
+		std::vector<float> refCooldowns(pads.size());
+		for (size_t i = 0; i < pads.size(); i++) {
+			refCooldowns[i] = (i < cooldowns.size()) ? cooldowns[i] : 0;
+			BoostPadState state = {};
+			state.cooldown = refCooldowns[i];
+			pads[i]->SetState(state);
+		}
+
+		// Pads aren't updated in arenas without cars
+		Car* car = arena->AddCar(Team::BLUE);
+		CarState carState = {};
+		carState.pos = Vec(0, 0, 17);
+		car->SetState(carState);
+
+		for (int tick = 0; tick < 100; tick++) {
+			for (float& refCooldown : refCooldowns)
+				if (refCooldown > 0)
+					refCooldown = RS_MAX(refCooldown - tickTime, 0);
+			arena->Step(1);
+
+			for (size_t i = 0; i < pads.size(); i++) {
+				BoostPadState state = pads[i]->GetState();
+				RS_CHECK_EQ(state.cooldown, refCooldowns[i]);
+				RS_CHECK_EQ(state.isActive, refCooldowns[i] == 0);
+			}
+
+			if (Test::numFailedChecks > 0) {
+				std::cout << "  (tick rate " << tickRate << ", tick " << tick << ")" << std::endl;
+				break;
+			}
+		}
+
+		delete arena;
+	}
+}
@@ -0,0 +1,566 @@
+#include "Test.h"
+
+#include <bullet3-3.24/BulletCollision/BroadphaseCollision/btRSBroadphase.h>
+#include <bullet3-3.24/LinearMath/btAabbUtil2.h>
+
+using namespace RocketSim;
+
+// Every pair of a dynamic proxy and any other proxy with overlapping AABBs, sorted like btRSBroadphase::activePairs
+static std::vector<btRSBroadphase::ProxyPair> GetBruteForcePairs(btRSBroadphase* broadphase, int numHandles) {
+	std::vector<btRSBroadphase::ProxyPair> result;
+	for (int i = 0; i < numHandles; i++) {
+		btRSBroadphaseProxy* proxy = &broadphase->m_pHandles[i];
+		if (!proxy->m_clientObject || proxy->isStatic)
+			continue;
+
+		for (int j = 0; j < numHandles; j++) {
+			btRSBroadphaseProxy* otherProxy = &broadphase->m_pHandles[j];
+			if (j == i || !otherProxy->m_clientObject)
+				continue;
+
+			// Pairs of dynamic proxies are found from both sides
+			if (!otherProxy->isStatic && j < i)
+				continue;
+
+			// Same check as btRSBroadphase::aabbOverlap(), which isn't exported from the library
+			if (TestAabbAgainstAabb2(proxy->m_aabbMin, proxy->m_aabbMax, otherProxy->m_aabbMin, otherProxy->m_aabbMax))
+				result.push_back(proxy < otherProxy ? btRSBroadphase::ProxyPair(proxy, otherProxy) : btRSBroadphase::ProxyPair(otherProxy, proxy));
+		}
+	}
+
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// Each tick, the broadphase has exactly the overlapping pairs, and only adds and removes the pairs that changed
+RS_TEST(BroadphasePairChanges) {
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 4, 3);
+	auto* broadphase = (btRSBroadphase*)arena->_bulletWorldParams.broadphase;
+
+	int numHandles = 0;
+	for (int i = 0; i < broadphase->m_maxHandles; i++)
+		if (broadphase->m_pHandles[i].m_clientObject)
+			numHandles = i + 1;
+
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> dist(-1, 1);
+	int totalAdded = 0, totalRemoved = 0;
+	for (int tick = 0; tick < 1000; tick++) {
+		if (tick % 10 == 0)
+			Test::RandomizeControls(arena, rng);
+
+		// Throw the ball at a car every now and then, so dynamic pairs come and go
+		if (tick % 50 == 0) {
+			Car* car = arena->GetCar(1 + (tick / 50) % 4);
+			BallState ballState = {};
+			ballState.pos = car->GetState().pos + Vec(dist(rng) * 300, dist(rng) * 300, 250);
+			ballState.vel = Vec(0, 0, -1000);
+			arena->ball->SetState(ballState);
+		}
+
+		size_t prevNumPairs = broadphase->activePairs.size();
+		arena->Step(1);
+
+		size_t numPairs = broadphase->activePairs.size();
+		RS_CHECK_EQ(numPairs, prevNumPairs + broadphase->numPairsAdded - broadphase->numPairsRemoved);
+		RS_CHECK_EQ(numPairs, (size_t)(broadphase->numPairsAdded + broadphase->numPairsPersisted));
+		RS_CHECK_EQ((size_t)broadphase->m_pairCache->getNumOverlappingPairs(), numPairs);
+		RS_CHECK(broadphase->activePairs == GetBruteForcePairs(broadphase, numHandles));
+
+		totalAdded += broadphase->numPairsAdded;
+		totalRemoved += broadphase->numPairsRemoved;
+
+		if (Test::numFailedChecks > 0)
+			break;
+	}
+
+	// Make sure pairs actually changed
+	RS_CHECK(totalAdded > 10);
+	RS_CHECK(totalRemoved > 10);
+
+	delete arena;
+}
+
+// A standalone broadphase over a world of 1uu cells, with proxies for objects borrowed from an arena
+// The broadphase only reads whether an object is static and whether its shape is a triangle mesh, so a static plane and the ball stand in for every proxy
+struct StandaloneBroadphase {
+	static constexpr float WORLD_SIZE_X = 40, WORLD_SIZE_Y = 40, WORLD_SIZE_Z = 20;
+
+	Arena* arena;
+	btRSBroadphase* broadphase;
+	btCollisionObject* staticObj = NULL;
+	btCollisionObject* dynamicObj;
+	std::vector<btBroadphaseProxy*> proxies;
+
+	StandaloneBroadphase(bool sparseGrid) {
+		arena = Test::MakeArena(GameMode::SOCCAR, 0, 0);
+		for (btRigidBody* rb : arena->_worldCollisionRBs)
+			if (rb->m_collisionShape->getShapeType() != TRIANGLE_MESH_SHAPE_PROXYTYPE)
+				staticObj = rb;
+		dynamicObj = &arena->ball->_rigidBody;
+
+		// Queries never touch the pair cache, and the arena has no pairs with these proxies to remove
+		broadphase = new btRSBroadphase(
+			btVector3(0, 0, 0), btVector3(WORLD_SIZE_X, WORLD_SIZE_Y, WORLD_SIZE_Z), 1,
+			arena->_bulletWorldParams.overlappingPairCache, 4096, sparseGrid
+		);
+	}
+
+	~StandaloneBroadphase() {
+		delete broadphase;
+		delete arena;
+	}
+
+	btBroadphaseProxy* Add(btVector3 aabbMin, btVector3 aabbMax, bool isStatic) {
+		btBroadphaseProxy* proxy = broadphase->createProxy(aabbMin, aabbMax, BOX_SHAPE_PROXYTYPE, isStatic ? staticObj : dynamicObj, 1, -1, NULL);
+		proxies.push_back(proxy);
+		return proxy;
+	}
+
+	// Random statics of every size (some spanning a good part of the world) and dynamics smaller than a cell
+	// A third of them are destroyed again, leaving holes in the handles
+	void AddRandom(int numStatic, int numDynamic, std::mt19937& rng) {
+		std::uniform_real_distribution<float> distX(0, WORLD_SIZE_X), distY(0, WORLD_SIZE_Y), distZ(0, WORLD_SIZE_Z), dist01(0, 1);
+		for (int i = 0; i < numStatic + numDynamic; i++) {
+			bool isStatic = i < numStatic;
+			btVector3 pos = btVector3(distX(rng), distY(rng), distZ(rng));
+			float size = isStatic ? (dist01(rng) < 0.1f ? 12 : 2) * dist01(rng) : 0.55f * dist01(rng);
+			btVector3 extent = btVector3(dist01(rng), dist01(rng), dist01(rng)) * size;
+			Add(pos, pos + extent, isStatic);
+		}
+
+		std::vector<btBroadphaseProxy*> keptProxies;
+		for (size_t i = 0; i < proxies.size(); i++) {
+			if (i % 3 == 1) {
+				broadphase->destroyProxy(proxies[i], NULL);
+			} else {
+				keptProxies.push_back(proxies[i]);
+			}
+		}
+		proxies = keptProxies;
+	}
+
+	// Many small statics packed into a few cells
+	void AddCluster(btVector3 center, int num, std::mt19937& rng) {
+		std::uniform_real_distribution<float> dist(-1, 1);
+		for (int i = 0; i < num; i++) {
+			btVector3 pos = center + btVector3(dist(rng), dist(rng), dist(rng));
+			Add(pos, pos + btVector3(0.2f, 0.2f, 0.2f), true);
+		}
+	}
+};
+
+// Records every proxy it is given, optionally keeping the closest hit to stop the broadphase early (like a closest-hit ray test)
+struct RecordingRayCallback : public btBroadphaseRayCallback {
+	btVector3 rayFrom;
+	bool keepClosestHit;
+	float maxHitFraction = 1;
+	std::vector<const btBroadphaseProxy*> processed;
+
+	// Same setup as btSingleRayCallback
+	RecordingRayCallback(btVector3 rayFrom, btVector3 rayTo, bool keepClosestHit) : rayFrom(rayFrom), keepClosestHit(keepClosestHit) {
+		btVector3 rayDir = (rayTo - rayFrom).normalized();
+		for (int i = 0; i < 3; i++) {
+			m_rayDirectionInverse[i] = (rayDir[i] == 0) ? BT_LARGE_FLOAT : 1 / rayDir[i];
+			m_signs[i] = m_rayDirectionInverse[i] < 0;
+		}
+		m_lambda_max = rayDir.dot(rayTo - rayFrom);
+	}
+
+	// Fraction of the ray at which it enters the proxy's AABB, or -1 if it misses it
+	float GetHitFraction(const btBroadphaseProxy* proxy) const {
+		btVector3 bounds[2] = { proxy->m_aabbMin, proxy->m_aabbMax };
+		btScalar hitLambda;
+		if (!btRayAabb2(rayFrom, m_rayDirectionInverse, m_signs, bounds, hitLambda, 0, m_lambda_max))
+			return -1;
+		return RS_MAX(hitLambda, 0.f) / m_lambda_max;
+	}
+
+	virtual bool process(const btBroadphaseProxy* proxy) {
+		processed.push_back(proxy);
+		float hitFraction = GetHitFraction(proxy);
+		if (keepClosestHit && hitFraction >= 0)
+			maxHitFraction = RS_MIN(maxHitFraction, hitFraction);
+		return true;
+	}
+
+	virtual btScalar getMaxHitFraction() const {
+		return maxHitFraction;
+	}
+};
+
+// Ray tests give every proxy that the ray hits, once, and can stop at the closest hit
+// Rays within the grid walk its cells and give only the hits, while rays leaving it give their start cell's proxies if short, and every proxy otherwise
+RS_TEST(BroadphaseRayTestMatchesBruteForce) {
+	{
+		// A short ray hitting a dynamic proxy from 2 cells past the cell of its AABB's min corner
+		StandaloneBroadphase world = StandaloneBroadphase(false);
+		btBroadphaseProxy* proxy = world.Add(btVector3(5.8f, 5.2f, 5.2f), btVector3(6.3f, 5.4f, 5.4f), false);
+		btVector3 rayFrom = btVector3(7.1f, 5.3f, 5.3f), rayTo = btVector3(6.2f, 5.3f, 5.3f);
+		RecordingRayCallback callback = RecordingRayCallback(rayFrom, rayTo, false);
+		world.broadphase->rayTest(rayFrom, rayTo, callback);
+		RS_CHECK(callback.processed == std::vector<const btBroadphaseProxy*>{ proxy });
+	}
+
+	int numShortRays = 0, numLongRays = 0, numEarlyExits = 0;
+	for (bool sparseGrid : { false, true }) {
+		StandaloneBroadphase world = StandaloneBroadphase(sparseGrid);
+		std::mt19937 rng(sparseGrid);
+		world.AddRandom(300, 150, rng);
+
+		std::uniform_real_distribution<float> distX(0, world.WORLD_SIZE_X), distY(0, world.WORLD_SIZE_Y), distZ(0, world.WORLD_SIZE_Z);
+		std::uniform_real_distribution<float> dist(-1, 1);
+		for (int rayIndex = 0; rayIndex < 3000; rayIndex++) {
+			btVector3 rayFrom = btVector3(distX(rng), distY(rng), distZ(rng));
+			btVector3 rayTo;
+			int rayType = rayIndex % 4;
+			if (rayType == 0) {
+				// Short
+				rayTo = rayFrom + btVector3(dist(rng), dist(rng), dist(rng)).normalized() * (0.9f * (dist(rng) * 0.5f + 0.5f));
+			} else if (rayType == 1) {
+				// Leaving the grid
+				rayTo = rayFrom + btVector3(dist(rng), dist(rng), dist(rng)).normalized() * 100;
+			} else {
+				// Anywhere in the grid, sometimes along an axis or plane
+				rayTo = btVector3(distX(rng), distY(rng), distZ(rng));
+				if (rayIndex % 12 == 2)
+					rayTo.setY(rayFrom.y());
+				if (rayIndex % 24 == 2)
+					rayTo.setZ(rayFrom.z());
+			}
+			bool isShort = rayFrom.distance(rayTo) < 1;
+			bool withinGrid = true;
+			btVector3 worldSize = btVector3(world.WORLD_SIZE_X, world.WORLD_SIZE_Y, world.WORLD_SIZE_Z);
+			for (int i = 0; i < 3; i++)
+				withinGrid &= rayTo[i] >= 0 && rayTo[i] < worldSize[i];
+
+			for (bool keepClosestHit : { false, true }) {
+				RecordingRayCallback callback = RecordingRayCallback(rayFrom, rayTo, keepClosestHit);
+				world.broadphase->rayTest(rayFrom, rayTo, callback);
+
+				std::vector<const btBroadphaseProxy*> hits;
+				const btBroadphaseProxy* closestHit = NULL;
+				float closestHitFraction = 2;
+				for (btBroadphaseProxy* proxy : world.proxies) {
+					float hitFraction = callback.GetHitFraction(proxy);
+					if (hitFraction < 0)
+						continue;
+					hits.push_back(proxy);
+					if (hitFraction < closestHitFraction) {
+						closestHit = proxy;
+						closestHitFraction = hitFraction;
+					}
+				}
+				std::sort(hits.begin(), hits.end());
+
+				std::vector<const btBroadphaseProxy*> processed = callback.processed;
+				std::sort(processed.begin(), processed.end());
+				RS_CHECK(std::adjacent_find(processed.begin(), processed.end()) == processed.end());
+
+				if (!withinGrid) {
+					RS_CHECK(std::includes(processed.begin(), processed.end(), hits.begin(), hits.end()));
+					if (!isShort)
+						RS_CHECK_EQ(processed.size(), world.proxies.size());
+				} else if (!keepClosestHit) {
+					RS_CHECK(processed == hits);
+					(isShort ? numShortRays : numLongRays)++;
+				} else {
+					// Only hits, including every hit closer than the closest one found (which is the closest of all)
+					RS_CHECK(std::includes(hits.begin(), hits.end(), processed.begin(), processed.end()));
+					RS_CHECK(!closestHit || std::binary_search(processed.begin(), processed.end(), closestHit));
+					for (const btBroadphaseProxy* hit : hits)
+						if (callback.GetHitFraction(hit) < callback.maxHitFraction)
+							RS_CHECK(std::binary_search(processed.begin(), processed.end(), hit));
+
+					if (processed.size() < hits.size())
+						numEarlyExits++;
+				}
+
+				if (Test::numFailedChecks > 0) {
+					std::cout << "  (ray " << rayIndex << ", sparse " << sparseGrid << ", closest hit " << keepClosestHit << ")" << std::endl;
+					return;
+				}
+			}
+		}
+	}
+
+	// The test covered what it is meant to
+	RS_CHECK(numShortRays > 500);
+	RS_CHECK(numLongRays > 1000);
+	RS_CHECK(numEarlyExits > 100);
+}
+
+struct RecordingAabbCallback : public btBroadphaseAabbCallback {
+	std::vector<const btBroadphaseProxy*> processed;
+
+	virtual bool process(const btBroadphaseProxy* proxy) {
+		processed.push_back(proxy);
+		return true;
+	}
+};
+
+// AABB queries give every proxy whose AABB overlaps the box, once, whether they scan every handle or visit the box's cells
+// aabbQuery() also counts the results that don't fit
+RS_TEST(BroadphaseAabbQueryMatchesBruteForce) {
+	constexpr int MIN_HANDLES_FOR_GRID = 32; // Same as _ForEachAabbOverlap()
+
+	// Queries of each path that _ForEachAabbOverlap() takes
+	int numSmallWorldScans = 0, numManyCellsScans = 0, numManyEntriesScans = 0, numGridWalks = 0;
+
+	for (bool sparseGrid : { false, true }) {
+		for (bool smallWorld : { true, false }) {
+			StandaloneBroadphase world = StandaloneBroadphase(sparseGrid);
+			std::mt19937 rng(sparseGrid * 2 + smallWorld);
+			btVector3 clusterCenter = btVector3(20, 20, 10);
+			if (smallWorld) {
+				world.AddRandom(12, 6, rng);
+			} else {
+				world.AddRandom(300, 150, rng);
+				world.AddCluster(clusterCenter, 400, rng);
+			}
+			btRSBroadphase* broadphase = world.broadphase;
+			int numHandlesToScan = broadphase->m_LastHandleIndex + 1;
+			RS_CHECK_EQ(smallWorld, numHandlesToScan < MIN_HANDLES_FOR_GRID);
+
+			std::uniform_real_distribution<float> distX(0, world.WORLD_SIZE_X), distY(0, world.WORLD_SIZE_Y), distZ(0, world.WORLD_SIZE_Z);
+			std::uniform_real_distribution<float> dist01(0, 1);
+			for (int queryIndex = 0; queryIndex < 2000; queryIndex++) {
+				btVector3 center = (queryIndex % 4 == 3) ? clusterCenter : btVector3(distX(rng), distY(rng), distZ(rng));
+				float halfSize = (queryIndex % 8 == 0) ? (10 + 20 * dist01(rng)) : (0.05f + 2 * dist01(rng));
+				btVector3 aabbMin = center - btVector3(dist01(rng), dist01(rng), dist01(rng)) * halfSize;
+				btVector3 aabbMax = center + btVector3(dist01(rng), dist01(rng), dist01(rng)) * halfSize;
+
+				std::vector<const btBroadphaseProxy*> expected;
+				for (btBroadphaseProxy* proxy : world.proxies)
+					if (TestAabbAgainstAabb2(aabbMin, aabbMax, proxy->m_aabbMin, proxy->m_aabbMax))
+						expected.push_back(proxy);
+				std::sort(expected.begin(), expected.end());
+
+				RecordingAabbCallback callback = {};
+				broadphase->aabbTest(aabbMin, aabbMax, callback);
+				std::sort(callback.processed.begin(), callback.processed.end());
+				RS_CHECK(callback.processed == expected);
+
+				std::vector<btBroadphaseProxy*> results(world.proxies.size());
+				int numResults = broadphase->aabbQuery(aabbMin, aabbMax, results.data(), (int)results.size());
+				RS_CHECK_EQ(numResults, (int)expected.size());
+				std::sort(results.begin(), results.begin() + RS_MIN(numResults, (int)results.size()));
+				RS_CHECK(std::equal(expected.begin(), expected.end(), results.begin(), results.begin() + RS_MIN(numResults, (int)results.size())));
+
+				// Only some of the results fit, with no duplicates between them
+				int maxResults = (int)expected.size() / 2;
+				std::vector<btBroadphaseProxy*> partialResults(maxResults + 1);
+				RS_CHECK_EQ(broadphase->aabbQuery(aabbMin, aabbMax, partialResults.data(), maxResults), (int)expected.size());
+				partialResults.pop_back();
+				std::sort(partialResults.begin(), partialResults.end());
+				RS_CHECK(std::adjacent_find(partialResults.begin(), partialResults.end()) == partialResults.end());
+				RS_CHECK(std::includes(expected.begin(), expected.end(), partialResults.begin(), partialResults.end()));
+
+				if (Test::numFailedChecks > 0) {
+					std::cout << "  (query " << queryIndex << ", sparse " << sparseGrid << ", small world " << smallWorld << ")" << std::endl;
+					return;
+				}
+
+				// Find the path the query took, from the same counts as _ForEachAabbOverlap()
+				if (smallWorld) {
+					numSmallWorldScans++;
+					continue;
+				}
+
+				int iMin, jMin, kMin, iMax, jMax, kMax;
+				broadphase->GetCellIndices(aabbMin, iMin, jMin, kMin);
+				broadphase->GetCellIndices(aabbMax, iMax, jMax, kMax);
+				int numCells = (iMax - iMin + 1) * (jMax - jMin + 1) * (kMax - kMin + 1);
+				if (numCells >= numHandlesToScan) {
+					numManyCellsScans++;
+					continue;
+				}
+
+				size_t numEntries = 0;
+				for (int i = iMin; i <= iMax; i++) {
+					for (int j = jMin; j <= jMax; j++) {
+						for (int k = kMin; k <= kMax; k++) {
+							int cellIdx = broadphase->GetCellIdx(i, j, k);
+							numEntries += broadphase->staticGrid->cellHandles[cellIdx].size() + broadphase->dynCells[cellIdx].size();
+						}
+					}
+				}
+				if (numEntries > (size_t)numHandlesToScan) {
+					numManyEntriesScans++;
+				} else {
+					numGridWalks++;
+				}
+			}
+		}
+	}
+
+	// The test covered what it is meant to
+	RS_CHECK(numSmallWorldScans > 100);
+	RS_CHECK(numManyCellsScans > 100);
+	RS_CHECK(numManyEntriesScans > 100);
+	RS_CHECK(numGridWalks > 1000);
+}
+
+// Cell lists hold exactly what was added and not removed, through cells overflowing to bigger and bigger blocks and shrinking back inline
+// Blocks and slots that are given back get reused
+RS_TEST(BroadphaseCellLists) {
+	constexpr int NUM_CELLS = 16;
+	constexpr int MAX_CELL_SIZE = 100; // Several block capacity classes past the inline capacity
+
+	for (bool sparse : { false, true }) {
+		// Cell lists of a broadphase with no proxies, as their hash map can't be freed outside of the library
+		StandaloneBroadphase world = StandaloneBroadphase(sparse);
+		btRSBroadphaseCellLists& cellLists = world.broadphase->dynCells;
+		std::vector<std::vector<int>> expectedCells(NUM_CELLS);
+		std::mt19937 rng(sparse);
+
+		auto fnCheckCells = [&]() {
+			int numNonEmptyCells = 0;
+			for (int cellIdx = 0; cellIdx < NUM_CELLS; cellIdx++) {
+				auto span = cellLists[cellIdx];
+				std::vector<int> entries(span.begin(), span.end());
+				std::vector<int> expected = expectedCells[cellIdx];
+				std::sort(entries.begin(), entries.end());
+				std::sort(expected.begin(), expected.end());
+				RS_CHECK(entries == expected);
+				numNonEmptyCells += !expected.empty();
+
+				// Stored inline whenever it fits
+				int slot = cellLists.getSlot(cellIdx);
+				if (slot >= 0)
+					RS_CHECK_EQ(cellLists.overflowOffsets[slot] >= 0, (int)expected.size() > btRSBroadphaseCellLists::INLINE_CAPACITY);
+			}
+			if (sparse)
+				RS_CHECK_EQ(cellLists.getNumSlots(), numNonEmptyCells);
+		};
+
+		size_t poolSizeAfterFirstCycle = 0;
+		for (int cycle = 0; cycle < 4; cycle++) {
+			// Fill every cell to a random size, some staying inline
+			for (int cellIdx = 0; cellIdx < NUM_CELLS; cellIdx++) {
+				int size = (cellIdx % 4 == 0) ? btRSBroadphaseCellLists::INLINE_CAPACITY : std::uniform_int_distribution<int>(1, MAX_CELL_SIZE)(rng);
+				for (int i = 0; i < size; i++) {
+					int value = cellIdx * 1000 + i;
+					cellLists.add(cellIdx, value);
+					expectedCells[cellIdx].push_back(value);
+				}
+			}
+			fnCheckCells();
+
+			// Empty them in a random order, so entries get swapped around
+			std::vector<std::pair<int, int>> toRemove;
+			for (int cellIdx = 0; cellIdx < NUM_CELLS; cellIdx++)
+				for (int value : expectedCells[cellIdx])
+					toRemove.push_back({ cellIdx, value });
+			std::shuffle(toRemove.begin(), toRemove.end(), rng);
+
+			for (size_t i = 0; i < toRemove.size(); i++) {
+				auto [cellIdx, value] = toRemove[i];
+				RS_CHECK(cellLists.contains(cellIdx, value));
+				cellLists.remove(cellIdx, value);
+				RS_CHECK(!cellLists.contains(cellIdx, value));
+
+				auto& expected = expectedCells[cellIdx];
+				expected.erase(std::find(expected.begin(), expected.end(), value));
+
+				// Values that aren't in the cell (or in any cell) are ignored
+				cellLists.remove(cellIdx, -1);
+				cellLists.remove((cellIdx + 1) % NUM_CELLS, value);
+
+				if (i % 50 == 0)
+					fnCheckCells();
+			}
+			fnCheckCells();
+
+			if (cycle == 0) {
+				poolSizeAfterFirstCycle = cellLists.overflowPool.size();
+				RS_CHECK(poolSizeAfterFirstCycle > 0);
+			}
+
+			if (Test::numFailedChecks > 0) {
+				std::cout << "  (cycle " << cycle << ", sparse " << sparse << ")" << std::endl;
+				return;
+			}
+		}
+
+		// Later cycles reused the blocks of the first one, as no cell got bigger than MAX_CELL_SIZE
+		// (A block can be one capacity class too big for its cell's new size, so allow for the pool to double once)
+		RS_CHECK(cellLists.overflowPool.size() <= poolSizeAfterFirstCycle * 2);
+		if (sparse)
+			RS_CHECK_EQ(cellLists.getNumSlots(), 0);
+	}
+}
+
+// Static grid entries only take memory for handles that were added to it, not for every handle the broadphase could have
+RS_TEST(BroadphaseStaticGridEntries) {
+	StandaloneBroadphase world = StandaloneBroadphase(false);
+	RS_CHECK(world.broadphase->staticGrid->entries.empty());
+
+	std::mt19937 rng(0);
+	world.AddRandom(30, 30, rng);
+	btRSBroadphase* broadphase = world.broadphase;
+	RS_CHECK(!broadphase->staticGrid->entries.empty());
+	RS_CHECK((int)broadphase->staticGrid->entries.size() <= broadphase->m_LastHandleIndex + 1);
+
+	// Valid for exactly the static proxies that exist
+	for (int i = 0; i <= broadphase->m_LastHandleIndex; i++) {
+		btRSBroadphaseProxy* proxy = &broadphase->m_pHandles[i];
+		RS_CHECK_EQ(broadphase->staticGrid->getEntry(i).valid, proxy->m_clientObject && proxy->isStatic);
+	}
+	RS_CHECK(!broadphase->staticGrid->getEntry(broadphase->m_maxHandles - 1).valid);
+}
+
+// A sparse grid has the same cell contents as a dense one through creating, moving, and destroying proxies, while only storing the occupied cells
+RS_TEST(BroadphaseSparseMatchesDense) {
+	StandaloneBroadphase denseWorld = StandaloneBroadphase(false), sparseWorld = StandaloneBroadphase(true);
+	std::mt19937 denseRNG(0), sparseRNG(0);
+	denseWorld.AddRandom(200, 100, denseRNG);
+	sparseWorld.AddRandom(200, 100, sparseRNG);
+
+	auto fnCheckCells = [&]() {
+		btRSBroadphase* dense = denseWorld.broadphase;
+		btRSBroadphase* sparse = sparseWorld.broadphase;
+		RS_CHECK_EQ(sparse->m_LastHandleIndex, dense->m_LastHandleIndex);
+
+		for (bool isStatic : { true, false }) {
+			const btRSBroadphaseCellLists& denseCells = isStatic ? dense->staticGrid->cellHandles : dense->dynCells;
+			const btRSBroadphaseCellLists& sparseCells = isStatic ? sparse->staticGrid->cellHandles : sparse->dynCells;
+
+			int numNonEmptyCells = 0;
+			for (int cellIdx = 0; cellIdx < dense->totalCells; cellIdx++) {
+				auto denseSpan = denseCells[cellIdx], sparseSpan = sparseCells[cellIdx];
+				std::vector<int> denseEntries(denseSpan.begin(), denseSpan.end()), sparseEntries(sparseSpan.begin(), sparseSpan.end());
+				std::sort(denseEntries.begin(), denseEntries.end());
+				std::sort(sparseEntries.begin(), sparseEntries.end());
+				RS_CHECK(sparseEntries == denseEntries);
+				numNonEmptyCells += !denseEntries.empty();
+
+				if (Test::numFailedChecks > 0) {
+					std::cout << "  (cell " << cellIdx << ", static " << isStatic << ")" << std::endl;
+					return;
+				}
+			}
+
+			RS_CHECK_EQ(sparseCells.getNumSlots(), numNonEmptyCells);
+			RS_CHECK(numNonEmptyCells < dense->totalCells / 2);
+		}
+	};
+	fnCheckCells();
+
+	// Move a third of the proxies (dynamics by up to a cell, some out of the grid), and destroy another third
+	std::uniform_real_distribution<float> dist(-1, 1);
+	for (size_t i = 0; i < denseWorld.proxies.size(); i++) {
+		btBroadphaseProxy* denseProxy = denseWorld.proxies[i];
+		btBroadphaseProxy* sparseProxy = sparseWorld.proxies[i];
+		if (i % 3 == 0) {
+			btVector3 offset = btVector3(dist(denseRNG), dist(denseRNG), dist(denseRNG)) * (((btRSBroadphaseProxy*)denseProxy)->isStatic ? 5 : 1);
+			btVector3 aabbMin = denseProxy->m_aabbMin + offset, aabbMax = denseProxy->m_aabbMax + offset;
+			denseWorld.broadphase->setAabb(denseProxy, aabbMin, aabbMax, NULL);
+			sparseWorld.broadphase->setAabb(sparseProxy, aabbMin, aabbMax, NULL);
+		} else if (i % 3 == 1) {
+			denseWorld.broadphase->destroyProxy(denseProxy, NULL);
+			sparseWorld.broadphase->destroyProxy(sparseProxy, NULL);
+		}
+	}
+	fnCheckCells();
+}
@@ -0,0 +1,182 @@
+#include "Test.h"
+
+#include <RocketSim/Recording/Replay/Replay.h>
+
+using namespace RocketSim;
+
+// Many cars spread over the field, some close enough to touch each other and some alone
+// The first few start on big boost pads with no boost, so pads are picked up right away
+static Arena* MakeCarThreadsArena(int carUpdateThreads, int numCars) {
+	ArenaConfig config = {};
+	config.useCustomBroadphase = true;
+	config.carUpdateThreads = carUpdateThreads;
+
+	Arena* arena = Arena::Create(GameMode::SOCCAR, config);
+	for (int i = 0; i < numCars; i++)
+		arena->AddCar((i % 2) ? Team::ORANGE : Team::BLUE);
+	arena->ResetToRandomKickoff(0);
+
+	for (int i = 0; i < numCars; i++) {
+		Car* car = arena->GetCar(i + 1);
+		CarState state = car->GetState();
+		if (i < RLConst::BoostPads::LOCS_AMOUNT_BIG) {
+			state.pos = RLConst::BoostPads::LOCS_BIG_SOCCAR[i];
+			state.pos.z = 17;
+			state.boost = 0;
+		} else {
+			// Pairs of cars next to each other
+			int pairIndex = i / 2;
+			state.pos = Vec(-3000 + (pairIndex % 4) * 2000 + (i % 2) * 150, -3000 + (pairIndex / 4) * 1500, 17);
+		}
+		state.rotMat = RotMat::GetIdentity();
+		state.vel = state.angVel = Vec();
+		car->SetState(state);
+	}
+
+	return arena;
+}
+
+// Points a car at another one at supersonic speed, so it demos it
+static void LaunchDemo(Arena* arena, uint32_t bumperID, uint32_t victimID) {
+	Car* bumper = arena->GetCar(bumperID);
+	CarState victimState = arena->GetCar(victimID)->GetState();
+	if (victimState.isDemoed)
+		return;
+
+	Vec dir = Vec(1, 0, 0);
+	CarState state = bumper->GetState();
+	state.pos = victimState.pos - dir * 250;
+	state.rotMat = RotMat::GetIdentity();
+	state.vel = dir * 2300;
+	state.angVel = Vec();
+	state.isSupersonic = true;
+	state.isDemoed = false;
+	bumper->SetState(state);
+}
+
+// Whether two snapshots of the same arena hold the same state
+// Car and boost pad states are compared by field, as the padding bytes of states that were made on the stack (like when respawning) are undefined
+static bool SnapshotsMatch(const std::vector<byte>& bufferA, const std::vector<byte>& bufferB) {
+	if (bufferA.size() != bufferB.size())
+		return false;
+
+	ArenaSnapshotView viewA = ArenaSnapshotView::FromBuffer(bufferA.data(), bufferA.size());
+	ArenaSnapshotView viewB = ArenaSnapshotView::FromBuffer(bufferB.data(), bufferB.size());
+	const ArenaSnapshotHeader& header = *viewA.header;
+
+	// Everything else as bytes
+	auto fnBytesMatch = [&](size_t start, size_t end) {
+		return memcmp(bufferA.data() + start, bufferB.data() + start, end - start) == 0;
+	};
+	size_t carStatesEnd = header.offsets.carStates + sizeof(CarState) * header.numCars;
+	size_t padStatesEnd = header.offsets.boostPadStates + sizeof(BoostPadState) * header.numBoostPads;
+	if (!fnBytesMatch(0, header.offsets.carStates) || !fnBytesMatch(carStatesEnd, header.offsets.boostPadStates) || !fnBytesMatch(padStatesEnd, bufferA.size()))
+		return false;
+
+	for (uint32_t i = 0; i < header.numCars; i++) {
+		const CarState& stateA = viewA.carStates[i];
+		const CarState& stateB = viewB.carStates[i];
+
+		DataStreamOut outA, outB;
+		stateA.Serialize(outA);
+		stateB.Serialize(outB);
+		if (outA.data != outB.data)
+			return false;
+
+		// Not serialized
+		if (
+			stateA.tickCountSinceUpdate != stateB.tickCountSinceUpdate ||
+			memcmp(stateA.wheelsWithContact, stateB.wheelsWithContact, sizeof(stateA.wheelsWithContact)) != 0 ||
+			memcmp(&stateA.airTime, &stateB.airTime, sizeof(float)) != 0 ||
+			stateA.isSupersonic != stateB.isSupersonic ||
+			stateA.ballHitInfo.isValid != stateB.ballHitInfo.isValid
+		) {
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < header.numBoostPads; i++) {
+		const BoostPadState& stateA = viewA.boostPadStates[i];
+		const BoostPadState& stateB = viewB.boostPadStates[i];
+		if (
+			stateA.isActive != stateB.isActive ||
+			memcmp(&stateA.cooldown, &stateB.cooldown, sizeof(float)) != 0 ||
+			stateA.prevLockedCarID != stateB.prevLockedCarID
+		) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Updating cars on several threads gives exactly the same arena states as updating them in order on one, including demos and boost pickups
+// Both updates run on the same arena from the same snapshot, as the order cars are updated in (and so the result of some contacts) differs between arenas
+RS_TEST(CarThreadsMatchSingleThread) {
+	constexpr int NUM_CARS = 24;
+	constexpr int TICKS = 1500;
+	constexpr int DEMO_INTERVAL = 50;
+
+	Arena* arena = MakeCarThreadsArena(4, NUM_CARS);
+	ThreadTeam* team = arena->_carThreading.team;
+	RS_CHECK(team != NULL);
+
+	int numDemos = 0;
+	arena->SetCarBumpCallback(
+		[](Arena* arena, Car* bumper, Car* victim, bool isDemo, void* userInfo) {
+			if (isDemo)
+				(*(int*)userInfo)++;
+		},
+		&numDemos
+	);
+
+	std::vector<byte> snapshotBuffer(arena->GetSnapshotSize());
+	std::vector<byte> resultBuffers[2] = { snapshotBuffer, snapshotBuffer };
+	std::mt19937 rng(0);
+	int numSplitTicks = 0, numInactivePadTicks = 0;
+	for (int tick = 0; tick < TICKS; tick++) {
+		Test::RandomizeControls(arena, rng);
+
+		if (tick % DEMO_INTERVAL == 0) {
+			int demoIndex = tick / DEMO_INTERVAL;
+			LaunchDemo(arena, 1 + (demoIndex * 7) % NUM_CARS, 1 + (demoIndex * 7 + 1) % NUM_CARS);
+		}
+
+		size_t snapshotSize = arena->WriteSnapshot(snapshotBuffer.data(), snapshotBuffer.size());
+		ArenaSnapshotView snapshot = ArenaSnapshotView::FromBuffer(snapshotBuffer.data(), snapshotSize);
+
+		uint64_t hashes[2];
+		for (bool threaded : { true, false }) {
+			arena->ApplySnapshot(snapshot);
+			arena->_carThreading.team = threaded ? team : NULL;
+
+			// Respawn locations come from the global random engine
+			Math::GetRandEngine().seed(tick);
+			arena->Step(1);
+			hashes[threaded] = Replay::HashArenaState(arena);
+			arena->WriteSnapshot(resultBuffers[threaded].data(), resultBuffers[threaded].size());
+
+			if (threaded && !arena->_carThreading.independentCars.empty() && !arena->_carThreading.linkedCars.empty())
+				numSplitTicks++;
+		}
+		arena->_carThreading.team = team;
+
+		RS_CHECK_EQ(hashes[true], hashes[false]);
+		RS_CHECK(SnapshotsMatch(resultBuffers[true], resultBuffers[false]));
+		if (Test::numFailedChecks > 0) {
+			std::cout << "  (tick " << tick << ")" << std::endl;
+			break;
+		}
+
+		for (BoostPad* pad : arena->GetBoostPads())
+			if (!pad->GetState().isActive)
+				numInactivePadTicks++;
+	}
+
+	// The test covered what it is meant to
+	RS_CHECK(numSplitTicks > 0);
+	RS_CHECK(numDemos > 0);
+	RS_CHECK(numInactivePadTicks > 0);
+
+	delete arena;
+}
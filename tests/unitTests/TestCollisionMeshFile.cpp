@@ -0,0 +1,75 @@
+#include "Test.h"
+
+#include <array>
+
+using namespace RocketSim;
+
+// Vertex positions of a triangle, rotated to start at its smallest vertex so that the winding is kept
+static std::array<float, 9> GetTriangleKey(CollisionMeshFile& meshFile, const CollisionMeshFile::Triangle& tri) {
+	std::array<std::array<float, 3>, 3> verts;
+	for (int i = 0; i < 3; i++) {
+		CollisionMeshFile::Vertex& vertex = meshFile.vertices[tri.vertexIndexes[i]];
+		verts[i] = { vertex.x, vertex.y, vertex.z };
+	}
+
+	int first = (int)(std::min_element(verts.begin(), verts.end()) - verts.begin());
+	std::array<float, 9> key;
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			key[i * 3 + j] = verts[(first + i) % 3][j];
+	return key;
+}
+
+// Sorting a mesh for locality only reorders it: the same triangles with the same winding, every vertex still used, and the same hash
+RS_TEST(CollisionMeshSortKeepsTriangles) {
+	constexpr int GRID_SIZE = 30;
+
+	CollisionMeshFile meshFile = {};
+	for (int i = 0; i <= GRID_SIZE; i++)
+		for (int j = 0; j <= GRID_SIZE; j++)
+			meshFile.vertices.push_back({ (float)i, (float)j, sinf(i * 0.7f) * cosf(j * 0.5f) });
+
+	for (int i = 0; i < GRID_SIZE; i++) {
+		for (int j = 0; j < GRID_SIZE; j++) {
+			int a = i * (GRID_SIZE + 1) + j, b = a + 1, c = a + (GRID_SIZE + 1), d = c + 1;
+			meshFile.tris.push_back({ { a, c, b } });
+			meshFile.tris.push_back({ { b, c, d } });
+		}
+	}
+
+	// Not in any spatial order to begin with
+	std::mt19937 rng(0);
+	std::shuffle(meshFile.tris.begin(), meshFile.tris.end(), rng);
+	meshFile.UpdateHash();
+
+	std::vector<std::array<float, 9>> keys;
+	for (auto& tri : meshFile.tris)
+		keys.push_back(GetTriangleKey(meshFile, tri));
+	std::sort(keys.begin(), keys.end());
+
+	CollisionMeshFile sortedFile = meshFile;
+	sortedFile.SortForLocality();
+	RS_CHECK_EQ(sortedFile.hash, meshFile.hash);
+	RS_CHECK_EQ(sortedFile.tris.size(), meshFile.tris.size());
+	RS_CHECK_EQ(sortedFile.vertices.size(), meshFile.vertices.size());
+
+	std::vector<int> numVertexUses(sortedFile.vertices.size());
+	std::vector<std::array<float, 9>> sortedKeys;
+	for (auto& tri : sortedFile.tris) {
+		for (int idx : tri.vertexIndexes) {
+			RS_CHECK(idx >= 0 && idx < (int)sortedFile.vertices.size());
+			if (idx < 0 || idx >= (int)sortedFile.vertices.size())
+				return;
+			numVertexUses[idx]++;
+		}
+		sortedKeys.push_back(GetTriangleKey(sortedFile, tri));
+	}
+	std::sort(sortedKeys.begin(), sortedKeys.end());
+	RS_CHECK(sortedKeys == keys);
+
+	for (int numUses : numVertexUses)
+		RS_CHECK(numUses > 0);
+
+	// The order did change
+	RS_CHECK(sortedFile.tris.size() > 0 && memcmp(sortedFile.tris.data(), meshFile.tris.data(), meshFile.tris.size() * sizeof(CollisionMeshFile::Triangle)) != 0);
+}
@@ -0,0 +1,114 @@
+#include "Test.h"
+
+#include <RocketSim/Sim/CompactState/CompactState.h>
+
+using namespace RocketSim;
+
+static CarState MakeRandomCarState(std::mt19937& rng) {
+	std::uniform_real_distribution<float> dist(-1, 1);
+	std::uniform_real_distribution<float> unitDist(0, 1);
+	std::bernoulli_distribution boolDist(0.5);
+
+	CarState state = {};
+	state.pos = Vec(dist(rng) * 4000, dist(rng) * 5000, unitDist(rng) * 2000);
+	state.vel = Vec(dist(rng), dist(rng), dist(rng)) * 2300;
+	state.angVel = Vec(dist(rng), dist(rng), dist(rng)) * 5.5f;
+	state.rotMat = Angle(dist(rng) * M_PI, dist(rng) * M_PI / 2, dist(rng) * M_PI).ToRotMat();
+	state.boost = unitDist(rng) * 100;
+	state.jumpTime = unitDist(rng) * 0.2f;
+	state.flipTime = unitDist(rng) * 0.65f;
+	state.airTimeSinceJump = unitDist(rng) * 1.25f;
+	state.demoRespawnTimer = unitDist(rng) * 3;
+	state.flipRelTorque = Vec(dist(rng), dist(rng), 0);
+
+	state.isOnGround = boolDist(rng);
+	state.hasJumped = boolDist(rng);
+	state.hasFlipped = boolDist(rng);
+	state.isBoosting = boolDist(rng);
+	state.isSupersonic = boolDist(rng);
+	state.isDemoed = boolDist(rng);
+	state.worldContact.hasContact = boolDist(rng);
+	for (bool& hasContact : state.wheelsWithContact)
+		hasContact = boolDist(rng);
+	return state;
+}
+
+// Decoded states are within the error bounds documented in CompactState.h
+RS_TEST(CompactCarStateRoundTrip) {
+	constexpr int NUM_STATES = 1000;
+	constexpr float EPSILON = 1e-4f; // For float rounding of the quantized values
+
+	CompactState::Config config = {};
+	std::mt19937 rng(0);
+
+	std::vector<CarState> states(NUM_STATES);
+	for (CarState& state : states)
+		state = MakeRandomCarState(rng);
+
+	std::vector<CompactState::CompactCarState> compactStates(NUM_STATES);
+	CompactState::EncodeCars(states.data(), NUM_STATES, compactStates.data(), config);
+
+	std::vector<CarState> decodedStates(NUM_STATES);
+	for (CarState& decodedState : decodedStates)
+		decodedState.timeSinceBoosted = 123; // Not encoded, so must be left untouched
+	CompactState::DecodeCars(compactStates.data(), NUM_STATES, decodedStates.data(), config);
+
+	for (int i = 0; i < NUM_STATES; i++) {
+		const CarState& state = states[i];
+		const CarState& decoded = decodedStates[i];
+
+		for (int j = 0; j < 3; j++) {
+			RS_CHECK_NEAR(decoded.pos[j], state.pos[j], config.posStep / 2 + EPSILON);
+			RS_CHECK_NEAR(decoded.vel[j], state.vel[j], config.velStep / 2 + EPSILON);
+			RS_CHECK_NEAR(decoded.angVel[j], state.angVel[j], config.angVelStep / 2 + EPSILON);
+
+			for (int k = 0; k < 3; k++)
+				RS_CHECK_NEAR(decoded.rotMat[j][k], state.rotMat[j][k], 0.003f);
+		}
+
+		RS_CHECK_NEAR(decoded.boost, state.boost, 100.f / 255 / 2 + EPSILON);
+		RS_CHECK_NEAR(decoded.jumpTime, state.jumpTime, config.timeStep / 2 + EPSILON);
+		RS_CHECK_NEAR(decoded.flipTime, state.flipTime, config.timeStep / 2 + EPSILON);
+		RS_CHECK_NEAR(decoded.airTimeSinceJump, state.airTimeSinceJump, config.timeStep / 2 + EPSILON);
+		RS_CHECK_NEAR(decoded.demoRespawnTimer, state.demoRespawnTimer, config.timeStep / 2 + EPSILON);
+		RS_CHECK_NEAR(decoded.flipRelTorque.x, state.flipRelTorque.x, 1.f / 127 / 2 + EPSILON);
+		RS_CHECK_NEAR(decoded.flipRelTorque.y, state.flipRelTorque.y, 1.f / 127 / 2 + EPSILON);
+		RS_CHECK_EQ(decoded.flipRelTorque.z, 0.f);
+
+		RS_CHECK_EQ(CompactState::GetCarFlags(decoded), CompactState::GetCarFlags(state));
+		RS_CHECK_EQ(decoded.timeSinceBoosted, 123.f);
+	}
+
+	// Encoding decoded states again gives the same bytes
+	std::vector<CompactState::CompactCarState> reencodedStates(NUM_STATES);
+	CompactState::EncodeCars(decodedStates.data(), NUM_STATES, reencodedStates.data(), config);
+	for (int i = 0; i < NUM_STATES; i++) {
+		auto& compact = compactStates[i];
+		auto& reencoded = reencodedStates[i];
+		RS_CHECK(memcmp(compact.phys.pos, reencoded.phys.pos, sizeof(compact.phys.pos)) == 0);
+		RS_CHECK(memcmp(compact.phys.vel, reencoded.phys.vel, sizeof(compact.phys.vel)) == 0);
+		RS_CHECK_EQ(compact.boost, reencoded.boost);
+		RS_CHECK_EQ(compact.flags, reencoded.flags);
+	}
+}
+
+// Values beyond the range of the step size are clamped, not wrapped
+RS_TEST(CompactStateClamping) {
+	CompactState::Config config = {};
+
+	BallState state = {};
+	state.pos = Vec(1e6f, -1e6f, 100);
+	state.vel = Vec(config.velStep * 40000, 0, -config.velStep * 40000);
+
+	CompactState::CompactBallState compactState;
+	CompactState::EncodeBalls(&state, 1, &compactState, config);
+
+	BallState decoded = {};
+	CompactState::DecodeBalls(&compactState, 1, &decoded, config);
+
+	RS_CHECK_NEAR(decoded.pos.x, config.posStep * 32767, 1e-3f);
+	RS_CHECK_NEAR(decoded.pos.y, -config.posStep * 32767, 1e-3f);
+	RS_CHECK_NEAR(decoded.pos.z, 100, config.posStep / 2);
+	RS_CHECK_NEAR(decoded.vel.x, config.velStep * 32767, 1e-3f);
+	RS_CHECK_NEAR(decoded.vel.z, -config.velStep * 32767, 1e-3f);
+}
@@ -0,0 +1,159 @@
+#include "Test.h"
+
+#include <cfloat>
+
+using namespace RocketSim;
+
+// The RLConst curves as they were defined before they became FixedLinearPieceCurves, evaluated by LinearPieceCurve
+struct CurveComparison {
+	const char* name;
+	std::function<float(float)> fnGetFixedOutput;
+	std::function<void(const float[4], float[4])> fnGetFixedOutput4;
+	LinearPieceCurve reference;
+};
+
+#define CURVE_COMPARISON(curveName, ...) \
+	CurveComparison { \
+		#curveName, \
+		[](float input) { return RLConst::curveName.GetOutput(input); }, \
+		[](const float input[4], float output[4]) { RLConst::curveName.GetOutput4(input, output); }, \
+		LinearPieceCurve{ __VA_ARGS__ } \
+	}
+
+static std::vector<CurveComparison> GetCurveComparisons() {
+	return {
+		CURVE_COMPARISON(STEER_ANGLE_FROM_SPEED_CURVE, {
+			{0,		0.53356f},
+			{500,	0.31930f},
+			{1000,	0.18203f},
+			{1500,	0.10570f},
+			{1750,	0.08507f},
+			{3000,	0.03454f}
+		}),
+		CURVE_COMPARISON(STEER_ANGLE_FROM_SPEED_CURVE_THREEWHEEL, {
+			{0,		0.342473f},
+			{2300,	0.034837f}
+		}),
+		CURVE_COMPARISON(POWERSLIDE_STEER_ANGLE_FROM_SPEED_CURVE, {
+			{0,		0.39235f},
+			{2500,	0.12610f},
+		}),
+		CURVE_COMPARISON(DRIVE_SPEED_TORQUE_FACTOR_CURVE, {
+			{0,		1.0f},
+			{1400,	0.1f},
+			{1410,	0.0f}
+		}),
+		CURVE_COMPARISON(NON_STICKY_FRICTION_FACTOR_CURVE, {
+			{0,			0.1f},
+			{0.7075f,	0.5f},
+			{1,			1.0f}
+		}),
+		CURVE_COMPARISON(LAT_FRICTION_CURVE, {
+			{0,	1.0f},
+			{1,	0.2f},
+		}),
+		CURVE_COMPARISON(LAT_FRICTION_CURVE_THREEWHEEL, {
+			{0,	0.30f},
+			{1,	0.25f},
+		}),
+		CURVE_COMPARISON(LONG_FRICTION_CURVE, {
+			// Empty curve, so the default output of 1
+		}),
+		CURVE_COMPARISON(HANDBRAKE_LAT_FRICTION_FACTOR_CURVE, {
+			{0,	0.1f},
+		}),
+		CURVE_COMPARISON(HANDBRAKE_LONG_FRICTION_FACTOR_CURVE, {
+			{0,	0.5f},
+			{1,	0.9f}
+		}),
+		CURVE_COMPARISON(BALL_CAR_EXTRA_IMPULSE_FACTOR_CURVE, {
+			{     0, 0.65f},
+			{ 500.f, 0.65f},
+			{2300.f, 0.55f},
+			{4600.f, 0.30f}
+		}),
+		CURVE_COMPARISON(BUMP_VEL_AMOUNT_GROUND_CURVE, {
+			{0.f, (5.f / 6.f)},
+			{1400.f, 1100.f},
+			{2200.f, 1530.f},
+		}),
+		CURVE_COMPARISON(BUMP_VEL_AMOUNT_AIR_CURVE, {
+			{0.f, (5.f / 6.f)},
+			{1400.f, 1390.f},
+			{2200.f, 1945.f},
+		}),
+		CURVE_COMPARISON(BUMP_UPWARD_VEL_AMOUNT_CURVE, {
+			{0.f, (2.f / 6.f)},
+			{1400.f, 278.f},
+			{2200.f, 417.f},
+		}),
+	};
+}
+
+// Every RLConst curve gives the outputs of the map-based curve it replaced, across and beyond its range
+// Outputs at the points and outside of the range (clamped) are exact
+// Between points, the precomputed slopes round differently than dividing first, so they can be a few float steps apart
+RS_TEST(CurvesMatchLinearPieceCurve) {
+	constexpr int NUM_SWEEP_INPUTS = 100000;
+
+	for (const CurveComparison& curve : GetCurveComparisons()) {
+		const auto& mappings = curve.reference.valueMappings;
+		float firstInput = mappings.empty() ? 0 : mappings.begin()->first;
+		float lastInput = mappings.empty() ? 0 : mappings.rbegin()->first;
+
+		float maxAbsOutput = 1;
+		for (auto& pair : mappings)
+			maxAbsOutput = RS_MAX(maxAbsOutput, abs(pair.second));
+		float maxInterpError = 8 * FLT_EPSILON * maxAbsOutput;
+
+		// Inputs where the output must be exact
+		std::vector<float> exactInputs = { -1e30f, 1e30f };
+		for (auto& pair : mappings) {
+			exactInputs.push_back(pair.first);
+			if (pair.first == firstInput)
+				exactInputs.push_back(std::nextafter(pair.first, -FLT_MAX));
+			if (pair.first == lastInput)
+				exactInputs.push_back(std::nextafter(pair.first, FLT_MAX));
+		}
+
+		// Sweep half the range past both ends
+		std::vector<float> sweepInputs;
+		float span = RS_MAX(lastInput - firstInput, 1.f);
+		for (int i = 0; i <= NUM_SWEEP_INPUTS; i++)
+			sweepInputs.push_back(firstInput - span / 2 + 2 * span * i / NUM_SWEEP_INPUTS);
+		for (auto& pair : mappings)
+			for (float dir : { -FLT_MAX, FLT_MAX })
+				sweepInputs.push_back(std::nextafter(pair.first, dir));
+
+		int numFailedBefore = Test::numFailedChecks;
+		for (float input : exactInputs)
+			RS_CHECK_EQ(curve.fnGetFixedOutput(input), curve.reference.GetOutput(input));
+
+		for (float input : sweepInputs) {
+			float output = curve.fnGetFixedOutput(input);
+			float refOutput = curve.reference.GetOutput(input);
+			if (input <= firstInput || input >= lastInput) {
+				RS_CHECK_EQ(output, refOutput);
+			} else {
+				RS_CHECK_NEAR(output, refOutput, maxInterpError);
+			}
+
+			if (Test::numFailedChecks > numFailedBefore)
+				break;
+		}
+
+		// GetOutput4() is the same as GetOutput() for each input
+		for (size_t i = 0; i + 4 <= sweepInputs.size(); i += 4) {
+			float outputs[4];
+			curve.fnGetFixedOutput4(&sweepInputs[i], outputs);
+			for (int j = 0; j < 4; j++)
+				RS_CHECK_EQ(outputs[j], curve.fnGetFixedOutput(sweepInputs[i + j]));
+
+			if (Test::numFailedChecks > numFailedBefore)
+				break;
+		}
+
+		if (Test::numFailedChecks > numFailedBefore)
+			std::cout << "  (curve " << curve.name << ")" << std::endl;
+	}
+}
@@ -0,0 +1,128 @@
+#include "Test.h"
+
+#include <RocketSim/DataStream/DataStreamIn.h>
+
+using namespace RocketSim;
+
+// Writes values of mixed sizes, including writes bigger than the stream's buffer
+static void WriteTestData(DataStreamOut& out, std::vector<byte>& bigBlock) {
+	bigBlock.resize(1000);
+	for (size_t i = 0; i < bigBlock.size(); i++)
+		bigBlock[i] = (byte)(i * 7);
+
+	for (int i = 0; i < 500; i++) {
+		out.Write<uint32_t>(i);
+		out.Write<float>(i * 0.5f);
+		out.Write<Vec>(Vec(i, -i, i * 2));
+		out.WriteMultiple((uint8_t)i, (uint64_t)i * 1000);
+
+		if (i % 100 == 0)
+			out.WriteBytes(bigBlock.data(), bigBlock.size());
+	}
+}
+
+static void CheckTestData(DataStreamIn& in, const std::vector<byte>& bigBlock) {
+	for (int i = 0; i < 500; i++) {
+		RS_CHECK_EQ(in.Read<uint32_t>(), (uint32_t)i);
+		RS_CHECK_EQ(in.Read<float>(), i * 0.5f);
+		Vec vec;
+		in.ReadMultiple(vec.x, vec.y, vec.z);
+		RS_CHECK(vec == Vec(i, -i, i * 2));
+		RS_CHECK_EQ(in.Read<uint32_t>(), 2u);
+		RS_CHECK_EQ((int)in.Read<uint8_t>(), (int)(uint8_t)i);
+		RS_CHECK_EQ(in.Read<uint64_t>(), (uint64_t)i * 1000);
+
+		if (i % 100 == 0) {
+			std::vector<byte> readBlock(bigBlock.size());
+			in.ReadBytes(readBlock.data(), readBlock.size());
+			RS_CHECK(readBlock == bigBlock);
+		}
+
+		if (Test::numFailedChecks > 0)
+			break;
+	}
+	RS_CHECK(in.IsDone() && !in.IsOverflown());
+}
+
+// A streaming DataStreamOut writes exactly what an in-memory one would, and reads back the same
+RS_TEST(DataStreamStreaming) {
+	constexpr size_t BUFFER_CAPACITY = 256;
+	std::vector<byte> bigBlock;
+
+	DataStreamOut memoryOut = {};
+	memoryOut.Write<uint32_t>(RS_VERSION_ID);
+	WriteTestData(memoryOut, bigBlock);
+
+	std::vector<byte> sinkData;
+	size_t maxFlushSize = 0, numFlushes = 0;
+	{
+		DataStreamOut sinkOut(
+			[&](const byte* data, size_t size) {
+				sinkData.insert(sinkData.end(), data, data + size);
+				if (size < bigBlock.size())
+					maxFlushSize = RS_MAX(maxFlushSize, size);
+				numFlushes++;
+			},
+			true, BUFFER_CAPACITY
+		);
+		WriteTestData(sinkOut, bigBlock);
+		RS_CHECK_EQ(sinkOut.pos, memoryOut.pos);
+		sinkOut.Close();
+		RS_CHECK(!sinkOut.IsStreaming());
+	}
+	RS_CHECK(sinkData == memoryOut.data);
+	RS_CHECK(maxFlushSize <= BUFFER_CAPACITY);
+	RS_CHECK(numFlushes > 10);
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_stream.bin";
+	{
+		DataStreamOut fileOut = DataStreamOut::ToFile(path, true, BUFFER_CAPACITY);
+		WriteTestData(fileOut, bigBlock);
+		fileOut.Close();
+	}
+
+	for (bool memoryMap : { false, true }) {
+		DataStreamIn in(path, true, memoryMap);
+		CheckTestData(in, bigBlock);
+	}
+	std::filesystem::remove(path);
+}
+
+// Write errors are reported by Close(), and never thrown from the destructor or move assignment
+RS_TEST(DataStreamErrors) {
+	auto fnFailingSink = [](const byte* data, size_t size) {
+		RS_ERR_CLOSE("Test sink failed");
+	};
+
+	bool closeFailed = false;
+	try {
+		DataStreamOut out(fnFailingSink, true);
+		out.Close();
+	} catch (std::exception&) {
+		closeFailed = true;
+	}
+	RS_CHECK(closeFailed);
+
+	// Would terminate if these threw
+	{
+		DataStreamOut out(fnFailingSink, true);
+		out = DataStreamOut();
+	}
+	{
+		DataStreamOut out(fnFailingSink, true);
+	}
+
+#ifndef _WIN32
+	// Every write to /dev/full fails
+	if (std::filesystem::exists("/dev/full")) {
+		bool fullFailed = false;
+		try {
+			DataStreamOut out = DataStreamOut::ToFile("/dev/full", true);
+			out.Close();
+		} catch (std::exception&) {
+			fullFailed = true;
+		}
+		RS_CHECK(fullFailed);
+	}
+#endif
+}
@@ -0,0 +1,141 @@
+#include "Test.h"
+
+#include <RocketSim/Recording/Replay/Replay.h>
+
+using namespace RocketSim;
+
+constexpr int NUM_DROPSHOT_TILES = RLConst::Dropshot::TEAM_AMOUNT * RLConst::Dropshot::NUM_TILES_PER_TEAM;
+
+// The neighbor table has the neighbors that were found for each call before: the tile itself for radius 1, and every tile within 1.2 or 2.4 tile widths for radius 2 or 3
+RS_TEST(DropshotNeighborTable) {
+	constexpr float NEIGHBOR_MAX_RADIUS = RLConst::Dropshot::TILE_WIDTH_X * 1.2f;
+
+	for (int i = 0; i < RLConst::Dropshot::NUM_TILES_PER_TEAM; i++) {
+		RS_CHECK(DropshotTiles::GetNeighborIndices(i, 1) == std::vector<int>{ i });
+
+		Vec pos = DropshotTiles::GetTilePos(0, i);
+		for (int radius : { 2, 3 }) {
+			std::vector<int> refNeighbors;
+			for (int j = 0; j < RLConst::Dropshot::NUM_TILES_PER_TEAM; j++)
+				if (pos.Dist(DropshotTiles::GetTilePos(0, j)) < NEIGHBOR_MAX_RADIUS * (radius - 1))
+					refNeighbors.push_back(j);
+
+			RS_CHECK(DropshotTiles::GetNeighborIndices(i, radius) == refNeighbors);
+		}
+
+		// Served from the same table every time
+		RS_CHECK(&DropshotTiles::GetNeighborIndices(i, 3) == &DropshotTiles::GetNeighborIndices(i, 3));
+	}
+
+	// A tile in the middle has a full ring of 6 neighbors, and 12 more around those
+	int maxNeighbors2 = 0, maxNeighbors3 = 0;
+	for (int i = 0; i < RLConst::Dropshot::NUM_TILES_PER_TEAM; i++) {
+		maxNeighbors2 = RS_MAX(maxNeighbors2, (int)DropshotTiles::GetNeighborIndices(i, 2).size());
+		maxNeighbors3 = RS_MAX(maxNeighbors3, (int)DropshotTiles::GetNeighborIndices(i, 3).size());
+	}
+	RS_CHECK_EQ(maxNeighbors2, 7);
+	RS_CHECK_EQ(maxNeighbors3, 19);
+
+	bool badRadiusRejected = false;
+	try {
+		DropshotTiles::GetNeighborIndices(0, 4);
+	} catch (std::exception&) {
+		badRadiusRejected = true;
+	}
+	RS_CHECK(badRadiusRejected);
+}
+
+// Rewrites the collision flags of every tile from its state, like SetDropshotTilesState() did on every call and on every tick with tile damage
+static void RewriteAllTileRBs(Arena* arena) {
+	for (int i = 0; i < NUM_DROPSHOT_TILES; i++)
+		arena->_dropshotTilesChanged.Set(i);
+	arena->_UpdateDropshotTileRBs();
+}
+
+// Updating only the changed tiles gives the same tile states and collision flags as rewriting every tile
+// Covers damage from balls of every charge level, setting the tiles state, and forking
+RS_TEST(DropshotTileUpdatesMatchFullRewrite) {
+	constexpr int TICKS = 6000;
+	constexpr int DROP_INTERVAL = 30;
+	constexpr int SET_STATE_INTERVAL = 1000;
+	constexpr int FORK_INTERVAL = 1700;
+
+	Arena* arena = Arena::Create(GameMode::DROPSHOT);
+	Arena* refArena = Arena::Create(GameMode::DROPSHOT);
+	RS_CHECK_EQ(arena->_worldDropshotTileRBs.size(), (size_t)NUM_DROPSHOT_TILES);
+
+	std::mt19937 rng(9);
+	int numDamageTicks = 0, maxBrokenTiles = 0;
+	for (int tick = 0; tick < TICKS; tick++) {
+		if (tick % DROP_INTERVAL == 0) {
+			// Drop a charged ball onto a random tile
+			int team = rng() % 2;
+			int tileIdx = rng() % RLConst::Dropshot::NUM_TILES_PER_TEAM;
+			BallState ballState = {};
+			ballState.pos = DropshotTiles::GetTilePos(team, tileIdx) + Vec(0, 0, 200);
+			ballState.vel = Vec(0, 0, -1500);
+			ballState.dsInfo.chargeLevel = 1 + (rng() % 3);
+			ballState.dsInfo.yTargetDir = (rng() % 2) ? ((team == 0) ? -1 : 1) : 0;
+			arena->ball->SetState(ballState);
+			refArena->ball->SetState(ballState);
+		}
+
+		if (tick % SET_STATE_INTERVAL == SET_STATE_INTERVAL / 2) {
+			DropshotTilesState tilesState = {};
+			for (int team = 0; team < 2; team++)
+				for (int i = 0; i < RLConst::Dropshot::NUM_TILES_PER_TEAM; i++)
+					tilesState.states[team][i].damageState = rng() % 3;
+			arena->SetDropshotTilesState(tilesState);
+			refArena->SetDropshotTilesState(tilesState);
+			RewriteAllTileRBs(refArena);
+		}
+
+		// Both are forked, as a fork doesn't keep contact caches
+		if (tick % FORK_INTERVAL == FORK_INTERVAL - 1) {
+			for (Arena** arenaPtr : { &arena, &refArena }) {
+				Arena* fork = (*arenaPtr)->Fork();
+				delete *arenaPtr;
+				*arenaPtr = fork;
+			}
+		}
+
+		// Any tile that is damaged during the tick is rewritten at its end
+		for (int i = 0; i < NUM_DROPSHOT_TILES; i++)
+			refArena->_dropshotTilesChanged.Set(i);
+
+		arena->Step(1);
+		refArena->Step(1);
+
+		// Damage is done before the tick count goes up
+		if (arena->ball->_internalState.dsInfo.hasDamaged && arena->ball->_internalState.dsInfo.lastDamageTick + 1 == arena->tickCount)
+			numDamageTicks++;
+
+		DropshotTilesState tilesState = arena->GetDropshotTilesState(), refTilesState = refArena->GetDropshotTilesState();
+		int numBrokenTiles = 0;
+		for (int i = 0; i < NUM_DROPSHOT_TILES; i++) {
+			int team = i / RLConst::Dropshot::NUM_TILES_PER_TEAM, tileIdx = i % RLConst::Dropshot::NUM_TILES_PER_TEAM;
+			uint32_t damageState = tilesState.states[team][tileIdx].damageState;
+			RS_CHECK_EQ(damageState, refTilesState.states[team][tileIdx].damageState);
+
+			bool isBroken = (damageState == DropshotTileState::STATE_BROKEN);
+			bool hasNoContact = arena->_worldDropshotTileRBs[i]->getCollisionFlags() & btCollisionObject::CF_NO_CONTACT_RESPONSE;
+			RS_CHECK_EQ(hasNoContact, isBroken);
+			RS_CHECK_EQ(arena->_worldDropshotTileRBs[i]->getCollisionFlags(), refArena->_worldDropshotTileRBs[i]->getCollisionFlags());
+			numBrokenTiles += isBroken;
+		}
+		maxBrokenTiles = RS_MAX(maxBrokenTiles, numBrokenTiles);
+		RS_CHECK_EQ(Replay::HashArenaState(arena), Replay::HashArenaState(refArena));
+
+		if (Test::numFailedChecks > 0) {
+			std::cout << "  (tick " << tick << ")" << std::endl;
+			break;
+		}
+	}
+
+	// The test covered what it is meant to
+	RS_CHECK(numDamageTicks > TICKS / DROP_INTERVAL / 4);
+	RS_CHECK(maxBrokenTiles > 0);
+
+	delete refArena;
+	delete arena;
+}
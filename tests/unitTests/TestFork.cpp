@@ -0,0 +1,55 @@
+#include "Test.h"
+
+#include <RocketSim/Recording/Replay/Replay.h>
+#include <bullet3-3.24/BulletCollision/BroadphaseCollision/btRSBroadphase.h>
+
+using namespace RocketSim;
+
+// A fork and a clone of the same arena simulate exactly the same, and the fork outlives the arena it shares static data with
+RS_TEST(ForkMatchesClone) {
+	for (GameMode gameMode : { GameMode::SOCCAR, GameMode::DROPSHOT }) {
+		Arena* arena = Test::MakeArena(gameMode, 4, 5);
+		std::mt19937 rng(5);
+		for (int i = 0; i < 200; i++) {
+			if (i % 10 == 0)
+				Test::RandomizeControls(arena, rng);
+			arena->Step(1);
+		}
+
+		Arena* clone = arena->Clone(false);
+		Arena* fork = arena->Fork();
+		RS_CHECK_EQ(fork->tickCount, clone->tickCount);
+		RS_CHECK_EQ(Replay::HashArenaState(fork), Replay::HashArenaState(clone));
+
+		auto* broadphase = (btRSBroadphase*)arena->_bulletWorldParams.broadphase;
+		auto* forkBroadphase = (btRSBroadphase*)fork->_bulletWorldParams.broadphase;
+		RS_CHECK(forkBroadphase->staticGrid == broadphase->staticGrid);
+
+		delete arena;
+
+		std::mt19937 cloneRNG(6), forkRNG(6);
+		for (int i = 0; i < 300; i++) {
+			if (i % 10 == 0) {
+				Test::RandomizeControls(clone, cloneRNG);
+				Test::RandomizeControls(fork, forkRNG);
+			}
+			clone->Step(1);
+			fork->Step(1);
+
+			uint64_t cloneHash = Replay::HashArenaState(clone), forkHash = Replay::HashArenaState(fork);
+			RS_CHECK_EQ(forkHash, cloneHash);
+			if (forkHash != cloneHash)
+				break;
+		}
+
+		if (gameMode == GameMode::DROPSHOT) {
+			DropshotTilesState cloneTiles = clone->GetDropshotTilesState(), forkTiles = fork->GetDropshotTilesState();
+			for (int team = 0; team < 2; team++)
+				for (int i = 0; i < RLConst::Dropshot::NUM_TILES_PER_TEAM; i++)
+					RS_CHECK_EQ(forkTiles.states[team][i].damageState, cloneTiles.states[team][i].damageState);
+		}
+
+		delete fork;
+		delete clone;
+	}
+}
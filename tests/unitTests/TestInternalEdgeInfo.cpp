@@ -0,0 +1,64 @@
+#include "Test.h"
+
+#include <bullet3-3.24/BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <bullet3-3.24/BulletCollision/CollisionShapes/btTriangleInfoMap.h>
+
+using namespace RocketSim;
+
+static bool TriangleInfosMatch(const btTriangleInfo& a, const btTriangleInfo& b) {
+	return
+		a.m_flags == b.m_flags &&
+		a.m_edgeV0V1Angle == b.m_edgeV0V1Angle &&
+		a.m_edgeV1V2Angle == b.m_edgeV1V2Angle &&
+		a.m_edgeV2V0Angle == b.m_edgeV2V0Angle;
+}
+
+// The flat triangle info table of every arena mesh has the same info as the hash map for each triangle, and marks the rest as not present
+// So contacts adjusted through the table are adjusted exactly like through the map
+RS_TEST(InternalEdgeInfoFlatTableMatchesMap) {
+	int numMeshes = 0, numTrianglesWithInfo = 0;
+	for (GameMode gameMode : { GameMode::SOCCAR, GameMode::DROPSHOT }) {
+		for (btBvhTriangleMeshShape* shape : GetArenaCollisionShapes(gameMode)) {
+			const btTriangleInfoMap* infoMap = shape->getTriangleInfoMap();
+			RS_CHECK(infoMap != NULL);
+			if (!infoMap)
+				continue;
+
+			btStridingMeshInterface* meshInterface = shape->getMeshInterface();
+			RS_CHECK_EQ(meshInterface->getNumSubParts(), 1);
+
+			const unsigned char *vertexBase, *indexBase;
+			int numVerts, vertexStride, indexStride, numTriangles;
+			meshInterface->getLockedReadOnlyVertexIndexBase(&vertexBase, numVerts, vertexStride, &indexBase, indexStride, numTriangles, 0);
+			meshInterface->unLockReadOnlyVertexBase(0);
+
+			const auto& flatInfos = infoMap->m_flatTriangleInfos;
+			RS_CHECK_EQ(flatInfos.size(), numTriangles);
+
+			// Every entry of the map is in the table
+			for (int i = 0; i < infoMap->size(); i++) {
+				int triangleIndex = infoMap->getKeyAtIndex(i).getUid1();
+				RS_CHECK(triangleIndex >= 0 && triangleIndex < flatInfos.size());
+				if (triangleIndex >= 0 && triangleIndex < flatInfos.size())
+					RS_CHECK(TriangleInfosMatch(flatInfos[triangleIndex], *infoMap->getAtIndex(i)));
+			}
+
+			// ...and nothing else is
+			int numPresent = 0;
+			for (int i = 0; i < flatInfos.size(); i++) {
+				if (flatInfos[i].m_flags & TRI_INFO_NOT_PRESENT) {
+					RS_CHECK(infoMap->find(i) == NULL);
+				} else {
+					numPresent++;
+					numTrianglesWithInfo++;
+				}
+			}
+			RS_CHECK_EQ(numPresent, infoMap->size());
+			numMeshes++;
+		}
+	}
+
+	// The test covered what it is meant to
+	RS_CHECK(numMeshes >= 2);
+	RS_CHECK(numTrianglesWithInfo > 1000);
+}
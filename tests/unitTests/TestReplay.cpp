@@ -0,0 +1,209 @@
+#include "Test.h"
+
+#include <RocketSim/Recording/Replay/Replay.h>
+
+using namespace RocketSim;
+
+constexpr int REPLAY_TICKS = 600;
+constexpr int REPLAY_KEYFRAME_INTERVAL = 60;
+
+// Records a replay of random play, returning the state hash of every tick
+static std::vector<uint64_t> RecordReplay(const std::filesystem::path& path) {
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 4, 2);
+	std::mt19937 rng(2);
+
+	std::vector<uint64_t> stateHashes;
+	{
+		ReplayWriter writer(path, REPLAY_KEYFRAME_INTERVAL);
+		for (int tick = 0; tick < REPLAY_TICKS; tick++) {
+			if (tick % 10 == 0)
+				Test::RandomizeControls(arena, rng);
+
+			writer.RecordTick(arena);
+			stateHashes.push_back(Replay::HashArenaState(arena));
+			arena->Step(1);
+		}
+		stateHashes.push_back(Replay::HashArenaState(arena));
+	}
+
+	delete arena;
+	return stateHashes;
+}
+
+// Seeking reaches the exact tick with exactly the recorded state
+RS_TEST(ReplaySeek) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_seek.replay";
+	std::vector<uint64_t> stateHashes = RecordReplay(path);
+
+	{
+		ReplayPlayer player(path);
+		RS_CHECK_EQ(player.GetFirstTick(), 0ULL);
+		RS_CHECK_EQ(player.GetEndTick(), (uint64_t)REPLAY_TICKS);
+
+		Arena* arena = Test::MakeArena(GameMode::SOCCAR, 4, 0);
+		for (uint64_t tick : { 300, 0, 60, 75, 599, 600, 540, 119, 121 }) {
+			player.Seek(arena, tick);
+			RS_CHECK_EQ(arena->tickCount, tick);
+			RS_CHECK_EQ(Replay::HashArenaState(arena), stateHashes[tick]);
+			RS_CHECK_EQ(player.GetNumMismatchedTicks(), 0ULL);
+		}
+
+		// Stepping across keyframes also stays exact
+		player.Seek(arena, REPLAY_TICKS - 130);
+		int numSteps = 0;
+		while (player.StepForward(arena)) {
+			numSteps++;
+			RS_CHECK_EQ(Replay::HashArenaState(arena), stateHashes[arena->tickCount]);
+		}
+		RS_CHECK_EQ(numSteps, 130);
+		RS_CHECK_EQ(arena->tickCount, (uint64_t)REPLAY_TICKS);
+		RS_CHECK_EQ(player.GetNumMismatchedTicks(), 0ULL);
+
+		delete arena;
+	}
+
+	std::filesystem::remove(path);
+}
+
+// Adding or removing cars while recording fails, as keyframes can't restore them
+RS_TEST(ReplayCarChange) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_car_change.replay";
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 0);
+
+	{
+		ReplayWriter writer(path, REPLAY_KEYFRAME_INTERVAL);
+		for (int i = 0; i < 10; i++) {
+			writer.RecordTick(arena);
+			arena->Step(1);
+		}
+
+		arena->AddCar(Team::BLUE);
+		bool addRejected = false;
+		try {
+			writer.RecordTick(arena);
+		} catch (std::exception&) {
+			addRejected = true;
+		}
+		RS_CHECK(addRejected);
+	}
+
+	delete arena;
+	std::filesystem::remove(path);
+}
+
+// Returns true if playing back a replay file with the given contents fails
+static bool IsReplayRejected(const std::filesystem::path& path, const std::vector<byte>& fileData) {
+	{
+		std::ofstream stream(path, std::ios::binary);
+		stream.write((const char*)fileData.data(), fileData.size());
+	}
+
+	bool rejected = false;
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 4, 0);
+	try {
+		ReplayPlayer player(path);
+		player.Seek(arena, player.GetFirstTick());
+		while (player.StepForward(arena)) {}
+	} catch (std::exception&) {
+		rejected = true;
+	}
+	delete arena;
+	return rejected;
+}
+
+// Replays with an invalid index or chunks are rejected instead of being read out of bounds
+RS_TEST(ReplayValidation) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_validation.replay";
+	RecordReplay(path);
+
+	std::vector<byte> fileData(std::filesystem::file_size(path));
+	{
+		std::ifstream stream(path, std::ios::binary);
+		stream.read((char*)fileData.data(), fileData.size());
+	}
+
+	Replay::Footer footer;
+	memcpy(&footer, fileData.data() + fileData.size() - sizeof(footer), sizeof(footer));
+	size_t firstEntryOffset = footer.indexOffset;
+	Replay::KeyframeIndexEntry firstEntry;
+	memcpy(&firstEntry, fileData.data() + firstEntryOffset, sizeof(firstEntry));
+	size_t keyframeChunkOffset = firstEntry.chunkOffset;
+	Replay::ChunkHeader keyframeChunk;
+	memcpy(&keyframeChunk, fileData.data() + keyframeChunkOffset, sizeof(keyframeChunk));
+	size_t controlsChunkOffset = keyframeChunkOffset + sizeof(Replay::ChunkHeader) + keyframeChunk.payloadSize;
+	controlsChunkOffset = (controlsChunkOffset + Replay::CHUNK_ALIGNMENT - 1) / Replay::CHUNK_ALIGNMENT * Replay::CHUNK_ALIGNMENT;
+
+	RS_CHECK(!IsReplayRejected(path, fileData));
+
+	{ // Index size overflows to the actual index size
+		std::vector<byte> data = fileData;
+		Replay::Footer badFooter = footer;
+		badFooter.numKeyframes += 1ULL << 60;
+		memcpy(data.data() + data.size() - sizeof(badFooter), &badFooter, sizeof(badFooter));
+		RS_CHECK(IsReplayRejected(path, data));
+	}
+
+	{ // Keyframe chunk outside of the file
+		std::vector<byte> data = fileData;
+		Replay::KeyframeIndexEntry badEntry = firstEntry;
+		badEntry.chunkOffset = data.size() * 2;
+		memcpy(data.data() + firstEntryOffset, &badEntry, sizeof(badEntry));
+		RS_CHECK(IsReplayRejected(path, data));
+	}
+
+	{ // Keyframe payload past the index
+		std::vector<byte> data = fileData;
+		Replay::ChunkHeader badChunk = keyframeChunk;
+		badChunk.payloadSize = UINT32_MAX;
+		memcpy(data.data() + keyframeChunkOffset, &badChunk, sizeof(badChunk));
+		RS_CHECK(IsReplayRejected(path, data));
+	}
+
+	{ // Controls payload too small for its header
+		std::vector<byte> data = fileData;
+		Replay::ChunkHeader badChunk;
+		memcpy(&badChunk, data.data() + controlsChunkOffset, sizeof(badChunk));
+		RS_CHECK(badChunk.type == Replay::ChunkType::CONTROLS);
+		badChunk.payloadSize = sizeof(Replay::ControlsHeader) - 1;
+		memcpy(data.data() + controlsChunkOffset, &badChunk, sizeof(badChunk));
+		RS_CHECK(IsReplayRejected(path, data));
+	}
+
+	std::filesystem::remove(path);
+}
+
+// Re-simulating from the first keyframe matches the recorded state hashes, and a changed state is reported
+RS_TEST(ReplayVerify) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_verify.replay";
+	RecordReplay(path);
+
+	{
+		Arena* arena = Test::MakeArena(GameMode::SOCCAR, 4, 0);
+
+		ReplayPlayer player(path);
+		player.Seek(arena, 0);
+		while (player.StepForward(arena)) {}
+		RS_CHECK_EQ(player.GetNumMismatchedTicks(), 0ULL);
+		RS_CHECK_EQ(player.GetFirstMismatchedTick(), Replay::NO_TICK);
+
+		ReplayPlayer perturbedPlayer(path);
+		perturbedPlayer.Seek(arena, 0);
+		BallState ballState = arena->ball->GetState();
+		ballState.vel.x += 1;
+		arena->ball->SetState(ballState);
+		perturbedPlayer.StepForward(arena);
+		RS_CHECK_EQ(perturbedPlayer.GetNumMismatchedTicks(), 1ULL);
+		RS_CHECK_EQ(perturbedPlayer.GetFirstMismatchedTick(), 1ULL);
+
+		ReplayPlayer unverifiedPlayer(path);
+		unverifiedPlayer.verifyStates = false;
+		unverifiedPlayer.Seek(arena, 0);
+		arena->ball->SetState(ballState);
+		unverifiedPlayer.StepForward(arena);
+		RS_CHECK_EQ(unverifiedPlayer.GetNumMismatchedTicks(), 0ULL);
+
+		delete arena;
+	}
+
+	std::filesystem::remove(path);
+}
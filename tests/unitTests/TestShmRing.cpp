@@ -0,0 +1,107 @@
+#include "Test.h"
+
+#include <RocketSim/Server/ShmRing/ShmRing.h>
+
+#include <thread>
+
+using namespace RocketSim;
+
+struct alignas(ShmRingHeader::CACHE_LINE_SIZE) RingMemory {
+	byte data[sizeof(ShmRingHeader) + 64 * ShmRingHeader::CACHE_LINE_SIZE];
+};
+
+// Slots come out in the order they were written, a full ring refuses writes, and indices wrap around
+RS_TEST(ShmRingOrder) {
+	constexpr uint32_t NUM_SLOTS = 4;
+	RingMemory memory;
+	RS_CHECK(ShmRing::GetRequiredSize(NUM_SLOTS, sizeof(uint64_t)) <= sizeof(memory.data));
+
+	ShmRing producer = ShmRing::Init(memory.data, NUM_SLOTS, sizeof(uint64_t));
+	ShmRing consumer = ShmRing::Attach(memory.data);
+	RS_CHECK(consumer.BeginRead() == NULL);
+
+	uint64_t nextWrite = 0, nextRead = 0;
+	for (int round = 0; round < 10; round++) {
+		// Fill, then read back a different amount each round so the ring wraps at different positions
+		while (void* slot = producer.BeginWrite()) {
+			*(uint64_t*)slot = nextWrite++;
+			producer.EndWrite();
+		}
+		RS_CHECK_EQ(consumer.GetNumPending(), NUM_SLOTS);
+
+		int numReads = 1 + round % NUM_SLOTS;
+		for (int i = 0; i < numReads; i++) {
+			const void* slot = consumer.BeginRead();
+			RS_CHECK(slot != NULL);
+			if (slot)
+				RS_CHECK_EQ(*(const uint64_t*)slot, nextRead);
+			nextRead++;
+			consumer.EndRead();
+		}
+		RS_CHECK_EQ(consumer.GetNumPending(), (uint32_t)(NUM_SLOTS - numReads));
+	}
+
+	// A new handle resumes where the ring is
+	ShmRing otherConsumer = ShmRing::Attach(memory.data);
+	const void* slot = otherConsumer.BeginRead();
+	RS_CHECK(slot != NULL);
+	if (slot)
+		RS_CHECK_EQ(*(const uint64_t*)slot, nextRead);
+
+	// Init() empties the ring
+	ShmRing::Init(memory.data, NUM_SLOTS, sizeof(uint64_t));
+	RS_CHECK(ShmRing::Attach(memory.data).BeginRead() == NULL);
+
+	bool badSlotCountRejected = false;
+	try {
+		ShmRing::Init(memory.data, 3, sizeof(uint64_t));
+	} catch (std::exception&) {
+		badSlotCountRejected = true;
+	}
+	RS_CHECK(badSlotCountRejected);
+
+	bool misalignedRejected = false;
+	try {
+		ShmRing::Init(memory.data + 8, NUM_SLOTS, sizeof(uint64_t));
+	} catch (std::exception&) {
+		misalignedRejected = true;
+	}
+	RS_CHECK(misalignedRejected);
+}
+
+// A producer and a consumer thread pass every message through, in order
+RS_TEST(ShmRingThreads) {
+	constexpr uint64_t NUM_MESSAGES = 200000;
+	RingMemory memory;
+	ShmRing::Init(memory.data, 8, 2 * sizeof(uint64_t));
+
+	std::thread producerThread([&] {
+		ShmRing producer = ShmRing::Attach(memory.data);
+		for (uint64_t i = 0; i < NUM_MESSAGES; i++) {
+			void* slot;
+			while (!(slot = producer.BeginWrite()))
+				std::this_thread::yield();
+
+			// Two values, so a slot read before it was fully written would show up
+			((uint64_t*)slot)[0] = i;
+			((uint64_t*)slot)[1] = ~i;
+			producer.EndWrite();
+		}
+	});
+
+	ShmRing consumer = ShmRing::Attach(memory.data);
+	uint64_t numBadMessages = 0;
+	for (uint64_t i = 0; i < NUM_MESSAGES; i++) {
+		const void* slot;
+		while (!(slot = consumer.BeginRead()))
+			std::this_thread::yield();
+
+		if (((const uint64_t*)slot)[0] != i || ((const uint64_t*)slot)[1] != ~i)
+			numBadMessages++;
+		consumer.EndRead();
+	}
+
+	producerThread.join();
+	RS_CHECK_EQ(numBadMessages, 0ULL);
+	RS_CHECK(consumer.BeginRead() == NULL);
+}
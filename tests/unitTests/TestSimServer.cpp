@@ -0,0 +1,223 @@
+#include "Test.h"
+
+#ifndef _WIN32
+
+#include <RocketSim/Server/SimServer/SimServer.h>
+#include <RocketSim/Server/SimClient/SimClient.h>
+#include <RocketSim/Recording/Replay/Replay.h>
+
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace RocketSim;
+
+// Controls sent by a client step the server's arena exactly like stepping the arena directly
+RS_TEST(SimServerStep) {
+	constexpr char SERVER_NAME[] = "rs_unit_test_sim_server_step";
+	constexpr uint32_t TICKS = 8;
+
+	std::vector<Arena*> arenas = { Test::MakeArena(GameMode::SOCCAR, 2, 0), Test::MakeArena(GameMode::SOCCAR, 4, 1) };
+	std::vector<Arena*> refArenas = { Test::MakeArena(GameMode::SOCCAR, 2, 0), Test::MakeArena(GameMode::SOCCAR, 4, 1) };
+
+	{
+		SimServer server(SERVER_NAME, arenas);
+		SimClient client(SERVER_NAME);
+		RS_CHECK_EQ(client.GetNumArenas(), 2u);
+
+		// Not ready until the server has seen the claims
+		RS_CHECK(!client.PeekStates(0).IsValid());
+		RS_CHECK(client.BeginControls(0) == NULL);
+
+		std::mt19937 rng(0);
+		for (int step = 0; step < 20; step++) {
+			server.Poll();
+
+			for (uint32_t i = 0; i < 2; i++) {
+				SimStatesView states = client.WaitStates(i);
+				RS_CHECK_EQ(states.header->seq, (uint64_t)step);
+				RS_CHECK_EQ(states.header->tickCount, refArenas[i]->tickCount);
+				RS_CHECK_EQ(Replay::HashArenaState(arenas[i]), Replay::HashArenaState(refArenas[i]));
+
+				uint32_t numCars = states.header->numCars;
+				for (uint32_t carIndex = 0; carIndex < numCars; carIndex++) {
+					Car* refCar = refArenas[i]->GetCar(states.carIDs[carIndex]);
+					RS_CHECK(refCar != NULL);
+					if (refCar)
+						RS_CHECK(states.carPos[carIndex] == refCar->GetState().pos);
+				}
+
+				Test::RandomizeControls(refArenas[i], rng);
+				CarControls* controls = client.BeginControls(i);
+				for (uint32_t carIndex = 0; carIndex < numCars; carIndex++)
+					controls[carIndex] = refArenas[i]->GetCar(states.carIDs[carIndex])->controls;
+
+				client.PopStates(i);
+				client.SendControls(i, numCars, TICKS);
+				refArenas[i]->Step(TICKS);
+			}
+		}
+	}
+
+	for (Arena* arena : arenas)
+		delete arena;
+	for (Arena* arena : refArenas)
+		delete arena;
+}
+
+// A new client gets fresh rings, the controls, states and events left by the previous client are dropped
+RS_TEST(SimServerClaimReset) {
+	constexpr char SERVER_NAME[] = "rs_unit_test_sim_server_claim";
+
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 0);
+	{
+		SimServer server(SERVER_NAME, { arena });
+
+		uint64_t startTickCount = arena->tickCount;
+		{
+			SimClient client(SERVER_NAME);
+			server.Poll();
+
+			SimStatesView states = client.WaitStates(0);
+			CarControls* controls = client.BeginControls(0);
+			for (uint32_t i = 0; i < states.header->numCars; i++)
+				controls[i] = {};
+			client.PopStates(0);
+			client.SendControls(0, states.header->numCars, 10);
+
+			// Queue another message whose states are never read
+			controls = client.BeginControls(0);
+			for (uint32_t i = 0; i < arena->_cars.size(); i++)
+				controls[i] = {};
+			client.SendControls(0, arena->_cars.size(), 10);
+			server.Poll();
+			RS_CHECK_EQ(arena->tickCount, startTickCount + 10);
+		}
+
+		SimClient newClient(SERVER_NAME);
+		server.Poll();
+
+		// Only the new initial states, and the queued controls were not run
+		SimStatesView states = newClient.WaitStates(0);
+		RS_CHECK_EQ(states.header->seq, 0ULL);
+		RS_CHECK_EQ(states.header->tickCount, startTickCount + 10);
+		RS_CHECK_EQ(arena->tickCount, startTickCount + 10);
+		newClient.PopStates(0);
+		RS_CHECK(!newClient.PeekStates(0).IsValid());
+		RS_CHECK(newClient.PeekEvent(0) == NULL);
+
+		server.Poll();
+		RS_CHECK_EQ(arena->tickCount, startTickCount + 10);
+	}
+	delete arena;
+}
+
+// A client without heartbeats is revoked: its messages aren't handled, and the arena can only be claimed again once it noticed
+RS_TEST(SimServerRevoke) {
+	constexpr char SERVER_NAME[] = "rs_unit_test_sim_server_revoke";
+
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 0);
+	{
+		SimServerConfig config = {};
+		config.clientTimeout = 0.05f;
+		SimServer server(SERVER_NAME, { arena }, config);
+
+		SimClient stalledClient(SERVER_NAME);
+		server.Poll();
+		stalledClient.WaitStates(0);
+		CarControls* controls = stalledClient.BeginControls(0);
+		for (uint32_t i = 0; i < arena->_cars.size(); i++)
+			controls[i] = {};
+		stalledClient.SendControls(0, arena->_cars.size(), 10);
+
+		// Longer than the timeout and the interval the server checks clients at
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		uint64_t startTickCount = arena->tickCount;
+		server.Poll();
+		RS_CHECK_EQ(arena->tickCount, startTickCount);
+
+		bool claimRejected = false;
+		try {
+			SimClient otherClient(SERVER_NAME);
+		} catch (std::exception&) {
+			claimRejected = true;
+		}
+		RS_CHECK(claimRejected);
+
+		bool revokeNoticed = false;
+		try {
+			stalledClient.BeginControls(0);
+		} catch (std::exception&) {
+			revokeNoticed = true;
+		}
+		RS_CHECK(revokeNoticed);
+
+		SimClient newClient(SERVER_NAME);
+		server.Poll();
+		SimStatesView states = newClient.WaitStates(0);
+		RS_CHECK_EQ(states.header->seq, 0ULL);
+		RS_CHECK_EQ(states.header->tickCount, startTickCount);
+	}
+	delete arena;
+}
+
+// A running server's shared memory is never replaced, one left over from a server whose process is gone is
+RS_TEST(SimServerNameInUse) {
+	constexpr char SERVER_NAME[] = "rs_unit_test_sim_server_name";
+
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 0);
+	{
+		SimServer server(SERVER_NAME, { arena });
+
+		bool duplicateRejected = false;
+		try {
+			SimServer duplicateServer(SERVER_NAME, { arena });
+		} catch (std::exception&) {
+			duplicateRejected = true;
+		}
+		RS_CHECK(duplicateRejected);
+
+		// Still reachable
+		SimClient client(SERVER_NAME);
+		server.Poll();
+		RS_CHECK(client.WaitStates(0).IsValid());
+	}
+
+	{
+		// Not a server
+		SharedMemory otherMemory = SharedMemory::Create(SERVER_NAME, sizeof(SimServerHeader));
+		bool otherRejected = false;
+		try {
+			SimServer server(SERVER_NAME, { arena });
+		} catch (std::exception&) {
+			otherRejected = true;
+		}
+		RS_CHECK(otherRejected);
+	}
+	RS_CHECK(!SharedMemory::Exists(SERVER_NAME));
+
+	{
+		pid_t deadPID = fork();
+		if (deadPID == 0)
+			_exit(0);
+		waitpid(deadPID, NULL, 0);
+
+		// Like a server that crashed, so its name was never unlinked
+		SharedMemory leftOverMemory = SharedMemory::Create(SERVER_NAME, sizeof(SimServerHeader));
+		auto* header = new (leftOverMemory.GetData()) SimServerHeader();
+		header->formatVersion = SimServerHeader::FORMAT_VERSION;
+		header->serverPID = deadPID;
+		header->magic.store(SimServerHeader::MAGIC);
+		leftOverMemory._isOwner = false;
+
+		SimServer server(SERVER_NAME, { arena });
+		SimClient client(SERVER_NAME);
+		server.Poll();
+		RS_CHECK(client.WaitStates(0).IsValid());
+	}
+	RS_CHECK(!SharedMemory::Exists(SERVER_NAME));
+
+	delete arena;
+}
+
+#endif
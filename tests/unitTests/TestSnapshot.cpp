@@ -0,0 +1,218 @@
+#include "Test.h"
+
+#include <RocketSim/Recording/Replay/Replay.h>
+
+using namespace RocketSim;
+
+// Arena after some random play, with a pad cooling down
+static Arena* MakePlayedArena() {
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 4, 7);
+	std::mt19937 rng(7);
+	for (int i = 0; i < 300; i++) {
+		if (i % 10 == 0)
+			Test::RandomizeControls(arena, rng);
+		arena->Step(1);
+	}
+
+	BoostPadState padState = {};
+	padState.cooldown = 3.5f;
+	arena->GetBoostPads()[0]->SetState(padState);
+	return arena;
+}
+
+// Every field of a snapshot view is the arena's state at the time it was written
+RS_TEST(SnapshotView) {
+	Arena* arena = MakePlayedArena();
+
+	std::vector<byte> buffer(arena->GetSnapshotSize());
+	size_t size = arena->WriteSnapshot(buffer.data(), buffer.size());
+	RS_CHECK_EQ(size, buffer.size());
+
+	ArenaSnapshotView view = ArenaSnapshotView::FromBuffer(buffer.data(), size);
+	RS_CHECK_EQ(view.header->tickCount, arena->tickCount);
+	RS_CHECK_EQ(view.header->numCars, (uint32_t)arena->GetCars().size());
+	RS_CHECK_EQ(view.header->numBoostPads, (uint32_t)arena->GetBoostPads().size());
+	RS_CHECK(view.dropshotTilesState == NULL);
+
+	for (Car* car : arena->GetCars()) {
+		int carIndex = view.FindCarIndex(car->id);
+		RS_CHECK(carIndex >= 0);
+		if (carIndex < 0)
+			continue;
+
+		CarState state = car->GetState();
+		const CarState& viewState = view.carStates[carIndex];
+		RS_CHECK(viewState.pos == state.pos);
+		RS_CHECK(viewState.rotMat == state.rotMat);
+		RS_CHECK(viewState.vel == state.vel);
+		RS_CHECK(viewState.angVel == state.angVel);
+		RS_CHECK_EQ(viewState.boost, state.boost);
+		RS_CHECK_EQ(viewState.isOnGround, state.isOnGround);
+		RS_CHECK(view.carTeams[carIndex] == car->team);
+		RS_CHECK_EQ(view.carControls[carIndex].steer, car->controls.steer);
+	}
+	RS_CHECK_EQ(view.FindCarIndex(1000), -1);
+
+	BallState ballState = arena->ball->GetState();
+	RS_CHECK(view.ballState->pos == ballState.pos);
+	RS_CHECK(view.ballState->vel == ballState.vel);
+
+	for (size_t i = 0; i < arena->GetBoostPads().size(); i++) {
+		BoostPadState padState = arena->GetBoostPads()[i]->GetState();
+		RS_CHECK_EQ(view.boostPadStates[i].isActive, padState.isActive);
+		RS_CHECK_EQ(view.boostPadStates[i].cooldown, padState.cooldown);
+		RS_CHECK(view.boostPadStates[i].curLockedCar == NULL);
+	}
+
+	delete arena;
+}
+
+// Applying a snapshot restores the exact state, and arenas that applied it simulate exactly the same afterwards
+RS_TEST(SnapshotRoundTrip) {
+	Arena* arena = MakePlayedArena();
+
+	std::vector<byte> buffer(arena->GetSnapshotSize());
+	arena->WriteSnapshot(buffer.data(), buffer.size());
+	ArenaSnapshotView view = ArenaSnapshotView::FromBuffer(buffer.data(), buffer.size());
+
+	// Has stepped before, so it has its own contact caches and wheel values to overwrite
+	Arena* restored = Test::MakeArena(GameMode::SOCCAR, 4, 0);
+	restored->Step(30);
+	restored->ApplySnapshot(view);
+	RS_CHECK_EQ(restored->tickCount, arena->tickCount);
+
+	for (Car* car : arena->GetCars()) {
+		Car* restoredCar = restored->GetCar(car->id);
+		RS_CHECK(restoredCar != NULL);
+		if (!restoredCar)
+			continue;
+
+		CarState state = car->GetState(), restoredState = restoredCar->GetState();
+		RS_CHECK(restoredState.pos == state.pos);
+		RS_CHECK(restoredState.vel == state.vel);
+		RS_CHECK(restoredState.angVel == state.angVel);
+		RS_CHECK(restoredState.rotMat == state.rotMat);
+		RS_CHECK_EQ(restoredState.boost, state.boost);
+		RS_CHECK_EQ(restoredState.hasJumped, state.hasJumped);
+		RS_CHECK_EQ(restoredState.isDemoed, state.isDemoed);
+		RS_CHECK_EQ(restoredCar->controls.throttle, car->controls.throttle);
+	}
+
+	BallState ballState = arena->ball->GetState(), restoredBallState = restored->ball->GetState();
+	RS_CHECK(restoredBallState.pos == ballState.pos);
+	RS_CHECK(restoredBallState.vel == ballState.vel);
+	RS_CHECK(restoredBallState.angVel == ballState.angVel);
+
+	for (size_t i = 0; i < arena->GetBoostPads().size(); i++) {
+		BoostPadState padState = arena->GetBoostPads()[i]->GetState();
+		BoostPadState restoredPadState = restored->GetBoostPads()[i]->GetState();
+		RS_CHECK_EQ(restoredPadState.isActive, padState.isActive);
+		RS_CHECK_EQ(restoredPadState.cooldown, padState.cooldown);
+	}
+
+	// Apply it to the original arena as well, as that also clears its contact caches
+	arena->ApplySnapshot(view);
+	RS_CHECK_EQ(Replay::HashArenaState(restored), Replay::HashArenaState(arena));
+
+	std::mt19937 rng(8), restoredRNG(8);
+	for (int i = 0; i < 300; i++) {
+		if (i % 10 == 0) {
+			Test::RandomizeControls(arena, rng);
+			Test::RandomizeControls(restored, restoredRNG);
+		}
+		arena->Step(1);
+		restored->Step(1);
+
+		uint64_t hash = Replay::HashArenaState(arena), restoredHash = Replay::HashArenaState(restored);
+		RS_CHECK_EQ(restoredHash, hash);
+		if (restoredHash != hash)
+			break;
+	}
+
+	delete restored;
+	delete arena;
+}
+
+// Applying a snapshot enables or disables each car's rigidbody from whether it is demoed, not from what the arena simulated before
+// Other cars' wheel rays can check the rigidbody before the car's own update does this
+RS_TEST(SnapshotDemoedCar) {
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 0);
+	Car* car = arena->GetCar(2);
+	arena->Step(1);
+
+	std::vector<byte> activeBuffer(arena->GetSnapshotSize()), demoedBuffer(arena->GetSnapshotSize());
+	ArenaSnapshotView activeView = ArenaSnapshotView::FromBuffer(activeBuffer.data(), arena->WriteSnapshot(activeBuffer.data(), activeBuffer.size()));
+
+	CarState state = car->GetState();
+	state.isDemoed = true;
+	state.demoRespawnTimer = 1;
+	car->SetState(state);
+	RS_CHECK(!car->_rigidBody.hasContactResponse());
+	RS_CHECK_EQ(car->_rigidBody.getActivationState(), DISABLE_SIMULATION);
+	ArenaSnapshotView demoedView = ArenaSnapshotView::FromBuffer(demoedBuffer.data(), arena->WriteSnapshot(demoedBuffer.data(), demoedBuffer.size()));
+
+	// Disabled by the car's update
+	arena->Step(1);
+	arena->ApplySnapshot(activeView);
+	RS_CHECK(car->_rigidBody.hasContactResponse());
+	RS_CHECK_EQ(car->_rigidBody.getActivationState(), ACTIVE_TAG);
+
+	arena->ApplySnapshot(demoedView);
+	RS_CHECK(!car->_rigidBody.hasContactResponse());
+	RS_CHECK_EQ(car->_rigidBody.getActivationState(), DISABLE_SIMULATION);
+
+	delete arena;
+}
+
+// Snapshots that are truncated, from another build, or have invalid header values are rejected
+RS_TEST(SnapshotValidation) {
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 0);
+
+	std::vector<byte> buffer(arena->GetSnapshotSize());
+	arena->WriteSnapshot(buffer.data(), buffer.size());
+
+	bool truncatedRejected = false;
+	try {
+		ArenaSnapshotView::FromBuffer(buffer.data(), buffer.size() - 1);
+	} catch (std::exception&) {
+		truncatedRejected = true;
+	}
+	RS_CHECK(truncatedRejected);
+
+	((ArenaSnapshotHeader*)buffer.data())->carStateSize++;
+	bool mismatchRejected = false;
+	try {
+		ArenaSnapshotView::FromBuffer(buffer.data(), buffer.size());
+	} catch (std::exception&) {
+		mismatchRejected = true;
+	}
+	RS_CHECK(mismatchRejected);
+	((ArenaSnapshotHeader*)buffer.data())->carStateSize--;
+
+	// Section offsets of this many cars don't fit in 32 bits
+	std::vector<byte> hugeBuffer = buffer;
+	((ArenaSnapshotHeader*)hugeBuffer.data())->numCars = UINT32_MAX / 8;
+	bool hugeRejected = false;
+	try {
+		ArenaSnapshotView::FromBuffer(hugeBuffer.data(), hugeBuffer.size());
+	} catch (std::exception&) {
+		hugeRejected = true;
+	}
+	RS_CHECK(hugeRejected);
+
+	std::vector<byte> badFlagBuffer = buffer;
+	uint8_t badFlag = 2;
+	memcpy(&((ArenaSnapshotHeader*)badFlagBuffer.data())->hasDropshotTiles, &badFlag, sizeof(badFlag));
+	bool badFlagRejected = false;
+	try {
+		ArenaSnapshotView::FromBuffer(badFlagBuffer.data(), badFlagBuffer.size());
+	} catch (std::exception&) {
+		badFlagRejected = true;
+	}
+	RS_CHECK(badFlagRejected);
+
+	// Still valid after undoing the changes
+	ArenaSnapshotView::FromBuffer(buffer.data(), buffer.size());
+
+	delete arena;
+}
@@ -0,0 +1,156 @@
+#include "Test.h"
+
+#include <RocketSim/Recording/StateRecorder/StateRecorder.h>
+
+using namespace RocketSim;
+
+constexpr int RECORDING_TICKS = 200;
+constexpr int RECORDING_KEYFRAME_INTERVAL = 25;
+
+// Ticks after which a car is added or removed
+constexpr int RECORDING_ADD_CAR_TICK = 80, RECORDING_REMOVE_CAR_TICK = 140;
+
+// Records random play with a car added and another removed part way, returning the snapshot of every recorded tick
+static std::vector<std::vector<byte>> RecordStates(const std::filesystem::path& path) {
+	Arena* arena = Test::MakeArena(GameMode::SOCCAR, 2, 4);
+	std::mt19937 rng(4);
+
+	std::vector<std::vector<byte>> snapshots;
+	{
+		StateRecorder recorder(path, RECORDING_KEYFRAME_INTERVAL);
+		for (int tick = 0; tick < RECORDING_TICKS; tick++) {
+			if (tick == RECORDING_ADD_CAR_TICK)
+				arena->AddCar(Team::ORANGE);
+			if (tick == RECORDING_REMOVE_CAR_TICK)
+				arena->RemoveCar(1);
+			if (tick % 10 == 0)
+				Test::RandomizeControls(arena, rng);
+
+			arena->Step(1);
+			recorder.Record(arena);
+
+			std::vector<byte> snapshot(arena->GetSnapshotSize());
+			arena->WriteSnapshot(snapshot.data(), snapshot.size());
+			snapshots.push_back(snapshot);
+		}
+		recorder.Flush();
+		RS_CHECK_EQ(recorder.GetNumRecords(), (uint64_t)RECORDING_TICKS);
+	}
+
+	delete arena;
+	return snapshots;
+}
+
+// Every record reads back as exactly the snapshot that was recorded, in any order, across keyframes, deltas, and changes in the amount of cars
+RS_TEST(StateRecorderRoundTrip) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_round_trip.srec";
+	std::vector<std::vector<byte>> snapshots = RecordStates(path);
+
+	{
+		StateRecordingReader reader(path);
+		RS_CHECK_EQ(reader.GetNumRecords(), (size_t)RECORDING_TICKS);
+
+		// Keyframes are written every interval and when the cars change, deltas otherwise
+		int numKeyframes = 0;
+		for (size_t i = 0; i < reader.GetNumRecords(); i++) {
+			bool carsChanged = (i > 0) && (snapshots[i].size() != snapshots[i - 1].size());
+			bool isKeyframe = reader._records[i].type == StateRecording::RecordType::KEYFRAME;
+			if (carsChanged || i == 0)
+				RS_CHECK(isKeyframe);
+			numKeyframes += isKeyframe;
+		}
+		RS_CHECK(snapshots[RECORDING_ADD_CAR_TICK].size() > snapshots[0].size());
+		RS_CHECK(snapshots[RECORDING_REMOVE_CAR_TICK].size() < snapshots[RECORDING_ADD_CAR_TICK].size());
+		RS_CHECK(numKeyframes >= RECORDING_TICKS / RECORDING_KEYFRAME_INTERVAL);
+		RS_CHECK(numKeyframes < RECORDING_TICKS / 2);
+
+		// Forwards (continuing from the last record), backwards (starting over from keyframes), and in random order
+		std::vector<size_t> readOrder;
+		for (size_t i = 0; i < reader.GetNumRecords(); i++)
+			readOrder.push_back(i);
+		for (size_t i = reader.GetNumRecords(); i > 0; i--)
+			readOrder.push_back(i - 1);
+		std::vector<size_t> shuffled(readOrder.begin(), readOrder.begin() + reader.GetNumRecords());
+		std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(5));
+		readOrder.insert(readOrder.end(), shuffled.begin(), shuffled.end());
+
+		for (size_t recordIndex : readOrder) {
+			ArenaSnapshotView view = reader.Read(recordIndex);
+			const std::vector<byte>& snapshot = snapshots[recordIndex];
+			RS_CHECK_EQ((size_t)view.header->totalSize, snapshot.size());
+			RS_CHECK(view.header->totalSize == snapshot.size() && memcmp(view.header, snapshot.data(), snapshot.size()) == 0);
+			RS_CHECK_EQ(reader.GetTickCount(recordIndex), view.header->tickCount);
+			RS_CHECK_EQ(reader.FindRecord(view.header->tickCount), (int64_t)recordIndex);
+
+			if (Test::numFailedChecks > 0) {
+				std::cout << "  (record " << recordIndex << ")" << std::endl;
+				break;
+			}
+		}
+
+		RS_CHECK_EQ(reader.FindRecord(0), -1);
+	}
+
+	std::filesystem::remove(path);
+}
+
+// Returns true if reading a recording with the given contents fails
+static bool IsRecordingRejected(const std::filesystem::path& path, const std::vector<byte>& fileData) {
+	{
+		std::ofstream stream(path, std::ios::binary);
+		stream.write((const char*)fileData.data(), fileData.size());
+	}
+
+	try {
+		StateRecordingReader reader(path);
+		for (size_t i = 0; i < reader.GetNumRecords(); i++)
+			reader.Read(i);
+	} catch (std::exception&) {
+		return true;
+	}
+	return false;
+}
+
+// Recordings with an invalid record type, or that don't start with a keyframe, are rejected
+// Truncated recordings (from a recorder that wasn't flushed) are read up to the last complete record
+RS_TEST(StateRecorderValidation) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "rs_unit_test_validation.srec";
+	RecordStates(path);
+
+	std::vector<byte> fileData(std::filesystem::file_size(path));
+	{
+		std::ifstream stream(path, std::ios::binary);
+		stream.read((char*)fileData.data(), fileData.size());
+	}
+
+	size_t firstRecordOffset = sizeof(StateRecording::FileHeader);
+	StateRecording::RecordHeader firstRecord;
+	memcpy(&firstRecord, fileData.data() + firstRecordOffset, sizeof(firstRecord));
+	RS_CHECK(firstRecord.type == StateRecording::RecordType::KEYFRAME);
+	size_t secondRecordOffset = firstRecordOffset + sizeof(firstRecord) + firstRecord.payloadSize;
+
+	RS_CHECK(!IsRecordingRejected(path, fileData));
+
+	for (size_t recordOffset : { firstRecordOffset, secondRecordOffset }) {
+		std::vector<byte> data = fileData;
+		uint8_t badType = 2;
+		memcpy(data.data() + recordOffset + offsetof(StateRecording::RecordHeader, type), &badType, sizeof(badType));
+		RS_CHECK(IsRecordingRejected(path, data));
+	}
+
+	{ // Starting with a delta
+		std::vector<byte> data = fileData;
+		StateRecording::RecordType deltaType = StateRecording::RecordType::DELTA;
+		memcpy(data.data() + firstRecordOffset + offsetof(StateRecording::RecordHeader, type), &deltaType, sizeof(deltaType));
+		RS_CHECK(IsRecordingRejected(path, data));
+	}
+
+	{ // Truncated in the middle of the second record
+		std::vector<byte> data(fileData.begin(), fileData.begin() + secondRecordOffset + sizeof(StateRecording::RecordHeader) + 1);
+		RS_CHECK(!IsRecordingRejected(path, data));
+		StateRecordingReader reader(path);
+		RS_CHECK_EQ(reader.GetNumRecords(), (size_t)1);
+	}
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,74 @@
+#include "Test.h"
+
+using namespace RocketSim;
+
+// Flat grid of triangles with gentle bumps, in the collision mesh file layout
+// The tests don't depend on the real arena meshes, so they run without the game's collision meshes
+static FileData MakeTestMesh(int gridSize, float extent, float bumpHeight, float baseZ = 0) {
+	std::vector<float> vertices;
+	for (int i = 0; i <= gridSize; i++) {
+		for (int j = 0; j <= gridSize; j++) {
+			float x = -extent + 2 * extent * i / gridSize;
+			float y = -extent * 1.25f + 2.5f * extent * j / gridSize;
+			float z = baseZ + bumpHeight * (sinf(i * 0.7f) * cosf(j * 0.5f) + 1);
+			for (float coord : { x, y, z })
+				vertices.push_back(coord * UU_TO_BT);
+		}
+	}
+
+	std::vector<int32_t> tris;
+	for (int i = 0; i < gridSize; i++) {
+		for (int j = 0; j < gridSize; j++) {
+			int32_t a = i * (gridSize + 1) + j, b = a + 1, c = a + (gridSize + 1), d = c + 1;
+			for (int32_t idx : { a, c, b, b, c, d })
+				tris.push_back(idx);
+		}
+	}
+
+	int32_t numTris = tris.size() / 3, numVertices = vertices.size() / 3;
+
+	FileData result;
+	auto fnWrite = [&](const void* data, size_t size) {
+		result.insert(result.end(), (const byte*)data, (const byte*)data + size);
+	};
+	fnWrite(&numTris, sizeof(numTris));
+	fnWrite(&numVertices, sizeof(numVertices));
+	fnWrite(tris.data(), tris.size() * sizeof(int32_t));
+	fnWrite(vertices.data(), vertices.size() * sizeof(float));
+	return result;
+}
+
+int main(int argc, char** argv) {
+	using std::cout, std::endl;
+
+	std::string onlyTest = (argc > 1) ? argv[1] : "";
+
+	InitFromMem(
+		{
+			{ GameMode::SOCCAR, { MakeTestMesh(40, 4000, 30) } },
+			{ GameMode::DROPSHOT, { MakeTestMesh(10, 4000, 5, -300) } } // Below the tiles, so balls and cars land on them
+		},
+		true
+	);
+
+	int numFailedTests = 0, numRunTests = 0;
+	for (auto& pair : Test::GetAll()) {
+		if (!onlyTest.empty() && pair.first != onlyTest)
+			continue;
+
+		cout << pair.first << ":" << endl;
+		Test::numFailedChecks = 0;
+		try {
+			pair.second();
+		} catch (std::exception& e) {
+			Test::Fail(__FILE__, __LINE__, std::string("Exception: ") + e.what());
+		}
+
+		cout << "  " << (Test::numFailedChecks ? "FAILED" : "passed") << endl;
+		numFailedTests += (Test::numFailedChecks > 0);
+		numRunTests++;
+	}
+
+	cout << (numRunTests - numFailedTests) << "/" << numRunTests << " tests passed" << endl;
+	return (numFailedTests > 0 || numRunTests == 0) ? 1 : 0;
+}